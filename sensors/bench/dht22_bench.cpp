@@ -0,0 +1,265 @@
+/**
+ * @file dht22_bench.cpp
+ * @brief Reprodução no host de quadros do DHT22 e latência da decodificação.
+ *
+ * Não faz parte do firmware (o PlatformIO só compila src/). No diretório
+ * sensors:
+ *
+ *   g++ -O2 -std=gnu++11 -I include bench/dht22_bench.cpp src/Dht22Decoder.cpp -o dht22_bench
+ *   ./dht22_bench [captura.txt]
+ *
+ * Sem argumentos, reproduz os traços embutidos (quadros válidos, com
+ * ruído de temporização e com falhas) e confere o estado e os valores
+ * decodificados; depois mede a latência de uma decodificação (média,
+ * p99,9 e pior caso). No ESP32 a mesma medida, somada à conversão dos
+ * itens RMT, sai em Result::decodeTimeUs.
+ *
+ * Com um arquivo, cada linha é um traço capturado: durações em μs, com
+ * sinal negativo para nível baixo e positivo para alto, na ordem dos
+ * itens RMT (ex.: "-80 80 -50 27 -50 70 ..."). Linhas vazias ou
+ * iniciadas por '#' são ignoradas.
+ */
+
+#include "Dht22Decoder.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock Clock;
+typedef Dht22Decoder::Pulse Pulse;
+typedef Dht22Decoder::Status Status;
+
+// Quadro completo: resposta + 40 bits (baixo/alto) + margem, como no RMT
+static const size_t MAX_PULSES = 96;
+
+// Decodificações medidas uma a uma
+static const uint32_t TIMED_RUNS = 200000;
+
+/**
+ * Traço de teste: bytes do quadro e perturbações da captura.
+ */
+struct Trace {
+    const char *name;
+    uint8_t bytes[5];           // Umidade (2), temperatura (2), checksum
+    uint8_t jitterUs;           // Ruído máximo em cada pulso (±μs)
+    bool leadingPulses;         // Fim do pulso de início e subida antes da resposta
+    size_t truncateTo;          // Corta o traço neste número de pulsos (0 = completo)
+    Status expected;
+    float temperature;
+    float humidity;
+};
+
+static const Trace s_traces[] = {
+    { "nominal",       { 0x02, 0x28, 0x00, 0xEA, 0x14 }, 0,  false, 0,  Status::OK,             23.4f,  55.2f },
+    { "negativa",      { 0x03, 0xE8, 0x80, 0x35, 0xA0 }, 0,  false, 0,  Status::OK,             -5.3f, 100.0f },
+    { "ruido",         { 0x01, 0x90, 0x01, 0x2C, 0xBE }, 9,  true,  0,  Status::OK,             30.0f,  40.0f },
+    { "checksum",      { 0x02, 0x28, 0x00, 0xEA, 0x15 }, 0,  false, 0,  Status::CHECKSUM_ERROR, 0.0f,   0.0f  },
+    { "truncado",      { 0x02, 0x28, 0x00, 0xEA, 0x14 }, 0,  true,  60, Status::FRAME_ERROR,    0.0f,   0.0f  },
+    { "sem_resposta",  { 0x02, 0x28, 0x00, 0xEA, 0x14 }, 0,  false, 1,  Status::NO_RESPONSE,    0.0f,   0.0f  },
+};
+
+/**
+ * Gerador pseudoaleatório reprodutível (xorshift32).
+ */
+static uint32_t nextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static uint16_t jittered(uint16_t durationUs, uint8_t jitterUs, uint32_t &state) {
+    if (jitterUs == 0) {
+        return durationUs;
+    }
+    int offset = static_cast<int>(nextRandom(state) % (2u * jitterUs + 1)) - jitterUs;
+    return static_cast<uint16_t>(durationUs + offset);
+}
+
+/**
+ * Monta os pulsos de um quadro com os tempos da folha de dados.
+ */
+static size_t buildPulses(const Trace &trace, Pulse *pulses, uint32_t &state) {
+    size_t count = 0;
+
+    if (trace.leadingPulses) {
+        pulses[count++] = { 0, jittered(40, trace.jitterUs, state) };
+        pulses[count++] = { 1, jittered(30, trace.jitterUs, state) };
+    }
+
+    pulses[count++] = { 0, jittered(80, trace.jitterUs, state) };
+    pulses[count++] = { 1, jittered(80, trace.jitterUs, state) };
+
+    for (uint8_t bit = 0; bit < 40; bit++) {
+        bool one = (trace.bytes[bit / 8] >> (7 - bit % 8)) & 1;
+        pulses[count++] = { 0, jittered(50, trace.jitterUs, state) };
+        pulses[count++] = { 1, jittered(one ? 70 : 27, trace.jitterUs, state) };
+    }
+
+    // Sensor devolve a linha: último nível baixo antes do ocioso
+    pulses[count++] = { 0, jittered(50, trace.jitterUs, state) };
+
+    if (trace.truncateTo > 0 && trace.truncateTo < count) {
+        count = trace.truncateTo;
+    }
+    return count;
+}
+
+/**
+ * Lê um traço no formato "-80 80 -50 27 ...".
+ */
+static size_t parsePulses(char *line, Pulse *pulses) {
+    size_t count = 0;
+    char *cursor = line;
+    while (count < MAX_PULSES) {
+        char *end = nullptr;
+        long value = strtol(cursor, &end, 10);
+        if (end == cursor) {
+            break;
+        }
+        cursor = end;
+        if (value == 0) {
+            continue;
+        }
+        pulses[count].level = value > 0 ? 1 : 0;
+        pulses[count].durationUs = static_cast<uint16_t>(value > 0 ? value : -value);
+        count++;
+    }
+    return count;
+}
+
+static double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * Decodifica um traço TIMED_RUNS vezes e imprime a latência.
+ */
+static void measure(const char *name, const Pulse *pulses, size_t count, Status status) {
+    static uint32_t histogram[1000];
+    memset(histogram, 0, sizeof(histogram));
+
+    volatile float sink = 0.0f;
+    double totalNs = 0.0;
+    double worstNs = 0.0;
+
+    for (uint32_t run = 0; run < TIMED_RUNS; run++) {
+        float temperature = 0.0f;
+        float humidity = 0.0f;
+        Clock::time_point start = Clock::now();
+        Dht22Decoder::decode(pulses, count, temperature, humidity);
+        double ns = elapsedNs(start, Clock::now());
+        sink = sink + temperature + humidity;
+
+        totalNs += ns;
+        if (ns > worstNs) {
+            worstNs = ns;
+        }
+        uint32_t bucket = static_cast<uint32_t>(ns / 10.0);
+        histogram[bucket < 999 ? bucket : 999]++;
+    }
+
+    uint32_t p999Bucket = 0;
+    for (uint32_t seen = 0; p999Bucket < 1000; p999Bucket++) {
+        seen += histogram[p999Bucket];
+        if (seen >= TIMED_RUNS - TIMED_RUNS / 1000) {
+            break;
+        }
+    }
+
+    printf("%-14s %6u %-18s %8.0fns %8uns %8.0fns\n",
+        name, static_cast<unsigned>(count), Dht22Decoder::statusToString(status),
+        totalNs / TIMED_RUNS, (p999Bucket + 1) * 10, worstNs);
+}
+
+static int replayFile(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Não foi possível abrir %s\n", path);
+        return 1;
+    }
+
+    printf("%-6s %6s %-18s %8s %8s\n", "linha", "pulsos", "estado", "temp", "umid");
+
+    char line[1024];
+    unsigned lineNumber = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') {
+            continue;
+        }
+
+        Pulse pulses[MAX_PULSES];
+        size_t count = parsePulses(line, pulses);
+        float temperature = NAN;
+        float humidity = NAN;
+        Status status = Dht22Decoder::decode(pulses, count, temperature, humidity);
+
+        printf("%-6u %6u %-18s %8.1f %8.1f\n", lineNumber, static_cast<unsigned>(count),
+            Dht22Decoder::statusToString(status), temperature, humidity);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        return replayFile(argv[1]);
+    }
+
+    // Reprodução: estado e valores de cada traço
+    int failures = 0;
+    uint32_t state = 0x2545F491u;
+    for (size_t t = 0; t < sizeof(s_traces) / sizeof(s_traces[0]); t++) {
+        const Trace &trace = s_traces[t];
+        Pulse pulses[MAX_PULSES];
+        size_t count = buildPulses(trace, pulses, state);
+
+        float temperature = NAN;
+        float humidity = NAN;
+        Status status = Dht22Decoder::decode(pulses, count, temperature, humidity);
+
+        bool ok = status == trace.expected;
+        if (ok && status == Status::OK) {
+            ok = fabsf(temperature - trace.temperature) < 0.05f &&
+                 fabsf(humidity - trace.humidity) < 0.05f;
+        }
+        if (!ok) {
+            fprintf(stderr, "%s: esperado %s (%.1f °C, %.1f %%), obtido %s (%.1f °C, %.1f %%)\n",
+                trace.name, Dht22Decoder::statusToString(trace.expected),
+                trace.temperature, trace.humidity,
+                Dht22Decoder::statusToString(status), temperature, humidity);
+            failures++;
+        }
+    }
+
+    // Ruído perto da margem (bit 1: 70 - 9 > 50 + 9): 1000 quadros devem decodificar
+    for (uint32_t run = 0; run < 1000; run++) {
+        Pulse pulses[MAX_PULSES];
+        size_t count = buildPulses(s_traces[2], pulses, state);
+        float temperature = NAN;
+        float humidity = NAN;
+        if (Dht22Decoder::decode(pulses, count, temperature, humidity) != Status::OK) {
+            fprintf(stderr, "ruido: quadro %u não decodificou\n", run);
+            failures++;
+            break;
+        }
+    }
+
+    printf("reprodução: %s\n\n", failures == 0 ? "ok" : "FALHOU");
+
+    printf("%-14s %6s %-18s %10s %10s %10s\n",
+        "traço", "pulsos", "estado", "média", "p99,9", "pior");
+
+    for (size_t t = 0; t < sizeof(s_traces) / sizeof(s_traces[0]); t++) {
+        const Trace &trace = s_traces[t];
+        Pulse pulses[MAX_PULSES];
+        size_t count = buildPulses(trace, pulses, state);
+        measure(trace.name, pulses, count, trace.expected);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
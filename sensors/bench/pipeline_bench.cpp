@@ -0,0 +1,205 @@
+/**
+ * @file pipeline_bench.cpp
+ * @brief Benchmark no host das cadeias de temperatura e umidade do DHT22.
+ *
+ * Não faz parte do firmware (o PlatformIO só compila src/). No diretório
+ * sensors:
+ *
+ *   g++ -O2 -std=gnu++11 -I include bench/pipeline_bench.cpp -o pipeline_bench
+ *   ./pipeline_bench
+ *
+ * Monta as mesmas cadeias de SensorManager::TemperaturePipeline e
+ * HumidityPipeline (SensorManager.h depende do Arduino, então a
+ * composição e as constantes são repetidas aqui e devem acompanhar as de
+ * lá) e mede o custo por amostra da cadeia inteira e de cada estágio
+ * isolado, em ns e em ciclos do contador de tempo da CPU (x86). O sinal
+ * tem a resolução de 0,1 do DHT22, ruído e 1% de picos, para que o filtro
+ * de Hampel percorra os dois caminhos.
+ */
+
+#include "SensorPipeline.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+// Amostras por medida e tamanho do sinal sintético (percorrido em ciclo)
+static const uint32_t BENCH_SAMPLES = 4000000;
+static const uint32_t SIGNAL_SIZE = 4096;
+
+// Intervalo entre aquisições do DHT22 (ms), como DHT22_READ_INTERVAL
+static const uint32_t SAMPLE_PERIOD_MS = 2000;
+
+// Constantes de SensorManager.h
+static const uint8_t FILTER_SIZE = 5;
+static const int32_t FILTER_SCALE = 100;
+static const uint8_t OUTLIER_WINDOW = 7;
+static const uint8_t OUTLIER_SIGMA = 3;
+static const int32_t OUTLIER_FLOOR_TEMPERATURE = 50;
+static const int32_t OUTLIER_FLOOR_HUMIDITY = 200;
+
+struct TemperatureTrendModel {
+    static constexpr float MEASUREMENT_NOISE = 0.01f;
+    static constexpr float RATE_NOISE = 0.25f;
+    static constexpr float INITIAL_RATE_VARIANCE = 1.0f;
+};
+
+struct HumidityTrendModel {
+    static constexpr float MEASUREMENT_NOISE = 0.25f;
+    static constexpr float RATE_NOISE = 1.0f;
+    static constexpr float INITIAL_RATE_VARIANCE = 4.0f;
+};
+
+struct TemperatureCalibration {
+    static constexpr float GAIN = 1.0f;
+    static constexpr float OFFSET = 0.0f;
+};
+
+typedef Hampel<OUTLIER_WINDOW, OUTLIER_SIGMA, OUTLIER_FLOOR_TEMPERATURE, FILTER_SCALE> TemperatureOutliers;
+typedef Hampel<OUTLIER_WINDOW, OUTLIER_SIGMA, OUTLIER_FLOOR_HUMIDITY, FILTER_SCALE> HumidityOutliers;
+
+typedef Pipeline<RangeGate<-40, 80>,
+                 TemperatureOutliers,
+                 Calibrate<TemperatureCalibration>,
+                 Clamp<-40, 80>,
+                 KalmanTrend<TemperatureTrendModel>,
+                 MovingAverage<FILTER_SIZE, FILTER_SCALE>> TemperaturePipeline;
+typedef Pipeline<RangeGate<0, 100>,
+                 HumidityOutliers,
+                 KalmanTrend<HumidityTrendModel>,
+                 MovingAverage<FILTER_SIZE, FILTER_SCALE>> HumidityPipeline;
+
+static const size_t TEMPERATURE_TREND_STAGE = 4;
+static const size_t HUMIDITY_TREND_STAGE = 2;
+
+/**
+ * Define o instante da amostra nas cadeias com estimador de tendência.
+ */
+template <typename P, size_t TrendStage>
+struct TrendClock {
+    static void set(P &pipeline, uint32_t nowMs) {
+        pipeline.template stage<TrendStage>().setTime(nowMs);
+    }
+};
+
+template <typename P>
+struct NoClock {
+    static void set(P &, uint32_t) {}
+};
+
+/**
+ * Gerador pseudoaleatório reprodutível (xorshift32).
+ */
+static uint32_t nextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * Sinal com a resolução de 0,1 do DHT22, ruído e picos ocasionais.
+ */
+static void buildSignal(float *signal, float center, float swing, float spike, uint32_t seed) {
+    uint32_t state = seed;
+    for (uint32_t i = 0; i < SIGNAL_SIZE; i++) {
+        float noise = static_cast<float>(nextRandom(state) % 5) * 0.1f - 0.2f;
+        float value = center + swing * sinf(i * 0.003f) + noise;
+        if (nextRandom(state) % 100 == 0) {
+            value += spike;
+        }
+        signal[i] = roundf(value * 10.0f) / 10.0f;
+    }
+}
+
+/**
+ * Torna o estado da cadeia observável, para que o compilador não elimine
+ * estágios que não alteram a amostra (ex.: KalmanTrend).
+ */
+static inline void escape(void *pointer) {
+    __asm__ __volatile__("" : : "g"(pointer) : "memory");
+}
+
+static inline uint64_t readTsc() {
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Mede o custo por amostra de uma cadeia e imprime uma linha.
+ */
+template <typename P, typename Timer>
+static void measure(const char *name, const float *signal) {
+    P pipeline;
+    pipeline.reset();
+
+    volatile float sink = 0.0f;
+    float sum = 0.0f;
+    uint32_t accepted = 0;
+    uint32_t now = 0;
+
+    Clock::time_point start = Clock::now();
+    uint64_t tscStart = readTsc();
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        float value = signal[k & (SIGNAL_SIZE - 1)];
+        now += SAMPLE_PERIOD_MS;
+        Timer::set(pipeline, now);
+        if (pipeline.process(value)) {
+            sum += value;
+            accepted++;
+        }
+    }
+    escape(&pipeline);
+    uint64_t tscEnd = readTsc();
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    sink = sink + sum;
+
+    printf("%-26s %10.2fns", name, ns / BENCH_SAMPLES);
+    if (BENCH_HAS_TSC) {
+        printf(" %12.1f", static_cast<double>(tscEnd - tscStart) / BENCH_SAMPLES);
+    } else {
+        printf(" %12s", "-");
+    }
+    printf(" %10.2f%%\n", 100.0 * (BENCH_SAMPLES - accepted) / BENCH_SAMPLES);
+}
+
+int main() {
+    static float temperature[SIGNAL_SIZE];
+    static float humidity[SIGNAL_SIZE];
+    buildSignal(temperature, 22.0f, 6.0f, 8.0f, 0x1234567u);
+    buildSignal(humidity, 60.0f, 20.0f, 15.0f, 0x89ABCDEu);
+
+    printf("%-26s %12s %12s %11s\n", "cadeia", "por amostra", "ciclos TSC", "descartes");
+
+    measure<TemperaturePipeline, TrendClock<TemperaturePipeline, TEMPERATURE_TREND_STAGE> >(
+        "temperatura (completa)", temperature);
+    measure<HumidityPipeline, TrendClock<HumidityPipeline, HUMIDITY_TREND_STAGE> >(
+        "umidade (completa)", humidity);
+
+    printf("\n");
+
+    typedef Pipeline<RangeGate<-40, 80> > GateOnly;
+    typedef Pipeline<TemperatureOutliers> HampelOnly;
+    typedef Pipeline<Calibrate<TemperatureCalibration>, Clamp<-40, 80> > CalibrationOnly;
+    typedef Pipeline<KalmanTrend<TemperatureTrendModel> > TrendOnly;
+    typedef Pipeline<MovingAverage<FILTER_SIZE, FILTER_SCALE> > AverageOnly;
+
+    measure<GateOnly, NoClock<GateOnly> >("  RangeGate", temperature);
+    measure<HampelOnly, NoClock<HampelOnly> >("  Hampel<7>", temperature);
+    measure<CalibrationOnly, NoClock<CalibrationOnly> >("  Calibrate + Clamp", temperature);
+    measure<TrendOnly, TrendClock<TrendOnly, 0> >("  KalmanTrend", temperature);
+    measure<AverageOnly, NoClock<AverageOnly> >("  MovingAverage<5>", temperature);
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file ring_filter_bench.cpp
+ * @brief Testes de propriedade e benchmark no host de RingFilter e FixedRingFilter.
+ *
+ * Não faz parte do firmware (o PlatformIO só compila src/). No diretório
+ * sensors:
+ *
+ *   g++ -O2 -std=gnu++11 -I include bench/ring_filter_bench.cpp -o ring_filter_bench
+ *   ./ring_filter_bench
+ *
+ * Primeiro compara, amostra a amostra, a média de cada filtro com a média
+ * recalculada do zero sobre as últimas min(k, N) amostras, para várias
+ * janelas e tipos, incluindo o aquecimento, reset() e uma sequência longa
+ * em ponto flutuante (erro acumulado). Depois mede o custo por amostra
+ * dos filtros e da média refeita a cada amostra. Termina com código 1 se
+ * alguma propriedade falhar.
+ */
+
+#include "RingFilter.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock Clock;
+
+// Amostras por caso de teste e por medida
+static const uint32_t TEST_SAMPLES = 20000;
+static const uint32_t BENCH_SAMPLES = 4000000;
+
+static int s_failures = 0;
+
+/**
+ * Gerador pseudoaleatório reprodutível (xorshift32).
+ */
+static uint32_t nextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * @return Valor uniforme em [low, high).
+ */
+static double uniform(uint32_t &state, double low, double high) {
+    return low + (high - low) * (nextRandom(state) / 4294967296.0);
+}
+
+static void fail(const char *name, uint32_t sample, double expected, double actual) {
+    if (s_failures < 10) {
+        fprintf(stderr, "%s: amostra %u, esperado %.9g, obtido %.9g\n",
+            name, sample, expected, actual);
+    }
+    s_failures++;
+}
+
+/**
+ * RingFilter<T, N> contra a média refeita com o mesmo tipo de soma: inteiros
+ * devem coincidir exatamente, ponto flutuante dentro de tolerance relativa
+ * à maior amostra.
+ */
+template <typename T, uint8_t N>
+static void checkRing(const char *name, double low, double high, double tolerance) {
+    typedef typename RingFilter<T, N>::Sum Sum;
+    RingFilter<T, N> filter = {};
+    static T history[TEST_SAMPLES];
+    uint32_t state = 0x9E3779B9u ^ N;
+
+    for (uint32_t k = 0; k < TEST_SAMPLES; k++) {
+        // reset() no meio da sequência volta ao aquecimento
+        uint32_t start = k >= TEST_SAMPLES / 2 ? TEST_SAMPLES / 2 : 0;
+        if (k == TEST_SAMPLES / 2) {
+            filter.reset();
+        }
+
+        history[k] = static_cast<T>(uniform(state, low, high));
+        T average = filter.update(history[k]);
+
+        uint32_t window = k + 1 - start < N ? k + 1 - start : N;
+        Sum sum = 0;
+        for (uint32_t i = k + 1 - window; i <= k; i++) {
+            sum += history[i];
+        }
+        T expected = static_cast<T>(sum / static_cast<Sum>(window));
+
+        double error = fabs(static_cast<double>(average) - static_cast<double>(expected));
+        double limit = tolerance * (fabs(low) > fabs(high) ? fabs(low) : fabs(high));
+        if (error > limit || filter.count() != window || filter.ready() != (window == N)) {
+            fail(name, k, static_cast<double>(expected), static_cast<double>(average));
+        }
+    }
+}
+
+/**
+ * FixedRingFilter<N, Scale> contra a média das amostras arredondadas para
+ * 1/Scale, e a no máximo meia unidade de 1/Scale da média exata.
+ */
+template <uint8_t N, int32_t Scale>
+static void checkFixed(const char *name, double low, double high) {
+    FixedRingFilter<N, Scale> filter = {};
+    static float history[TEST_SAMPLES];
+    uint32_t state = 0x85EBCA6Bu ^ N;
+
+    for (uint32_t k = 0; k < TEST_SAMPLES; k++) {
+        uint32_t start = k >= TEST_SAMPLES / 2 ? TEST_SAMPLES / 2 : 0;
+        if (k == TEST_SAMPLES / 2) {
+            filter.reset();
+        }
+
+        history[k] = static_cast<float>(uniform(state, low, high));
+        float average = filter.update(history[k]);
+
+        uint32_t window = k + 1 - start < N ? k + 1 - start : N;
+        double rounded = 0.0;
+        double exact = 0.0;
+        for (uint32_t i = k + 1 - window; i <= k; i++) {
+            rounded += static_cast<double>(lroundf(history[i] * Scale)) / Scale;
+            exact += history[i];
+        }
+        rounded /= window;
+        exact /= window;
+
+        double magnitude = fabs(low) > fabs(high) ? fabs(low) : fabs(high);
+        if (fabs(average - rounded) > 1e-6 * magnitude + 1e-6 ||
+            fabs(average - exact) > 0.5 / Scale + 1e-6 * magnitude ||
+            filter.count() != window) {
+            fail(name, k, rounded, average);
+        }
+    }
+}
+
+/**
+ * Sequência longa com deslocamento grande: sem a soma refeita a cada
+ * volta, o erro de arredondamento de float cresceria com o número de
+ * amostras.
+ */
+static void checkDrift() {
+    RingFilter<float, 60> filter = {};
+    static float window[60];
+    uint32_t state = 12345;
+    double worst = 0.0;
+
+    for (uint32_t k = 0; k < 10000000; k++) {
+        float value = static_cast<float>(1000.0 + uniform(state, -0.5, 0.5));
+        window[k % 60] = value;
+        float average = filter.update(value);
+
+        if (k % 100000 == 99999) {
+            double sum = 0.0;
+            for (uint32_t i = 0; i < 60; i++) {
+                sum += window[i];
+            }
+            double error = fabs(average - sum / 60.0);
+            if (error > worst) {
+                worst = error;
+            }
+        }
+    }
+
+    printf("deriva float, 10^7 amostras em torno de 1000: erro máximo %.2g\n", worst);
+    if (worst > 1e-3) {
+        fail("deriva", 0, 0.0, worst);
+    }
+}
+
+static double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * Custo por amostra: RingFilter<float>, FixedRingFilter e a média refeita
+ * sobre a janela a cada amostra.
+ */
+template <uint8_t N>
+static void benchWindow(const float *samples, uint32_t sampleMask) {
+    volatile float sink = 0.0f;
+
+    RingFilter<float, N> ring = {};
+    Clock::time_point start = Clock::now();
+    float sum = 0.0f;
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        sum += ring.update(samples[k & sampleMask]);
+    }
+    double ringNs = elapsedNs(start, Clock::now()) / BENCH_SAMPLES;
+    sink = sink + sum;
+
+    FixedRingFilter<N, 100> fixed = {};
+    start = Clock::now();
+    sum = 0.0f;
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        sum += fixed.update(samples[k & sampleMask]);
+    }
+    double fixedNs = elapsedNs(start, Clock::now()) / BENCH_SAMPLES;
+    sink = sink + sum;
+
+    float window[N] = {};
+    start = Clock::now();
+    sum = 0.0f;
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        window[k % N] = samples[k & sampleMask];
+        float total = 0.0f;
+        for (uint8_t i = 0; i < N; i++) {
+            total += window[i];
+        }
+        sum += total / N;
+    }
+    double bruteNs = elapsedNs(start, Clock::now()) / BENCH_SAMPLES;
+    sink = sink + sum;
+
+    printf("%6u %12.2fns %12.2fns %12.2fns\n",
+        static_cast<unsigned>(N), ringNs, fixedNs, bruteNs);
+}
+
+int main() {
+    checkRing<float, 1>("float/1", -40.0, 80.0, 1e-6);
+    checkRing<float, 5>("float/5", -40.0, 80.0, 1e-6);
+    checkRing<float, 60>("float/60", -40.0, 80.0, 1e-6);
+    checkRing<float, 255>("float/255", -40.0, 80.0, 1e-6);
+    checkRing<int16_t, 7>("int16/7", -32768.0, 32767.0, 0.0);
+    checkRing<int16_t, 255>("int16/255", -32768.0, 32767.0, 0.0);
+    checkRing<uint8_t, 255>("uint8/255", 0.0, 255.0, 0.0);
+    checkRing<int32_t, 255>("int32/255", -2147483648.0, 2147483647.0, 0.0);
+    checkRing<uint32_t, 16>("uint32/16", 0.0, 4294967295.0, 0.0);
+    checkFixed<1, 100>("fixo/1", -40.0, 80.0);
+    checkFixed<5, 100>("fixo/5", -40.0, 80.0);
+    checkFixed<60, 100>("fixo/60", 0.0, 100.0);
+    checkFixed<255, 1000>("fixo/255", -40.0, 80.0);
+    checkDrift();
+
+    printf("propriedades: %s\n\n", s_failures == 0 ? "ok" : "FALHOU");
+
+    // Sinal plausível de temperatura, percorrido em ciclo
+    static float samples[4096];
+    uint32_t state = 777;
+    for (uint32_t i = 0; i < 4096; i++) {
+        samples[i] = static_cast<float>(22.0 + 3.0 * sin(i * 0.01) + uniform(state, -0.2, 0.2));
+    }
+
+    printf("%6s %14s %14s %14s\n", "janela", "RingFilter", "FixedRing", "refeita");
+    benchWindow<5>(samples, 4095);
+    benchWindow<16>(samples, 4095);
+    benchWindow<60>(samples, 4095);
+    benchWindow<255>(samples, 4095);
+
+    return s_failures == 0 ? 0 : 1;
+}
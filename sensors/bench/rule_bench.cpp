@@ -0,0 +1,155 @@
+/**
+ * @file rule_bench.cpp
+ * @brief Benchmark no host do compilador e do interpretador de regras.
+ *
+ * Não faz parte do firmware (o PlatformIO só compila src/). No diretório
+ * sensors:
+ *
+ *   g++ -O2 -std=gnu++11 -I include bench/rule_bench.cpp src/RuleScript.cpp -o rule_bench
+ *   ./rule_bench
+ *
+ * Para cada conjunto de regras, mede a compilação, as avaliações por
+ * segundo do conjunto inteiro e a latência de uma avaliação (p99,9 e
+ * pior caso). O pior caso no host inclui preempções do sistema
+ * operacional; o limite determinístico é a coluna de bytes, já que o
+ * interpretador executa no máximo uma instrução por byte de código. No
+ * ESP32 a mesma medida sai em soil_alert_evaluation_seconds.
+ */
+
+#include "RuleScript.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+typedef std::chrono::steady_clock Clock;
+
+// Avaliações por conjunto: lote medido de uma vez e lote medido uma a uma
+static const uint32_t BATCH_RUNS = 2000000;
+static const uint32_t TIMED_RUNS = 200000;
+
+// Amostras sintéticas, percorridas em ciclo para variar os desvios
+static const uint32_t SAMPLE_COUNT = 256;
+
+struct BenchSet {
+    const char *name;
+    const char *rules[RuleSet::MAX_RULES];
+};
+
+static const BenchSet s_sets[] = {
+    { "simples", {
+        "umidade > 95",
+    } },
+    { "comum", {
+        "ativo ? umidade > 92 : umidade > 95",
+        "taxa_temperatura < -0.05 && temperatura < 4",
+        "abs(taxa_umidade) > 3 * sigma_umidade && taxa_umidade > 0.1",
+        "ativo ? temperatura > 43 : temperatura > 45",
+    } },
+    // Quatro regras perto de MAX_CODE e das 8 constantes, sem saltos: toda
+    // instrução executa
+    { "limite", {
+        "(temperatura-1)*(umidade-2)+(taxa_umidade-3)*(ativo-4)-(5-6)*(7-8)/(1-2)*(3+4)-5*6/7+8+1",
+        "(umidade-1)*(temperatura-2)+(taxa_temperatura-3)*(ativo-4)-(5-6)*(7-8)/(1-2)*(3+4)-5*6/7+8+1",
+        "(temperatura+1)*(umidade+2)-(sigma_umidade+3)*(ativo+4)+(5+6)*(7+8)/(1+2)*(3-4)+5*6/7-8-1",
+        "(umidade+1)*(temperatura+2)-(sigma_temperatura+3)*(ativo+4)+(5+6)*(7+8)/(1+2)*(3-4)+5*6/7-8-1",
+    } },
+};
+
+/**
+ * Avalia todas as regras do conjunto, como AlertEngine::evaluate().
+ */
+static inline float evaluateSet(const RuleSet &set, const float *inputs) {
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < set.count; i++) {
+        float result = 0.0f;
+        if (RuleInterpreter::run(set.rules[i], inputs, result) == RuleInterpreter::Status::OK) {
+            sum += result;
+        }
+    }
+    return sum;
+}
+
+static double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+int main() {
+    // Entradas variando em torno de valores plausíveis
+    static float samples[SAMPLE_COUNT][static_cast<size_t>(RuleInput::COUNT)];
+    for (uint32_t i = 0; i < SAMPLE_COUNT; i++) {
+        float phase = static_cast<float>(i) / SAMPLE_COUNT * 6.2832f;
+        samples[i][static_cast<size_t>(RuleInput::TEMPERATURE)] = 20.0f + 25.0f * sinf(phase);
+        samples[i][static_cast<size_t>(RuleInput::HUMIDITY)] = 60.0f + 38.0f * cosf(phase);
+        samples[i][static_cast<size_t>(RuleInput::TEMPERATURE_RATE)] = 0.1f * sinf(3.0f * phase);
+        samples[i][static_cast<size_t>(RuleInput::HUMIDITY_RATE)] = 0.3f * cosf(5.0f * phase);
+        samples[i][static_cast<size_t>(RuleInput::TEMPERATURE_SIGMA)] = 0.02f;
+        samples[i][static_cast<size_t>(RuleInput::HUMIDITY_SIGMA)] = 0.05f;
+        samples[i][static_cast<size_t>(RuleInput::ACTIVE)] = static_cast<float>(i & 1);
+    }
+
+    printf("%-10s %6s %6s %10s %12s %10s %10s\n",
+        "conjunto", "regras", "bytes", "compila", "aval/s", "p99,9", "pior");
+
+    volatile float sink = 0.0f;
+
+    for (size_t s = 0; s < sizeof(s_sets) / sizeof(s_sets[0]); s++) {
+        const BenchSet &bench = s_sets[s];
+        RuleSet set;
+        memset(&set, 0, sizeof(set));
+
+        // Compilação, como no envio pelo WebSocket ou POST /rules
+        unsigned codeBytes = 0;
+        Clock::time_point compileStart = Clock::now();
+        for (uint8_t i = 0; i < RuleSet::MAX_RULES && bench.rules[i] != nullptr; i++) {
+            RuleCompileError error;
+            if (!RuleCompiler::compile(bench.rules[i], set.rules[i], error)) {
+                fprintf(stderr, "%s, regra %u: posição %u: %s\n",
+                    bench.name, i, error.position, error.message);
+                return 1;
+            }
+            codeBytes += set.rules[i].length;
+            set.count++;
+        }
+        double compileNs = elapsedNs(compileStart, Clock::now());
+
+        // Vazão: lote sem leitura do relógio entre avaliações
+        Clock::time_point batchStart = Clock::now();
+        float sum = 0.0f;
+        for (uint32_t run = 0; run < BATCH_RUNS; run++) {
+            sum += evaluateSet(set, samples[run % SAMPLE_COUNT]);
+        }
+        double batchNs = elapsedNs(batchStart, Clock::now());
+        sink = sink + sum;
+
+        // Latência: cada avaliação medida isoladamente, em histograma de 10 ns
+        static uint32_t histogram[1000];
+        memset(histogram, 0, sizeof(histogram));
+        double worstNs = 0.0;
+        for (uint32_t run = 0; run < TIMED_RUNS; run++) {
+            Clock::time_point start = Clock::now();
+            sink = sink + evaluateSet(set, samples[run % SAMPLE_COUNT]);
+            double ns = elapsedNs(start, Clock::now());
+
+            if (ns > worstNs) {
+                worstNs = ns;
+            }
+            uint32_t bucket = static_cast<uint32_t>(ns / 10.0);
+            histogram[bucket < 999 ? bucket : 999]++;
+        }
+
+        uint32_t p999Bucket = 0;
+        for (uint32_t seen = 0; p999Bucket < 1000; p999Bucket++) {
+            seen += histogram[p999Bucket];
+            if (seen >= TIMED_RUNS - TIMED_RUNS / 1000) {
+                break;
+            }
+        }
+
+        printf("%-10s %6u %6u %8.1fus %12.0f %8uns %8.0fns\n",
+            bench.name, set.count, codeBytes, compileNs / 1000.0,
+            BATCH_RUNS / (batchNs / 1e9), (p999Bucket + 1) * 10, worstNs);
+    }
+
+    return sink == 12345.0f ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file seqlock_bench.cpp
+ * @brief Benchmark no host da publicação do snapshot: mutex contra SeqLock.
+ *
+ * Não faz parte do firmware (o PlatformIO só compila src/). No diretório
+ * sensors:
+ *
+ *   g++ -O2 -std=gnu++11 -pthread -I include bench/seqlock_bench.cpp -o seqlock_bench
+ *   ./seqlock_bench
+ *
+ * Um escritor publica um snapshot do tamanho de SensorSnapshot enquanto
+ * leitores copiam o último valor sem parar, como a WebTask e os handlers
+ * HTTP fazem com a SensorTask. "mutex" é o esquema anterior (cópia sob
+ * g_sensorMutex, aqui std::mutex); "seqlock" é SeqLock<T>. Para cada
+ * combinação mede a latência de uma leitura e de uma escrita (p50, p99,9
+ * e pior caso), a vazão de leituras e as leituras inconsistentes, que
+ * devem ser zero. O pior caso inclui preempções do sistema operacional e
+ * depende do número de núcleos do host; no ESP32 as retentativas saem em
+ * SeqLock::getRetryCount().
+ */
+
+#include "SeqLock.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+// Duração de cada combinação
+static const std::chrono::milliseconds RUN_TIME(400);
+
+// Histograma de latência: baldes de 10 ns até 1 ms
+static const uint32_t BUCKETS = 100000;
+
+// Trabalho do escritor entre publicações (iterações), como o processamento de uma amostra
+static const uint32_t WRITER_WORK = 200;
+
+/**
+ * Snapshot sintético: todas as palavras recebem o mesmo valor, de modo
+ * que uma cópia rasgada é detectável.
+ */
+struct Snapshot {
+    uint32_t words[40];
+};
+
+/**
+ * Esquema anterior: cópia protegida por mutex.
+ */
+class MutexBox {
+public:
+    MutexBox() : m_value() {}
+
+    void write(const Snapshot &value) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_value = value;
+    }
+
+    uint32_t read(Snapshot &out) const {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        out = m_value;
+        return 0;
+    }
+
+    uint32_t getRetryCount() const { return 0; }
+
+private:
+    mutable std::mutex m_mutex;
+    Snapshot m_value;
+};
+
+/**
+ * Histograma de latências de uma thread.
+ */
+struct Histogram {
+    std::vector<uint32_t> buckets;
+    uint64_t count;
+    double worstNs;
+
+    Histogram() : buckets(BUCKETS, 0), count(0), worstNs(0.0) {}
+
+    void add(double ns) {
+        uint32_t bucket = static_cast<uint32_t>(ns / 10.0);
+        buckets[bucket < BUCKETS - 1 ? bucket : BUCKETS - 1]++;
+        count++;
+        if (ns > worstNs) {
+            worstNs = ns;
+        }
+    }
+
+    void merge(const Histogram &other) {
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        if (other.worstNs > worstNs) {
+            worstNs = other.worstNs;
+        }
+    }
+
+    /**
+     * @return Limite superior do balde que contém o percentil (ns).
+     */
+    uint32_t percentile(double fraction) const {
+        uint64_t target = static_cast<uint64_t>(count * fraction);
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= target) {
+                return (i + 1) * 10;
+            }
+        }
+        return BUCKETS * 10;
+    }
+};
+
+static double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+template <typename Box>
+static void runCase(const char *name, unsigned readers) {
+    Box box;
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> torn(0);
+
+    Histogram writeLatency;
+    std::vector<Histogram> readLatency(readers);
+
+    std::thread writer([&]() {
+        Snapshot value;
+        volatile uint32_t work = 0;
+        for (uint32_t seq = 1; !stop.load(std::memory_order_relaxed); seq++) {
+            for (uint32_t i = 0; i < 40; i++) {
+                value.words[i] = seq;
+            }
+
+            Clock::time_point start = Clock::now();
+            box.write(value);
+            writeLatency.add(elapsedNs(start, Clock::now()));
+
+            for (uint32_t i = 0; i < WRITER_WORK; i++) {
+                work = work + i;
+            }
+        }
+    });
+
+    std::vector<std::thread> readerThreads;
+    for (unsigned r = 0; r < readers; r++) {
+        readerThreads.push_back(std::thread([&, r]() {
+            Snapshot copy;
+            Histogram &histogram = readLatency[r];
+            while (!stop.load(std::memory_order_relaxed)) {
+                Clock::time_point start = Clock::now();
+                box.read(copy);
+                histogram.add(elapsedNs(start, Clock::now()));
+
+                for (uint32_t i = 1; i < 40; i++) {
+                    if (copy.words[i] != copy.words[0]) {
+                        torn.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+            }
+        }));
+    }
+
+    std::this_thread::sleep_for(RUN_TIME);
+    stop.store(true);
+    writer.join();
+    for (unsigned r = 0; r < readers; r++) {
+        readerThreads[r].join();
+    }
+
+    Histogram reads;
+    for (unsigned r = 0; r < readers; r++) {
+        reads.merge(readLatency[r]);
+    }
+
+    double seconds = std::chrono::duration<double>(RUN_TIME).count();
+    printf("%-8s %8u %12.0f %7uns %7uns %9.0fns %7uns %7uns %9.0fns %10u %8llu\n",
+        name, readers, reads.count / seconds,
+        reads.percentile(0.5), reads.percentile(0.999), reads.worstNs,
+        writeLatency.percentile(0.5), writeLatency.percentile(0.999), writeLatency.worstNs,
+        box.getRetryCount(), static_cast<unsigned long long>(torn.load()));
+}
+
+int main() {
+    printf("núcleos do host: %u, snapshot de %u bytes\n\n",
+        std::thread::hardware_concurrency(), static_cast<unsigned>(sizeof(Snapshot)));
+
+    printf("%-8s %8s %12s %9s %9s %11s %9s %9s %11s %10s %8s\n",
+        "esquema", "leitores", "leituras/s", "leit p50", "p99,9", "pior",
+        "escr p50", "p99,9", "pior", "retentat.", "rasgadas");
+
+    static const unsigned s_readers[] = { 1, 3 };
+    for (size_t i = 0; i < sizeof(s_readers) / sizeof(s_readers[0]); i++) {
+        runCase<MutexBox>("mutex", s_readers[i]);
+        runCase<SeqLock<Snapshot> >("seqlock", s_readers[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file AlertEngine.h
+ * @brief Alertas de nível e de tendência com histerese, avaliados a cada amostra.
+ */
+
+#ifndef ALERT_ENGINE_H
+#define ALERT_ENGINE_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "DataTypes.h"
+#include "RuleScript.h"
+
+/**
+ * @enum AlertChannel
+ * @brief Canal de SensorData observado por uma regra.
+ */
+enum class AlertChannel : uint8_t {
+    TEMPERATURE,    ///< Temperatura (°C)
+    HUMIDITY        ///< Umidade relativa (%)
+};
+
+/**
+ * @enum AlertMetric
+ * @brief Grandeza do canal comparada com o limiar.
+ */
+enum class AlertMetric : uint8_t {
+    LEVEL,          ///< Valor filtrado
+    RATE            ///< Taxa do estimador de tendência (unidades/min)
+};
+
+/**
+ * @enum AlertComparison
+ * @brief Sentido da violação do limiar.
+ */
+enum class AlertComparison : uint8_t {
+    ABOVE,          ///< Dispara acima do limiar
+    BELOW           ///< Dispara abaixo do limiar
+};
+
+/**
+ * Regra de alerta.
+ *
+ * Dispara quando a grandeza passa do limiar por holdMs seguidos e só
+ * volta ao normal quando recua além de hysteresis por clearMs seguidos.
+ * Com smoothingMs, a grandeza passa antes por uma média exponencial com
+ * essa constante de tempo: a taxa de uma única amostra tem incerteza de
+ * ~0,25 °C/min, então tendências lentas como -3 °C/h só se separam do
+ * ruído na média de alguns minutos. A regra só é avaliada depois de uma
+ * constante de tempo, quando a média já não depende da primeira amostra.
+ *
+ * Exemplo: { "umidade_alta", HUMIDITY, LEVEL, ABOVE, 95.0f, 3.0f, 0, 600000, 60000 }
+ * dispara com RH > 95% por 10 min e volta ao normal com RH < 92% por 1 min.
+ */
+struct AlertRule {
+    const char *name;               // Identificador enviado à API e ao painel
+    AlertChannel channel;
+    AlertMetric metric;
+    AlertComparison comparison;
+    float threshold;                // Limiar (unidade do canal, ou unidade/min para taxas)
+    float hysteresis;               // Recuo além do limiar exigido para normalizar
+    uint32_t smoothingMs;           // Constante de tempo da média exponencial (0 = sem média)
+    uint32_t holdMs;                // Duração mínima da violação para disparar (ms)
+    uint32_t clearMs;               // Duração mínima da normalização para encerrar (ms)
+};
+
+/**
+ * Transição de uma regra, entregue ao listener.
+ *
+ * Cópia trivial: pode atravessar filas do FreeRTOS. A regra aponta para
+ * a tabela estática do motor; o nome é copiado porque as regras
+ * configuradas podem ser trocadas com o evento ainda na fila.
+ */
+struct AlertEvent {
+    const AlertRule *rule;          // Regra da tabela, ou nullptr para uma regra configurada
+    char name[RuleProgram::NAME_SIZE];
+    bool active;                    // true ao disparar, false ao normalizar
+    float value;                    // Grandeza (após a média) ou valor da expressão na transição
+    uint32_t timestamp;             // Instante da transição (ms desde o boot)
+};
+
+/**
+ * Motor de alertas incremental.
+ *
+ * Cada regra guarda apenas o estado atual e o início da condição
+ * pendente, então evaluate() custa O(regras) por amostra, sem varrer
+ * histórico. A duração das condições é medida pelo tempo informado a
+ * cada avaliação, portanto o motor deve ser chamado a cada amostra nova.
+ *
+ * Além da tabela estática, avalia as regras configuradas em campo
+ * (RuleScript.h). A expressão de cada uma é a condição de alarme e passa
+ * pela mesma lógica de holdMs e clearMs; a histerese fica na própria
+ * expressão, com a variável ativo.
+ *
+ * Não é thread-safe: evaluate() e setScripts() devem ser chamados por uma
+ * única tarefa. O listener é chamado nessa tarefa.
+ */
+class AlertEngine {
+public:
+    /**
+     * Função chamada a cada transição de uma regra.
+     */
+    typedef void (*Listener)(const AlertEvent &event, void *context);
+
+    // Regras padrão do firmware
+    static const AlertRule DEFAULT_RULES[];
+    static const uint8_t DEFAULT_RULE_COUNT;
+
+    /**
+     * Construtor.
+     *
+     * @param rules Tabela de regras (estática; até ALERT_MAX_RULES).
+     * @param count Número de regras.
+     */
+    AlertEngine(const AlertRule *rules = DEFAULT_RULES, uint8_t count = DEFAULT_RULE_COUNT);
+
+    /**
+     * Define a função chamada a cada transição.
+     *
+     * @param listener Função de notificação (nullptr desativa).
+     * @param context Ponteiro repassado ao listener.
+     */
+    void setListener(Listener listener, void *context = nullptr);
+
+    /**
+     * Avalia todas as regras com uma amostra nova.
+     *
+     * @param data Amostra processada.
+     * @param now Instante da amostra (ms).
+     * @return Número de regras que mudaram de estado.
+     */
+    uint8_t evaluate(const SensorData &data, uint32_t now);
+
+    /**
+     * Substitui as regras configuradas.
+     *
+     * As regras disparadas do conjunto anterior são normalizadas com
+     * notificação; as novas começam no estado normal.
+     *
+     * @param set Regras compiladas (copiadas).
+     * @param now Tempo atual (ms).
+     */
+    void setScripts(const RuleSet &set, uint32_t now);
+
+    /**
+     * Volta todas as regras ao estado normal, sem notificar.
+     */
+    void reset();
+
+    /**
+     * @param index Índice da regra.
+     * @return true se a regra está disparada.
+     */
+    bool isActive(uint8_t index) const;
+
+    /**
+     * @return Número de regras disparadas.
+     */
+    uint8_t getActiveCount() const;
+
+    /**
+     * @return Número de regras da tabela.
+     */
+    uint8_t getRuleCount() const { return m_count; }
+
+    /**
+     * @return Número de regras configuradas.
+     */
+    uint8_t getScriptCount() const { return m_scripts.count; }
+
+    /**
+     * @return Execuções de regras configuradas interrompidas pelo interpretador.
+     */
+    uint32_t getScriptErrors() const { return m_scriptErrors; }
+
+    /**
+     * @param index Índice da regra.
+     * @return Regra no índice, ou nullptr fora da tabela.
+     */
+    const AlertRule *getRule(uint8_t index) const;
+
+    /**
+     * Formata uma transição em texto legível.
+     *
+     * Exemplo: "umidade_alta ativo: umidade 96.2 % (limiar > 95.0 %)".
+     *
+     * @param event Transição.
+     * @param buffer Destino (terminado em nulo).
+     * @param size Tamanho do destino.
+     * @return Número de caracteres escritos.
+     */
+    static size_t describe(const AlertEvent &event, char *buffer, size_t size);
+
+private:
+    /**
+     * Estado incremental de uma regra.
+     */
+    struct RuleState {
+        bool active;                // Regra disparada
+        bool pending;               // Condição de transição em curso
+        bool initialized;           // Média já recebeu a primeira amostra
+        uint32_t pendingSince;      // Início da condição em curso (ms)
+        uint32_t lastUpdate;        // Instante da última amostra (ms)
+        uint32_t startedAt;         // Primeira amostra da média (ms)
+        float value;                // Grandeza após a média
+    };
+
+    /**
+     * Obtém a grandeza observada por uma regra, antes da média.
+     *
+     * @param rule Regra.
+     * @param data Amostra.
+     * @return Valor da grandeza.
+     */
+    static float measure(const AlertRule &rule, const SensorData &data);
+
+    /**
+     * Avança o estado de uma regra com o resultado da amostra.
+     *
+     * @param state Estado da regra.
+     * @param crossing true se a condição de transição vale nesta amostra.
+     * @param holdMs Duração exigida para disparar.
+     * @param clearMs Duração exigida para normalizar.
+     * @param now Instante da amostra (ms).
+     * @return true se a regra mudou de estado.
+     */
+    bool advance(RuleState &state, bool crossing, uint32_t holdMs, uint32_t clearMs, uint32_t now);
+
+    /**
+     * Entrega uma transição ao listener.
+     */
+    void notify(const AlertRule *rule, const char *name, bool active, float value, uint32_t now);
+
+    const AlertRule *m_rules;
+    uint8_t m_count;
+    RuleState m_state[ALERT_MAX_RULES];
+    uint8_t m_activeCount;
+
+    RuleSet m_scripts;                          // Regras configuradas em campo
+    RuleState m_scriptState[RuleSet::MAX_RULES];
+    uint32_t m_scriptErrors;
+
+    Listener m_listener;
+    void *m_listenerContext;
+};
+
+#endif // ALERT_ENGINE_H
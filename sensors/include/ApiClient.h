@@ -7,25 +7,183 @@
 #define API_CLIENT_H
 
 #include <Arduino.h>
+#include <WiFi.h>
 #include "DataTypes.h" // Usaremos a struct SensorData
+#include "AlertEngine.h"
+#include "StringUtils.h"
+
+// Códigos de erro de transporte (negativos, distintos dos códigos HTTP)
+#define API_ERROR_INVALID_URL   (-1)
+#define API_ERROR_CONNECT       (-2)
+#define API_ERROR_SEND          (-3)
+#define API_ERROR_NO_RESPONSE   (-4)
+#define API_ERROR_PAYLOAD       (-5)
+
+/**
+ * Tempos de uma requisição HTTP (μs).
+ */
+struct ApiRequestTiming {
+    uint32_t connectUs;     // Estabelecimento da conexão TCP (0 se reutilizada)
+    uint32_t sendUs;        // Envio de cabeçalhos e corpo
+    uint32_t firstByteUs;   // Espera pelo primeiro byte da resposta
+    uint32_t totalUs;       // Duração total da requisição
+    int16_t statusCode;     // Código HTTP ou valor negativo em caso de erro
+    bool reused;            // true se a conexão keep-alive foi reutilizada
+
+    ApiRequestTiming() : connectUs(0), sendUs(0), firstByteUs(0), totalUs(0),
+                         statusCode(0), reused(false) {}
+};
 
 class ApiClient {
 public:
     /**
      * @brief Construtor.
-     * @param endpointUrl A URL completa do endpoint da API.
+     * @param endpointUrl A URL completa do endpoint da API (http://host[:porta]/caminho).
      */
     ApiClient(const char* endpointUrl);
 
     /**
      * @brief Envia os dados dos sensores para a API.
      * @param data Os dados dos sensores a serem enviados.
-     * @return true se o envio foi bem-sucedido (código HTTP 2xx), false caso contrário.
+     * @param boot Boot em que a amostra foi registrada ("boot"; 0 omite o campo).
+     * @return Código HTTP da resposta, ou API_ERROR_* (negativo) se não houve
+     *         resposta ou o payload não pôde ser montado.
+     */
+    int sendData(const SensorData& data, uint32_t boot = 0);
+
+    /**
+     * @brief Envia várias amostras em uma única requisição.
+     *
+     * Formato compacto: colunas declaradas uma vez, timestamp base "t0" e,
+     * por amostra, o delta em ms e os valores inteiros escalados por "div".
+     * Exemplo: {"v":1,"boot":7,"t0":5000,"cols":["dt","temperatura","umidade"],
+     *           "div":[1,10,10],"rows":[[0,253,651],[2000,254,650]]}
+     *
+     * Os timestamps são millis() de um único boot, identificado por "boot":
+     * amostras de boots diferentes devem ir em lotes separados.
+     *
+     * @param samples Amostras em ordem cronológica, todas do mesmo boot.
+     * @param count Número de amostras.
+     * @param boot Boot em que as amostras foram registradas (0 omite o campo).
+     * @return Código HTTP da resposta, ou API_ERROR_* (negativo) se não houve
+     *         resposta ou o payload não pôde ser montado.
+     */
+    int sendBatch(const SensorData* samples, size_t count, uint32_t boot = 0);
+
+    /**
+     * @brief Envia uma transição de alerta para o mesmo endpoint.
+     *
+     * Exemplo: {"alerta":"umidade_alta","ativo":true,"valor":96.2,
+     *           "limiar":95,"timestamp":605000}
+     * Regras configuradas em campo não têm "limiar".
+     *
+     * @param event Transição informada pelo AlertEngine.
+     * @return Código HTTP da resposta, ou API_ERROR_* (negativo) se não houve
+     *         resposta ou o payload não pôde ser montado.
+     */
+    int sendAlert(const AlertEvent& event);
+
+    /**
+     * @brief Indica se o código retornado por um envio é de sucesso (2xx).
+     */
+    static bool isSuccess(int httpCode) { return httpCode >= 200 && httpCode < 300; }
+
+    /**
+     * @brief Indica se vale reenviar a mesma requisição.
+     *
+     * Só falhas de transporte e respostas 5xx são transitórias; um payload
+     * recusado pela API (4xx) ou impossível de montar falharia sempre.
+     */
+    static bool isRetryable(int httpCode) {
+        return httpCode >= 500 || (httpCode < 0 && httpCode != API_ERROR_PAYLOAD);
+    }
+
+    /**
+     * @brief Define se o corpo da resposta deve ser descartado sem alocação.
+     * @param discard true para descartar, false para registrar o início do corpo em log.
+     */
+    void setDiscardResponse(bool discard);
+
+    /**
+     * @brief Obtém os tempos da última requisição.
+     * @return Tempos de conexão, envio e primeiro byte.
+     */
+    const ApiRequestTiming& getLastTiming() const;
+
+    /**
+     * @brief Obtém o número de requisições que reutilizaram a conexão.
      */
-    bool sendData(const SensorData& data);
+    uint32_t getReusedCount() const;
+
+    /**
+     * @brief Obtém o número de conexões TCP abertas.
+     */
+    uint32_t getConnectCount() const;
 
 private:
     String m_endpointUrl; // Armazena a URL da API
+    char m_host[64];      // Host extraído da URL
+    char m_path[96];      // Caminho extraído da URL
+    uint16_t m_port;      // Porta extraída da URL
+
+    WiFiClient m_client;        // Conexão persistente (HTTP/1.1 keep-alive)
+    uint32_t m_lastActivity;    // Último uso da conexão (ms)
+    bool m_discardResponse;     // Descarta o corpo da resposta sem alocar
+
+    ApiRequestTiming m_lastTiming;
+    uint32_t m_reusedCount;
+    uint32_t m_connectCount;
+
+    /**
+     * @brief Extrai host, porta e caminho da URL do endpoint.
+     * @return true se a URL é válida.
+     */
+    bool parseUrl();
+
+    /**
+     * @brief Registra o resultado de um envio e informa se foi bem-sucedido.
+     * @param httpCode Código HTTP ou erro de transporte retornado por post().
+     * @return true para códigos 2xx.
+     */
+    bool handleResult(int httpCode);
+
+    /**
+     * @brief Executa um POST reutilizando a conexão quando possível.
+     *
+     * Reconecta automaticamente se a conexão ociosa foi fechada pelo servidor.
+     *
+     * @param payload Corpo JSON da requisição.
+     * @param length Tamanho do corpo.
+     * @return Código HTTP ou valor negativo em caso de erro de transporte.
+     */
+    int post(const char* payload, size_t length);
+
+    /**
+     * @brief Realiza uma tentativa de POST na conexão atual.
+     * @param payload Corpo JSON da requisição.
+     * @param length Tamanho do corpo.
+     * @param timing Tempos da tentativa.
+     * @param keepAlive Indica se o servidor mantém a conexão aberta.
+     * @return Código HTTP ou valor negativo em caso de erro de transporte.
+     */
+    int attemptPost(const char* payload, size_t length, ApiRequestTiming& timing, bool& keepAlive);
+
+    /**
+     * @brief Lê uma linha da resposta com limite de tempo.
+     * @param buffer Buffer de destino (terminado em nulo, sem CR/LF).
+     * @param size Tamanho do buffer.
+     * @param deadline Instante limite (ms).
+     * @return Número de caracteres armazenados ou -1 em caso de timeout.
+     */
+    int readLine(char* buffer, size_t size, uint32_t deadline);
+
+    /**
+     * @brief Consome o corpo da resposta usando um buffer fixo na pilha.
+     * @param contentLength Tamanho do corpo.
+     * @param deadline Instante limite (ms).
+     * @return true se o corpo foi consumido por completo.
+     */
+    bool drainBody(size_t contentLength, uint32_t deadline);
 };
 
-#endif // API_CLIENT_H
\ No newline at end of file
+#endif // API_CLIENT_H
@@ -16,6 +16,12 @@
 #include "SystemMonitor.h"
 #include "WiFiManager.h"
 #include "MemoryManager.h"
+#include "MessageBufferPool.h"
+#include "ClientSubscriptions.h"
+#include "LogSystem.h"
+#include "RuleStore.h"
+
+class Scheduler;
 
 /**
  * Classe para servidor web assíncrono com WebSockets
@@ -26,15 +32,36 @@
 class AsyncSoilWebServer {
 private:
     AsyncWebServer m_server;           // Servidor web assíncrono
-    AsyncWebSocket m_websocket;        // Servidor WebSocket
+    AsyncWebSocket m_websocket;        // Servidor WebSocket (telemetria JSON)
+    AsyncWebSocket m_binarySocket;     // Servidor WebSocket (telemetria binária)
+    MessageBufferPool m_jsonPool;      // Buffers compartilhados para quadros JSON
+    MessageBufferPool m_binaryPool;    // Buffers compartilhados para quadros binários
+    MessageBufferPool m_logPool;       // Buffers compartilhados para quadros de log
+    SubscriptionTable m_subscriptions; // Tópicos, taxa e formato de cada cliente
     SensorManager &m_sensorManager;    // Referência para o gerenciador de sensores
 
-    uint32_t m_lastBroadcastTime;      // Timestamp da última broadcast
     uint16_t m_clientCount;            // Contador de clientes WebSocket
     uint32_t m_broadcastCount;         // Contador de broadcasts
+    uint32_t m_dataRequests;           // Requisições a /data
+    uint32_t m_dataNotModified;        // Respostas 304 em /data
+    uint32_t m_dataMaxUs;              // Maior tempo do handler de /data (μs)
+    uint32_t m_bootNonce;              // Aleatório por boot: ETags de /data não sobrevivem a um reinício
+
+    // Alertas pendentes: entregues a todos os clientes, nunca conflacionados
+    struct AlertSlot {
+        uint16_t length;
+        char payload[WS_ALERT_FRAME_SIZE];
+    };
+    AlertSlot m_alerts[WS_ALERT_QUEUE_SIZE]; // Anel indexado pela sequência do alerta
+    volatile uint32_t m_alertHead;     // Sequência do próximo alerta
+    uint32_t m_alertDelivered;         // Sequência entregue a todos na última passagem
+    bool m_alertBacklog;               // Algum cliente ficou com alertas pendentes
+    portMUX_TYPE m_alertLock;
 
-    // HTML da página principal (armazenado em PROGMEM para economizar RAM)
-    static const char INDEX_HTML[] PROGMEM;
+    // Escalonador da tarefa web, acordado por alertas e novas conexões
+    Scheduler *m_scheduler;
+    uint32_t m_alertEvent;
+    uint32_t m_clientEvent;
 
     /**
      * Manipulador de eventos WebSocket.
@@ -57,6 +84,46 @@ private:
      */
     void processWebSocketCommand(AsyncWebSocketClient *client, uint8_t *data, size_t len);
 
+    /**
+     * Aplica um comando subscribe/unsubscribe e confirma ao cliente.
+     *
+     * subscribe: {"action":"subscribe","topics":["sensors","logs"],"rate":2,"format":"json"}
+     * (campos ausentes mantêm os valores atuais). unsubscribe remove os
+     * tópicos listados, ou todos se "topics" for omitido.
+     *
+     * @param client Ponteiro para o cliente WebSocket.
+     * @param command Documento do comando.
+     * @param subscribe true para subscribe, false para unsubscribe.
+     */
+    void processSubscription(AsyncWebSocketClient *client, JsonDocument &command, bool subscribe);
+
+    /**
+     * Compila e publica as regras configuradas de um comando.
+     *
+     * Formato: [{"name":"geada","expr":"temperatura < 2","hold":300,"clear":600}],
+     * com hold e clear em segundos (0 se omitidos). Usado pelo comando
+     * WebSocket "rules" e por POST /rules.
+     *
+     * @param rules Lista de regras (vazia remove todas; nula é erro).
+     * @param error Regra e posição do erro, se houver.
+     * @return true se as regras foram publicadas.
+     */
+    static bool applyRules(JsonArrayConst rules, RuleUpdateError &error);
+
+    /**
+     * Formata a resposta de uma atualização de regras.
+     *
+     * Exemplos: {"type":"rules","ok":true,"count":2} e
+     * {"type":"rules","ok":false,"rule":1,"pos":12,"error":"..."}.
+     *
+     * @param ok Resultado de applyRules().
+     * @param error Erro, se houver.
+     * @param out Destino.
+     * @param size Capacidade do destino.
+     * @return Bytes escritos (0 se não couber).
+     */
+    static size_t formatRulesResult(bool ok, const RuleUpdateError &error, char *out, size_t size);
+
     /**
      * Callback para eventos WebSocket.
      *
@@ -70,9 +137,34 @@ private:
     static void onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
                             AwsEventType type, void *arg, uint8_t *data, size_t len);
 
+    /**
+     * Localiza o cliente conectado de uma assinatura.
+     *
+     * @return Cliente ou nullptr se já se desconectou.
+     */
+    AsyncWebSocketClient *findClient(const ClientSubscription &subscription);
+
+    /**
+     * Amostra a fila de saída de um cliente.
+     *
+     * @param client Cliente WebSocket.
+     * @param flow Estado de fluxo a atualizar.
+     */
+    void sampleFlow(AsyncWebSocketClient *client, ClientFlowStats &flow);
+
+    /**
+     * Entrega os alertas pendentes a cada cliente, respeitando a fila.
+     *
+     * @return true se algum cliente ainda tem alertas pendentes.
+     */
+    bool deliverAlerts();
+
     /**
      * Handler para a rota principal.
      *
+     * Envia o painel pré-comprimido (DashboardAssets.h) com ETag do
+     * conteúdo e cache de longa duração; 304 se o navegador já o tem.
+     *
      * @param request Ponteiro para a requisição HTTP.
      */
     void handleRoot(AsyncWebServerRequest *request);
@@ -80,6 +172,10 @@ private:
     /**
      * Handler para a rota de dados.
      *
+     * Responde a partir do último snapshot publicado, com ETag derivada da
+     * aquisição do DHT22 e de um nonce do boot (304 se o cliente já tem a
+     * amostra atual) e Age contado desde a última aquisição bem-sucedida.
+     *
      * @param request Ponteiro para a requisição HTTP.
      */
     void handleData(AsyncWebServerRequest *request);
@@ -87,10 +183,92 @@ private:
     /**
      * Handler para a rota de logs do sistema.
      *
+     * Transmite o buffer circular em resposta chunked, uma entrada por
+     * chamada, com memória constante. Parâmetros: format=text|ndjson,
+     * since=<sequência> e level=<nível mínimo>. O cabeçalho X-Log-Sequence
+     * traz o valor de since para a próxima consulta.
+     *
      * @param request Ponteiro para a requisição HTTP.
      */
     void handleLogs(AsyncWebServerRequest *request);
 
+    /**
+     * Handler para a rota de carga da CPU.
+     *
+     * Responde com a carga atual de cada núcleo, o histórico recente
+     * (CPU_LOAD_HISTORY amostras) e o tempo de CPU por tarefa.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleCpu(AsyncWebServerRequest *request);
+
+    /**
+     * Handler para a rota de métricas.
+     *
+     * Exporta o registro de Metrics.h no formato texto do Prometheus, em
+     * resposta chunked de uma linha por chamada.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleMetrics(AsyncWebServerRequest *request);
+
+    /**
+     * Handler de GET /rules.
+     *
+     * Lista as regras configuradas (fontes) e os limites da linguagem.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleRulesGet(AsyncWebServerRequest *request);
+
+    /**
+     * Handler de POST /rules, chamado com o corpo já acumulado.
+     *
+     * Corpo: {"rules":[...]} no formato de applyRules(). Responde 200 ou
+     * 400 com a resposta de formatRulesResult(); 413 acima de
+     * RULE_UPLOAD_MAX_SIZE.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleRulesPost(AsyncWebServerRequest *request);
+
+    /**
+     * Acumula o corpo de POST /rules em request->_tempObject.
+     *
+     * O buffer é alocado com malloc e liberado pela biblioteca junto com
+     * a requisição.
+     */
+    static void handleRulesBody(AsyncWebServerRequest *request, uint8_t *data, size_t len,
+                                size_t index, size_t total);
+
+    /**
+     * Formata uma entrada de log como linha de texto ou NDJSON.
+     *
+     * @param entry Entrada do buffer circular.
+     * @param sequence Sequência da entrada.
+     * @param ndjson true para um objeto JSON por linha.
+     * @param out Destino (LOG_STREAM_LINE_SIZE bytes bastam).
+     * @param size Capacidade do destino.
+     * @return Bytes escritos, incluindo a quebra de linha final.
+     */
+    static size_t formatLogLine(const LogEntry &entry, uint32_t sequence, bool ndjson,
+                                char *out, size_t size);
+
+    /**
+     * Formata o registro de lacuna enviado quando a entrada em transmissão
+     * é sobrescrita no meio da linha.
+     *
+     * Começa com uma quebra de linha, que encerra a linha interrompida.
+     *
+     * @param from Sequência da entrada interrompida.
+     * @param to Próxima sequência transmitida.
+     * @param ndjson true para um objeto JSON por linha.
+     * @param out Destino.
+     * @param size Capacidade do destino.
+     * @return Bytes escritos.
+     */
+    static size_t formatLogGap(uint32_t from, uint32_t to, bool ndjson, char *out, size_t size);
+
     /**
      * Handler para requisições não encontradas.
      *
@@ -124,12 +302,32 @@ public:
     bool begin();
 
     /**
-     * Atualiza o servidor web.
+     * Envia a telemetria aos clientes conectados.
+     *
+     * Chamado pelo job de broadcast da tarefa web a cada WS_BROADCAST_INTERVAL.
      *
-     * @param forceUpdate Force o envio de atualizações, mesmo sem intervalo.
      * @return true se enviou atualizações.
      */
-    bool update(bool forceUpdate = false);
+    bool broadcastTelemetry();
+
+    /**
+     * Entrega os alertas registrados por queueAlert().
+     *
+     * @return true se algum cliente ainda tem alertas pendentes.
+     */
+    bool updateAlerts();
+
+    /**
+     * Conecta o servidor ao escalonador da tarefa web.
+     *
+     * queueAlert() e novas conexões passam a acordar a tarefa com os
+     * eventos informados, sem esperar o próximo prazo.
+     *
+     * @param scheduler Escalonador da tarefa web.
+     * @param alertEvent Evento sinalizado por queueAlert().
+     * @param clientEvent Evento sinalizado a cada nova conexão.
+     */
+    void attachScheduler(Scheduler *scheduler, uint32_t alertEvent, uint32_t clientEvent);
 
     /**
      * Obtém o número de clientes conectados.
@@ -138,6 +336,20 @@ public:
      */
     uint16_t getClientCount() const;
 
+    /**
+     * Obtém o número de clientes que recebem telemetria JSON.
+     *
+     * @return Número de clientes com assinatura no formato JSON.
+     */
+    uint16_t getJsonClientCount() const;
+
+    /**
+     * Obtém o número de clientes que recebem telemetria binária.
+     *
+     * @return Número de clientes com assinatura no formato binário.
+     */
+    uint16_t getBinaryClientCount() const;
+
     /**
      * Envia mensagem para todos os clientes WebSocket.
      *
@@ -146,6 +358,99 @@ public:
      */
     bool broadcastMessage(const String &message);
 
+    /**
+     * Envia um quadro binário para os clientes do endpoint binário.
+     *
+     * @param data Quadro serializado.
+     * @param len Tamanho do quadro.
+     * @return true se há clientes para receber.
+     */
+    bool broadcastBinary(const uint8_t *data, size_t len);
+
+    /**
+     * Obtém um buffer livre do pool JSON.
+     *
+     * @param length Tamanho do quadro (bytes).
+     * @return Buffer para serialização ou nullptr se o pool está esgotado.
+     */
+    AsyncWebSocketMessageBuffer *acquireJsonBuffer(size_t length);
+
+    /**
+     * Obtém um buffer livre do pool binário.
+     *
+     * @param length Tamanho do quadro (bytes).
+     * @return Buffer para serialização ou nullptr se o pool está esgotado.
+     */
+    AsyncWebSocketMessageBuffer *acquireBinaryBuffer(size_t length);
+
+    /**
+     * Obtém um buffer livre do pool de logs.
+     *
+     * @param length Tamanho do quadro (bytes).
+     * @return Buffer para serialização ou nullptr se o pool está esgotado.
+     */
+    AsyncWebSocketMessageBuffer *acquireLogBuffer(size_t length);
+
+    /**
+     * Copia as assinaturas dos clientes conectados.
+     *
+     * @param out Destino das assinaturas.
+     * @param maxCount Capacidade do destino.
+     * @return Número de assinaturas copiadas.
+     */
+    size_t getSubscriptions(ClientSubscription *out, size_t maxCount) const;
+
+    /**
+     * Enfileira um quadro de telemetria compartilhado para um cliente.
+     *
+     * O mesmo buffer pode ser entregue a vários clientes sem cópia; cada
+     * mensagem mantém uma referência até terminar de ser enviada. Após
+     * entregá-lo, o chamador destrava o buffer (unlock()).
+     *
+     * Com WS_CONFLATE_QUEUE_DEPTH mensagens já na fila, o quadro não é
+     * enfileirado (conflação): quando a fila esvaziar, o cliente recebe um
+     * snapshot com os valores mais recentes em vez dos quadros perdidos.
+     *
+     * @param subscription Assinatura do cliente de destino.
+     * @param buffer Buffer obtido de um dos pools.
+     * @return true se algo foi enfileirado para o cliente.
+     */
+    bool sendTelemetry(const ClientSubscription &subscription, AsyncWebSocketMessageBuffer *buffer);
+
+    /**
+     * Enfileira um quadro de log compartilhado para um cliente.
+     *
+     * Logs são best-effort: com o cliente atrasado o quadro é descartado.
+     *
+     * @param subscription Assinatura do cliente de destino.
+     * @param buffer Buffer obtido do pool de logs.
+     * @return true se o quadro foi enfileirado.
+     */
+    bool sendLog(const ClientSubscription &subscription, AsyncWebSocketMessageBuffer *buffer);
+
+    /**
+     * Registra um alerta para entrega a todos os clientes.
+     *
+     * Pode ser chamado de qualquer tarefa; a entrega é feita pela tarefa
+     * web em updateAlerts(), acordada pelo evento de alerta. Alertas não passam pela conflação: clientes atrasados
+     * os recebem quando houver espaço na fila, e apenas um estouro do anel
+     * (WS_ALERT_QUEUE_SIZE) os descarta, com contagem em alertsLost.
+     *
+     * @param module Módulo de origem.
+     * @param level Nível do alerta.
+     * @param message Mensagem formatada.
+     */
+    void queueAlert(const char *module, LogLevel level, const char *message);
+
+    /**
+     * Copia o estado de fluxo de saída de cada cliente.
+     *
+     * @param out Destino dos registros.
+     * @param maxCount Capacidade do destino.
+     * @return Número de registros copiados.
+     */
+    size_t getFlowStats(ClientFlowStats *out, size_t maxCount) const;
+
     /**
      * Limpa clientes inativos.
      *
@@ -0,0 +1,192 @@
+/**
+ * @file ClientSubscriptions.h
+ * @brief Assinaturas WebSocket por cliente (tópicos, taxa e formato).
+ */
+
+#ifndef CLIENT_SUBSCRIPTIONS_H
+#define CLIENT_SUBSCRIPTIONS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "Config.h"
+
+// Tópicos de assinatura (máscara de bits)
+#define WS_TOPIC_SENSORS          0x01   // Temperatura, umidade, timestamp e leituras
+#define WS_TOPIC_STATS            0x02   // Heap, fragmentação, uptime, clientes e CPU
+#define WS_TOPIC_WIFI             0x04   // Endereço IP e RSSI
+#define WS_TOPIC_LOGS             0x08   // Novas entradas do log do sistema
+#define WS_TOPICS_TELEMETRY       (WS_TOPIC_SENSORS | WS_TOPIC_STATS | WS_TOPIC_WIFI)
+#define WS_TOPICS_DEFAULT         WS_TOPICS_TELEMETRY
+
+/**
+ * Assinatura de um cliente WebSocket.
+ *
+ * Os ids de cliente são sequenciais por endpoint, portanto a chave é o par
+ * (clientId, binaryEndpoint).
+ */
+struct ClientSubscription {
+    uint32_t clientId;      // Id do cliente (0 = posição livre)
+    bool binaryEndpoint;    // Conectado em WS_BINARY_PATH
+    bool binary;            // Formato da telemetria: TelemetryFrame ou JSON
+    uint8_t topics;         // Máscara WS_TOPIC_*
+    uint8_t rateClass;      // Índice em WS_RATE_CLASS_PERIODS
+
+    ClientSubscription() : clientId(0), binaryEndpoint(false), binary(false),
+                           topics(0), rateClass(0) {}
+};
+
+/**
+ * Estado de fluxo de saída de um cliente WebSocket.
+ *
+ * Atualizado apenas pela tarefa web, que faz os envios; a leitura por
+ * outras tarefas passa pela cópia protegida da tabela.
+ */
+struct ClientFlowStats {
+    uint32_t clientId;      // Id do cliente
+    bool binaryEndpoint;    // Conectado em WS_BINARY_PATH
+    bool resync;            // Perdeu quadros: o próximo envio é um snapshot
+    uint16_t queueDepth;    // Mensagens na fila do cliente (última amostra)
+    uint16_t maxQueueDepth; // Maior fila observada
+    uint16_t avgFrameBytes; // Tamanho médio dos quadros enviados (média móvel)
+    uint32_t bytesInFlight; // Estimativa: fila da biblioteca + buffer TCP não confirmado
+    uint32_t framesSent;    // Quadros de telemetria enfileirados
+    uint32_t conflated;     // Quadros de telemetria substituídos por um mais recente
+    uint32_t logsDropped;   // Quadros de log descartados com o cliente atrasado
+    uint32_t alertSequence; // Próximo alerta a entregar
+    uint32_t alertsSent;    // Alertas enfileirados
+    uint32_t alertsLost;    // Alertas sobrescritos antes da entrega
+
+    ClientFlowStats() : clientId(0), binaryEndpoint(false), resync(false), queueDepth(0),
+                        maxQueueDepth(0), avgFrameBytes(0), bytesInFlight(0), framesSent(0),
+                        conflated(0), logsDropped(0), alertSequence(0), alertsSent(0),
+                        alertsLost(0) {}
+};
+
+/**
+ * Tabela fixa de assinaturas.
+ *
+ * Clientes com a mesma classe de taxa, tópicos e formato recebem o mesmo
+ * quadro serializado; a tabela apenas descreve quem recebe o quê. É
+ * alterada pela tarefa do AsyncTCP (eventos) e lida pela tarefa web,
+ * por isso todo acesso passa por uma seção crítica curta.
+ */
+class SubscriptionTable {
+public:
+    SubscriptionTable();
+
+    /**
+     * Registra um cliente com a assinatura padrão do endpoint.
+     *
+     * @param clientId Id do cliente.
+     * @param binaryEndpoint true se conectado em WS_BINARY_PATH.
+     * @param alertSequence Primeiro alerta a entregar ao cliente.
+     * @param out Assinatura criada.
+     * @return false se a tabela está cheia.
+     */
+    bool add(uint32_t clientId, bool binaryEndpoint, uint32_t alertSequence, ClientSubscription &out);
+
+    /**
+     * Remove um cliente.
+     */
+    void remove(uint32_t clientId, bool binaryEndpoint);
+
+    /**
+     * Substitui tópicos, classe de taxa e formato de um cliente.
+     *
+     * O estado de fluxo do cliente é preservado.
+     *
+     * @return false se o cliente não está registrado.
+     */
+    bool update(const ClientSubscription &subscription);
+
+    /**
+     * Obtém a assinatura de um cliente.
+     *
+     * @return false se o cliente não está registrado.
+     */
+    bool find(uint32_t clientId, bool binaryEndpoint, ClientSubscription &out) const;
+
+    /**
+     * Copia as assinaturas ativas.
+     *
+     * @param out Destino (WS_MAX_SUBSCRIBERS posições bastam).
+     * @param maxCount Capacidade do destino.
+     * @return Número de assinaturas copiadas.
+     */
+    size_t copy(ClientSubscription *out, size_t maxCount) const;
+
+    /**
+     * Obtém o estado de fluxo de um cliente.
+     *
+     * @return false se o cliente não está registrado.
+     */
+    bool getFlow(uint32_t clientId, bool binaryEndpoint, ClientFlowStats &out) const;
+
+    /**
+     * Grava o estado de fluxo de um cliente, se ele ainda estiver registrado.
+     */
+    void setFlow(const ClientFlowStats &flow);
+
+    /**
+     * Copia o estado de fluxo dos clientes registrados.
+     *
+     * @param out Destino (WS_MAX_SUBSCRIBERS posições bastam).
+     * @param maxCount Capacidade do destino.
+     * @return Número de registros copiados.
+     */
+    size_t copyFlow(ClientFlowStats *out, size_t maxCount) const;
+
+    /**
+     * Remove todas as assinaturas.
+     */
+    void clear();
+
+    /**
+     * @return Número de clientes registrados.
+     */
+    uint16_t count() const;
+
+    /**
+     * @return Número de clientes que recebem telemetria binária.
+     */
+    uint16_t binaryCount() const;
+
+    /**
+     * Converte uma taxa máxima na classe mais rápida que não a ultrapassa.
+     *
+     * @param hz Taxa máxima pedida pelo cliente (Hz).
+     * @return Índice da classe (a mais lenta se hz for menor que todas).
+     */
+    static uint8_t rateClassFor(float hz);
+
+    /**
+     * @return Período da classe de taxa (ms).
+     */
+    static uint32_t ratePeriod(uint8_t rateClass);
+
+    /**
+     * @return Máscara TELEMETRY_FIELD_* coberta pelos tópicos.
+     */
+    static uint16_t topicFields(uint8_t topics);
+
+    /**
+     * Converte o nome de um tópico.
+     *
+     * @return Bit WS_TOPIC_* ou 0 se desconhecido.
+     */
+    static uint8_t parseTopic(const char *name);
+
+    /**
+     * @return Nome do tópico indicado por um único bit WS_TOPIC_*.
+     */
+    static const char *topicName(uint8_t topic);
+
+private:
+    ClientSubscription m_entries[WS_MAX_SUBSCRIBERS];
+    ClientFlowStats m_flow[WS_MAX_SUBSCRIBERS];     // Mesma posição de m_entries
+    mutable portMUX_TYPE m_lock;
+
+    static const uint32_t s_ratePeriods[WS_RATE_CLASS_COUNT];
+};
+
+#endif // CLIENT_SUBSCRIPTIONS_H
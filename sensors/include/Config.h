@@ -21,9 +21,58 @@
 // Portas e interfaces
 #define WEB_SERVER_PORT           80
 #define SERIAL_BAUD_RATE          115200
+#define DASHBOARD_CACHE_MAX_AGE   86400  // Cache do painel no navegador (s); revalidado pela ETag
+
+// Métricas exportadas em /metrics (formato texto do Prometheus)
+#define METRICS_HISTOGRAM_BUCKETS 8      // Máximo de faixas por histograma (além de +Inf)
+#define METRICS_LINE_SIZE         192    // Maior linha formatada da exportação (bytes)
+
+// Telemetria WebSocket: JSON em /ws (legado) e quadro binário opcional
+#ifndef WS_BINARY_TELEMETRY
+#define WS_BINARY_TELEMETRY       true   // Habilita o endpoint binário
+#endif
+#define WS_BINARY_PATH            "/ws/bin" // Endpoint da telemetria binária
+#define WS_BUFFER_POOL_SIZE       4      // Buffers de broadcast por formato (reutilizados)
+#define WS_JSON_FRAME_SIZE        448    // Maior quadro JSON aceito (bytes)
+#define WS_JSON_SIZE_CLASS        32     // Quadros JSON completados até múltiplos deste valor
+#define WS_LOG_FRAME_SIZE         1024   // Maior quadro do tópico de logs (bytes)
+#define WS_LOG_SIZE_CLASS         128    // Quadros de logs completados até múltiplos deste valor
+
+// Assinaturas por cliente: tópicos, taxa máxima e formato
+#define WS_MAX_SUBSCRIBERS        8      // Clientes WebSocket simultâneos (ambos os endpoints)
+#define WS_RATE_CLASS_COUNT       4      // Classes de taxa compartilhadas entre clientes
+#define WS_RATE_CLASS_PERIODS     { 100, 200, 1000, 5000 } // Períodos das classes (ms): 10, 5, 1 e 0,2 Hz
+
+// Controle de fluxo por cliente: telemetria conflacionada, alertas preservados
+#define WS_CONFLATE_QUEUE_DEPTH   4      // Fila a partir da qual a telemetria do cliente é conflacionada
+#define WS_ALERT_QUEUE_SIZE       8      // Alertas retidos para clientes atrasados
+#define WS_ALERT_FRAME_SIZE       320    // Maior quadro de alerta (bytes)
+#define WS_TCP_SEND_BUFFER        5744   // Buffer de envio TCP do lwIP (CONFIG_LWIP_TCP_SND_BUF_DEFAULT)
+
+// Telemetria incremental: apenas campos alterados além da banda morta
+#define TELEMETRY_KEYFRAME_INTERVAL     5000   // Quadro completo periódico (ms)
+#define TELEMETRY_DEADBAND_TEMPERATURE  0.05f  // Variação mínima de temperatura (°C)
+#define TELEMETRY_DEADBAND_HUMIDITY     0.05f  // Variação mínima de umidade (%)
+#define TELEMETRY_DEADBAND_RATE         0.05f  // Variação mínima de uma tendência (unidades/min)
+#define TELEMETRY_DEADBAND_HEAP         1024   // Variação mínima de heap livre (bytes)
+#define TELEMETRY_DEADBAND_FRAGMENTATION 1     // Variação mínima de fragmentação (%)
+#define TELEMETRY_DEADBAND_RSSI         2      // Variação mínima de RSSI (dBm)
+#define TELEMETRY_DEADBAND_CPU          2      // Variação mínima da carga de um núcleo (%)
 
 // Configurações de sensores
 #define SENSOR_CHECK_INTERVAL     200    // Intervalo de verificação dos sensores (ms)
+#define DHT22_READ_INTERVAL       2000   // Intervalo mínimo entre transações do DHT22 (ms)
+#define DHT22_CAPTURE_TIMEOUT     20     // Tempo máximo de uma transação do DHT22 (ms)
+#define DHT22_CAPTURE_POLL        4      // Verificação da captura durante uma transação (ms)
+#ifndef DHT22_USE_RMT
+#define DHT22_USE_RMT             true   // Captura não bloqueante dos pulsos via RMT
+#endif
+
+// Alertas de nível e de tendência, avaliados a cada amostra do DHT22
+#define ALERT_MAX_RULES           8      // Regras avaliadas pelo motor de alertas
+#define RULE_SOURCE_SIZE          96     // Maior expressão de uma regra configurada, com o terminador
+#define RULE_UPLOAD_MAX_SIZE      1024   // Maior corpo aceito por POST /rules (bytes)
+#define RULE_NVS_NAMESPACE        "rules" // Namespace das regras configuradas na NVS
 
 // Configurações de memória
 #define USE_STATIC_MEMORY         true   // Usar alocação estática onde possível
@@ -40,6 +89,42 @@
 #define TASK_STACK_SIZE           4096   // Tamanho da pilha para tarefas (bytes)
 #define TASK_PRIORITY_SENSOR      2      // Prioridade da tarefa de sensores
 #define TASK_PRIORITY_WEB         1      // Prioridade da tarefa web
+#define CPU_SAMPLE_INTERVAL       1000   // Intervalo de amostragem da carga da CPU (ms)
+#define CPU_LOAD_HISTORY          60     // Amostras de carga mantidas por núcleo
+#define CPU_MAX_TASKS             24     // Máximo de tarefas acompanhadas
+
+// Escalonamento por prazos: as tarefas dormem até o próximo job ou evento
+#define SCHEDULER_MAX_JOBS        8      // Jobs por tarefa
+#define WS_BROADCAST_INTERVAL     100    // Broadcast de telemetria (ms): 10 Hz, a classe mais rápida
+#define WS_CLEANUP_INTERVAL       5000   // Limpeza de clientes WebSocket inativos (ms)
+#define WS_ALERT_RETRY_INTERVAL   20     // Nova tentativa de entrega com alertas pendentes (ms)
+#define WIFI_CHECK_INTERVAL       1000   // Verificação da conexão WiFi (ms)
+#define SYSTEM_MONITOR_INTERVAL   500    // Passagem pelo monitor do sistema (ms); ele limita as estatísticas a 1 Hz
+#define MEMORY_STATS_INTERVAL     10000  // Impressão das estatísticas de memória (ms, com DEBUG_MEMORY)
+
+// Gerenciamento de energia (requer CONFIG_PM_ENABLE e CONFIG_FREERTOS_USE_TICKLESS_IDLE)
+#ifndef POWER_LIGHT_SLEEP
+#define POWER_LIGHT_SLEEP         false  // Light sleep automático entre despertares (liga o modem sleep do WiFi)
+#endif
+#define POWER_MIN_CPU_FREQ        80     // Frequência mínima do escalonamento dinâmico (MHz)
+
+// Modo de campo: ciclos de deep sleep para bateria ou painel solar
+#ifndef FIELD_MODE
+#define FIELD_MODE                false  // Substitui tarefas e servidor web por ciclos de deep sleep
+#endif
+#define FIELD_SAMPLE_INTERVAL     300    // Intervalo entre amostras (s)
+#define FIELD_UPLOAD_EVERY        12     // Liga o WiFi e envia o lote a cada N ciclos
+#define FIELD_BATCH_CAPACITY      (FIELD_UPLOAD_EVERY * 4) // Amostras retidas na memória RTC (cobre envios com falha)
+#define FIELD_CPU_FREQ            80     // Frequência da CPU acordada (MHz; mínimo para o WiFi)
+#define FIELD_WIFI_TIMEOUT        10000  // Tempo máximo de conexão ao WiFi por envio (ms)
+#define FIELD_MIN_SLEEP           1000   // Menor deep sleep programado (ms)
+
+// Modelo de consumo do orçamento de energia (ajuste à placa)
+#define FIELD_CURRENT_ACTIVE_MA   25.0f  // CPU a FIELD_CPU_FREQ com o rádio desligado (mA)
+#define FIELD_CURRENT_RADIO_MA    110.0f // Média com o WiFi conectando e enviando (mA)
+#define FIELD_CURRENT_SLEEP_UA    150.0f // Deep sleep da placa inteira (μA; ~10 μA só o ESP32)
+#define FIELD_BOOT_TIME           250    // Do despertar até setup(), não medido pelo firmware (ms)
+#define FIELD_BATTERY_MAH         2000   // Capacidade da bateria usada na previsão (mAh)
 
 // Debug
 #ifndef DEBUG_MODE
@@ -60,6 +145,38 @@
 // Intervalo em milissegundos para enviar os dados para a API
 #define API_SEND_INTERVAL 30000 // 30 segundos
 
+// Conexão persistente com a API (HTTP/1.1 keep-alive)
+#define API_KEEPALIVE_IDLE_TIMEOUT 45000 // Fecha conexões ociosas após este tempo (ms)
+#define API_CONNECT_TIMEOUT       5000   // Tempo máximo para abrir a conexão TCP (ms)
+#define API_RESPONSE_TIMEOUT      5000   // Tempo máximo de espera pela resposta (ms)
+#define API_DISCARD_RESPONSE_BODY true   // Descarta o corpo da resposta sem alocar
+
+// Fila e tarefa dedicadas ao envio (desacopladas da aquisição)
+#define UPLINK_QUEUE_LENGTH       16     // Capacidade da fila de amostras
+#define UPLINK_ALERT_QUEUE_LENGTH 8      // Alertas aguardando envio imediato (fora do spool)
+#define TASK_UPLINK_CORE          1      // Core para a tarefa de envio
+#define TASK_PRIORITY_UPLINK      1      // Prioridade da tarefa de envio
+#define TASK_STACK_SIZE_UPLINK    6144   // Pilha da tarefa de envio (HTTPClient)
+
+// Envio em lote: várias amostras por requisição
+#ifndef API_BATCH_MODE
+#define API_BATCH_MODE            true   // Agrupa amostras em um único POST
+#endif
+#define API_BATCH_DECIMATION      10     // Enfileira 1 a cada N leituras (10 x 200 ms = 2 s)
+#define API_BATCH_MAX_SAMPLES     32     // Máximo de amostras por lote
+#define API_BATCH_MAX_AGE         API_SEND_INTERVAL // Idade máxima da amostra mais antiga (ms)
+#define API_BATCH_PAYLOAD_SIZE    (128 + API_BATCH_MAX_SAMPLES * 24) // Buffer do payload (bytes)
+
+// Spool offline (store-and-forward): anel em RAM que transborda para a flash
+#define SPOOL_RAM_CAPACITY        64     // Amostras mantidas em RAM
+#define SPOOL_SPILL_CHUNK         32     // Amostras gravadas na flash por transbordo
+#define SPOOL_PARTITION_LABEL     "spiffs" // Partição de dados usada como log
+#define SPOOL_FLASH_SEGMENTS      32     // Setores de 4 KB usados (256 amostras cada)
+#define SPOOL_DRAIN_INTERVAL      500    // Intervalo mínimo entre lotes de drenagem (ms)
+#define SPOOL_RETRY_INTERVAL      5000   // Espera após falha de envio (ms)
+#define SPOOL_OFFLINE_POLL        1000   // Verificação da conexão com amostras pendentes (ms)
+#define SPOOL_NVS_NAMESPACE       "spool" // Namespace do contador de boots na NVS
+
 
 
 // ==========================================
@@ -97,6 +214,9 @@ enum class LogLevel {
 // Tamanho máximo de uma mensagem de log (bytes)
 #define LOG_MAX_MESSAGE_SIZE        256
 
+// Linha formatada de /logs; o escape JSON pode dobrar a mensagem (bytes)
+#define LOG_STREAM_LINE_SIZE        (LOG_MAX_MESSAGE_SIZE * 2 + 96)
+
 // Intervalo mínimo entre atualizações de telemetria (ms)
 #define TELEMETRY_UPDATE_INTERVAL   250
 
@@ -0,0 +1,122 @@
+/**
+ * @file CpuMonitor.h
+ * @brief Medição da carga de cada núcleo e do tempo de CPU por tarefa.
+ */
+
+#ifndef CPU_MONITOR_H
+#define CPU_MONITOR_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Config.h"
+
+/**
+ * Tempo de CPU de uma tarefa no último intervalo de amostragem.
+ */
+struct CpuTaskLoad {
+    char name[configMAX_TASK_NAME_LEN];  // Nome da tarefa
+    int8_t core;                         // Núcleo fixado (-1 = qualquer)
+    uint8_t load;                        // Percentual de um núcleo
+
+    CpuTaskLoad() : core(-1), load(0) {
+        name[0] = '\0';
+    }
+};
+
+/**
+ * Carga da CPU calculada a partir dos contadores de tempo de execução do
+ * FreeRTOS.
+ *
+ * A cada amostra compara o tempo acumulado das tarefas ociosas
+ * de cada núcleo com o tempo decorrido: carga = 100 - ocioso. O mesmo
+ * instantâneo fornece o tempo de cada tarefa. Requer
+ * configGENERATE_RUN_TIME_STATS e configUSE_TRACE_FACILITY; sem eles, a
+ * carga fica em 0 e isAvailable() retorna false.
+ *
+ * A amostragem roda na tarefa web; leituras de outras tarefas passam por
+ * uma seção crítica curta.
+ */
+class CpuMonitor {
+public:
+    /**
+     * @return Instância única.
+     */
+    static CpuMonitor &getInstance();
+
+    /**
+     * Amostra os contadores.
+     *
+     * Chamado pelo job da tarefa web a cada CPU_SAMPLE_INTERVAL; a carga
+     * publicada é a do intervalo desde a chamada anterior.
+     *
+     * @return true se uma nova amostra foi publicada.
+     */
+    bool update();
+
+    /**
+     * @return true se o FreeRTOS fornece contadores de tempo de execução.
+     */
+    bool isAvailable() const;
+
+    /**
+     * @return Carga do núcleo no último intervalo (%).
+     */
+    uint8_t getCoreLoad(uint8_t core) const;
+
+    /**
+     * @return Média da carga dos núcleos no último intervalo (%).
+     */
+    uint8_t getLoad() const;
+
+    /**
+     * Copia o histórico de carga de um núcleo, do mais antigo ao mais recente.
+     *
+     * @param core Núcleo.
+     * @param out Destino (CPU_LOAD_HISTORY posições bastam).
+     * @param maxCount Capacidade do destino.
+     * @return Número de amostras copiadas.
+     */
+    size_t getHistory(uint8_t core, uint8_t *out, size_t maxCount) const;
+
+    /**
+     * Copia o tempo de CPU das tarefas no último intervalo, em ordem decrescente.
+     *
+     * @param out Destino (CPU_MAX_TASKS posições bastam).
+     * @param maxCount Capacidade do destino.
+     * @return Número de tarefas copiadas.
+     */
+    size_t getTasks(CpuTaskLoad *out, size_t maxCount) const;
+
+private:
+    CpuMonitor();
+
+    /**
+     * Lê os contadores e publica carga, histórico e tarefas.
+     */
+    bool sample();
+
+    // Contador acumulado de cada tarefa na amostra anterior
+    struct TaskCounter {
+        TaskHandle_t handle;
+        uint32_t runTime;
+    };
+
+    uint32_t m_lastTotal;                           // Contador global na amostra anterior
+    TaskCounter m_counters[CPU_MAX_TASKS];          // Apenas a tarefa web acessa
+    size_t m_counterCount;
+    bool m_available;
+
+    // Resultados publicados
+    uint8_t m_coreLoad[portNUM_PROCESSORS];
+    uint8_t m_history[portNUM_PROCESSORS][CPU_LOAD_HISTORY];
+    size_t m_historyHead;                           // Próxima posição a escrever
+    size_t m_historyCount;
+    CpuTaskLoad m_tasks[CPU_MAX_TASKS];
+    size_t m_taskCount;
+    mutable portMUX_TYPE m_lock;
+
+    static CpuMonitor *s_instance;
+};
+
+#endif // CPU_MONITOR_H
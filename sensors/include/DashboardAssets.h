@@ -0,0 +1,227 @@
+/**
+ * @file DashboardAssets.h
+ * @brief Painel web minificado e comprimido (gzip).
+ *
+ * Gerado por scripts/pre_build.py a partir de web/index.html; não editar.
+ * Original: 12816 bytes, minificado: 9035 bytes,
+ * gzip: 3294 bytes.
+ */
+
+#ifndef DASHBOARD_ASSETS_H
+#define DASHBOARD_ASSETS_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_INDEX_ETAG      "\"7f468911c49804e4\""
+#define DASHBOARD_INDEX_GZ_LEN    3294
+
+static const uint8_t DASHBOARD_INDEX_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x1a, 0xdb, 0x72, 0xdb, 0xc6,
+    0xf5, 0x1d, 0x5f, 0xb1, 0x56, 0xec, 0x00, 0x88, 0x48, 0xf0, 0x22, 0x5b, 0x71, 0x29, 0x4a, 0xa9,
+    0x23, 0x4b, 0x8d, 0x32, 0x76, 0xec, 0xb1, 0xa4, 0x64, 0x3a, 0x1a, 0x4d, 0xbd, 0x04, 0x96, 0xe4,
+    0xc6, 0x00, 0x96, 0x83, 0x5d, 0x92, 0x52, 0x14, 0xfe, 0x46, 0xde, 0x33, 0x7d, 0xe8, 0x53, 0x66,
+    0x3a, 0xed, 0x43, 0x67, 0x3a, 0x7d, 0x8a, 0xfe, 0x24, 0x5f, 0xd2, 0x73, 0xce, 0x02, 0x20, 0x40,
+    0x52, 0x8a, 0xdc, 0x87, 0x8e, 0x35, 0x04, 0x76, 0xf7, 0xdc, 0x6f, 0x7b, 0x76, 0xe1, 0xfe, 0xa3,
+    0x97, 0x6f, 0x0e, 0xcf, 0xfe, 0xfc, 0xf6, 0x88, 0x8d, 0x4d, 0x12, 0x1f, 0x38, 0x7d, 0x7c, 0xb0,
+    0x98, 0xa7, 0xa3, 0xfd, 0xad, 0x89, 0x69, 0x0e, 0xb2, 0x2d, 0x9c, 0x13, 0x3c, 0x82, 0x47, 0x22,
+    0x0c, 0x67, 0xe1, 0x98, 0x67, 0x5a, 0x98, 0xfd, 0xad, 0xf3, 0xb3, 0xe3, 0xe6, 0xf3, 0xad, 0x62,
+    0x3a, 0xe5, 0x89, 0xd8, 0xdf, 0x9a, 0x49, 0x31, 0x9f, 0xa8, 0xcc, 0x6c, 0xb1, 0x50, 0xa5, 0x46,
+    0xa4, 0x00, 0x36, 0x97, 0x91, 0x19, 0xef, 0x47, 0x62, 0x26, 0x43, 0xd1, 0xa4, 0x41, 0x83, 0xc9,
+    0x54, 0x1a, 0xc9, 0xe3, 0xa6, 0x0e, 0x79, 0x2c, 0xf6, 0x3b, 0x41, 0x1b, 0xc9, 0x18, 0x69, 0x62,
+    0x71, 0x70, 0x2a, 0xb5, 0x11, 0x09, 0x67, 0x91, 0x60, 0xaf, 0x15, 0x80, 0xa9, 0x0c, 0x08, 0xa7,
+    0x46, 0xb1, 0xc3, 0x58, 0x26, 0xb7, 0x3f, 0x1b, 0x19, 0xaa, 0x7e, 0xcb, 0x82, 0x3a, 0x7d, 0x6d,
+    0xae, 0xf1, 0x39, 0x50, 0xd1, 0x35, 0xbb, 0x71, 0x86, 0xc0, 0xb2, 0x39, 0xe4, 0x89, 0x8c, 0xaf,
+    0x7b, 0xcc, 0x3d, 0x15, 0x23, 0x25, 0xd8, 0xf9, 0x89, 0xdb, 0x60, 0x67, 0x7c, 0xac, 0x12, 0xde,
+    0x60, 0x7f, 0x12, 0xa9, 0x98, 0xc1, 0xf3, 0x5b, 0x91, 0x45, 0x3c, 0x85, 0x17, 0xcd, 0x53, 0xdd,
+    0xd4, 0x22, 0x93, 0xc3, 0x3d, 0x27, 0xe1, 0xd9, 0x48, 0xa6, 0x3d, 0xd6, 0xde, 0x73, 0x26, 0x3c,
+    0x8a, 0x64, 0x3a, 0xea, 0xb1, 0x6e, 0x7b, 0x72, 0xb5, 0xe7, 0x0c, 0x78, 0xf8, 0x61, 0x94, 0xa9,
+    0x69, 0x1a, 0x35, 0x43, 0x15, 0xab, 0xac, 0xc7, 0x3e, 0x19, 0x3e, 0xc3, 0x7f, 0x7b, 0x4e, 0x31,
+    0xde, 0xd9, 0xd9, 0xd9, 0x73, 0x16, 0xce, 0xb8, 0x03, 0x62, 0x14, 0x73, 0xdd, 0x70, 0x47, 0x3c,
+    0x03, 0x6a, 0x46, 0x5c, 0x99, 0x26, 0x8f, 0xe5, 0x08, 0x88, 0x87, 0xa0, 0x8a, 0xc8, 0x0a, 0x66,
+    0xcd, 0x81, 0x32, 0x46, 0x25, 0x05, 0x9f, 0x85, 0x13, 0xa0, 0xd5, 0xb8, 0x4c, 0x45, 0x06, 0x74,
+    0x22, 0xa9, 0x27, 0x31, 0x07, 0x55, 0x86, 0xb1, 0x80, 0x55, 0xfc, 0x6d, 0xce, 0x33, 0x3e, 0xe9,
+    0x31, 0xfc, 0xdd, 0x73, 0x46, 0xf8, 0x6a, 0x31, 0xbf, 0x9f, 0x6a, 0x23, 0x87, 0xd7, 0xcd, 0xdc,
+    0xe8, 0x4b, 0x3e, 0x40, 0x72, 0xa0, 0xae, 0x80, 0xd8, 0xba, 0x0e, 0xf3, 0xb1, 0x34, 0x02, 0x94,
+    0x53, 0x59, 0x24, 0xb2, 0x66, 0xc6, 0x23, 0x39, 0xd5, 0x3d, 0xd6, 0x21, 0x7a, 0xab, 0x06, 0x50,
+    0x57, 0x4d, 0x3d, 0xe6, 0x91, 0x9a, 0x83, 0x79, 0xd8, 0xce, 0xe4, 0x8a, 0xc0, 0x58, 0x36, 0x1a,
+    0x70, 0xaf, 0xdd, 0x60, 0xf9, 0x5f, 0xd0, 0xf1, 0x41, 0x31, 0xd0, 0x8a, 0x9c, 0x8c, 0xb8, 0x84,
+    0x8c, 0x72, 0x03, 0x5d, 0x32, 0x4f, 0x17, 0x24, 0xc9, 0x55, 0x37, 0x6a, 0x42, 0xb6, 0x5e, 0xb1,
+    0x44, 0xe7, 0x19, 0xe1, 0xa0, 0x27, 0xb5, 0xfc, 0x41, 0xc0, 0x44, 0xd0, 0x15, 0x49, 0xc5, 0xd0,
+    0x4f, 0xff, 0xf0, 0x3c, 0x1a, 0x90, 0x62, 0x33, 0x1e, 0x4f, 0x45, 0xe1, 0x76, 0x0b, 0x4c, 0xa0,
+    0x34, 0x9e, 0x0b, 0x39, 0x1a, 0x83, 0x21, 0x06, 0x2a, 0x8e, 0xee, 0x73, 0x81, 0xd5, 0x18, 0x05,
+    0x01, 0x8a, 0x26, 0x13, 0x69, 0x04, 0x14, 0x37, 0x81, 0x17, 0x02, 0xec, 0xee, 0xee, 0x12, 0xac,
+    0x36, 0xdc, 0xe8, 0x3a, 0xf7, 0x0e, 0x72, 0x8f, 0xc1, 0x7b, 0xcd, 0x71, 0xce, 0xbd, 0x13, 0x58,
+    0xe0, 0x70, 0x32, 0x6d, 0x8e, 0x21, 0xb0, 0x55, 0x86, 0x71, 0x9a, 0xdb, 0xa7, 0xd3, 0x6e, 0x3f,
+    0xd9, 0x73, 0x0a, 0xd0, 0x5d, 0x32, 0x56, 0xd5, 0x38, 0x9d, 0x32, 0x28, 0x00, 0xdb, 0x70, 0xfd,
+    0x61, 0x85, 0x5d, 0x3b, 0x78, 0xfe, 0xac, 0x6a, 0x9a, 0x5c, 0xb2, 0x3f, 0x26, 0x22, 0x92, 0x9c,
+    0x79, 0x09, 0xbf, 0x2a, 0x3c, 0xf1, 0xf9, 0xee, 0xf3, 0xc9, 0x95, 0x0f, 0xd8, 0xb5, 0xf8, 0xa2,
+    0x80, 0x8a, 0x64, 0x26, 0x42, 0x23, 0x15, 0x6a, 0xaa, 0xe2, 0x69, 0x92, 0x56, 0x62, 0xa6, 0xe2,
+    0x4b, 0x3e, 0x35, 0x0a, 0x57, 0x16, 0x4e, 0xbf, 0x95, 0x27, 0x5d, 0xbf, 0x95, 0x57, 0x05, 0xcc,
+    0x3e, 0xac, 0x11, 0x9d, 0x87, 0xe5, 0x2e, 0xc0, 0x39, 0xfd, 0x48, 0xce, 0x58, 0x18, 0x73, 0xad,
+    0xf7, 0xb7, 0x4a, 0x91, 0xb6, 0xea, 0xf3, 0x20, 0x03, 0x95, 0x9e, 0xee, 0xc1, 0x99, 0x48, 0x26,
+    0x22, 0xe3, 0x66, 0x9a, 0x71, 0x40, 0xef, 0xd6, 0xc1, 0x28, 0x0a, 0xb6, 0x98, 0x8c, 0xf6, 0xb7,
+    0x4c, 0x09, 0x27, 0x9a, 0x76, 0xfa, 0xa0, 0x1d, 0xb4, 0x7f, 0xfd, 0xfb, 0x61, 0xbf, 0x05, 0x08,
+    0x75, 0x34, 0x72, 0xf5, 0x3a, 0x9a, 0x9d, 0x3e, 0x10, 0xda, 0xdc, 0xfe, 0x3c, 0x13, 0x71, 0x81,
+    0xb8, 0x8e, 0xbf, 0x94, 0xee, 0x3c, 0x91, 0x11, 0x07, 0x8d, 0x23, 0xc5, 0x5e, 0x64, 0xf7, 0xca,
+    0x37, 0x9e, 0x02, 0xa8, 0x34, 0xd7, 0x15, 0xe1, 0x9e, 0xdc, 0x2f, 0x5a, 0x89, 0x71, 0xbf, 0x5c,
+    0xeb, 0x34, 0x96, 0x46, 0x65, 0xe4, 0xae, 0xfd, 0xad, 0x6a, 0x64, 0x51, 0x56, 0x6f, 0x30, 0x77,
+    0x01, 0x5b, 0x0d, 0xd0, 0x5c, 0xcb, 0x23, 0x8c, 0xf7, 0xdb, 0x5f, 0xa0, 0xcc, 0x84, 0x5c, 0xa3,
+    0xae, 0xb9, 0xaf, 0xd7, 0x15, 0xa6, 0xc4, 0xc8, 0x89, 0x1f, 0xbc, 0x16, 0xc9, 0xed, 0x3f, 0x33,
+    0x08, 0xc7, 0x58, 0xce, 0x32, 0x88, 0xd9, 0xbe, 0x9e, 0xf0, 0x94, 0x54, 0x1b, 0x66, 0x42, 0x34,
+    0x13, 0x91, 0x40, 0x4a, 0x80, 0x25, 0x20, 0xaa, 0x60, 0xe1, 0x80, 0x0d, 0xae, 0x8d, 0xd0, 0x15,
+    0x7d, 0x0e, 0x8e, 0x33, 0x3e, 0xc2, 0x18, 0xe2, 0xb7, 0x7f, 0xbb, 0xfd, 0xab, 0xaa, 0x13, 0xc8,
+    0x57, 0x30, 0x7a, 0x97, 0x24, 0xaa, 0x16, 0xa5, 0xc8, 0x51, 0x0c, 0x20, 0x66, 0x35, 0xd4, 0xe9,
+    0xc4, 0xc8, 0x44, 0x2c, 0x71, 0xaa, 0x28, 0x10, 0xaa, 0x98, 0xf1, 0x1a, 0x37, 0x30, 0xc8, 0x0c,
+    0x28, 0x7a, 0xba, 0x8a, 0x1a, 0xd2, 0xb2, 0xde, 0x8c, 0xfb, 0x9d, 0x3c, 0x96, 0x55, 0xe0, 0xb9,
+    0x1c, 0xca, 0x26, 0xda, 0x63, 0x0a, 0x08, 0x2f, 0x85, 0x2e, 0x49, 0x6e, 0xe2, 0xfb, 0xf6, 0xbc,
+    0xc6, 0x07, 0x72, 0x3e, 0x56, 0x1c, 0x7c, 0xde, 0x5c, 0x01, 0xfe, 0xbf, 0xbb, 0xfe, 0x10, 0xd0,
+    0x21, 0xa7, 0x39, 0x03, 0x11, 0x73, 0x77, 0x87, 0x3c, 0x9d, 0x41, 0x18, 0x14, 0x1c, 0x97, 0xd5,
+    0x6d, 0xab, 0x14, 0xbe, 0x98, 0x00, 0xb9, 0x2d, 0xf4, 0x8a, 0x94, 0x45, 0x4d, 0x5b, 0x62, 0xd8,
+    0xe1, 0x1d, 0x7a, 0xea, 0x30, 0x93, 0x13, 0x73, 0x00, 0xc5, 0x2e, 0xd5, 0x86, 0x85, 0xd3, 0x0c,
+    0x12, 0xc2, 0x7c, 0x8b, 0x79, 0xa4, 0xd9, 0x3e, 0xd4, 0x2a, 0x77, 0x2d, 0xf9, 0x5d, 0xe8, 0x01,
+    0x6c, 0xfa, 0xbb, 0x0d, 0xc7, 0xad, 0xe7, 0x5e, 0xbe, 0xf6, 0x04, 0x57, 0xd6, 0xd2, 0x1f, 0x17,
+    0x8b, 0x44, 0xab, 0xa1, 0x6e, 0x5c, 0xad, 0xc4, 0x31, 0x51, 0xb5, 0x73, 0x95, 0xd0, 0xa4, 0x59,
+    0xe2, 0x64, 0xc3, 0xae, 0x84, 0xca, 0x43, 0xa9, 0x1c, 0x57, 0xa2, 0x05, 0xe7, 0xaa, 0xf1, 0x42,
+    0xe0, 0x79, 0x44, 0xe0, 0x5a, 0xb3, 0x98, 0x20, 0x9b, 0xe1, 0x8c, 0xeb, 0x2c, 0x60, 0xe7, 0x9b,
+    0xa6, 0x54, 0xcb, 0xd9, 0x74, 0x12, 0x71, 0x23, 0x8e, 0x62, 0x81, 0x52, 0x9c, 0x0c, 0x0f, 0xc7,
+    0xd0, 0xce, 0x89, 0xc8, 0x93, 0x51, 0x83, 0xa5, 0x62, 0x4e, 0x66, 0xf3, 0xa9, 0x53, 0x41, 0x63,
+    0x0a, 0x0b, 0x06, 0x66, 0x8c, 0x54, 0x38, 0xc5, 0xd7, 0x60, 0x24, 0x4c, 0x8e, 0xfc, 0xe5, 0xf5,
+    0x09, 0xe2, 0xc1, 0xce, 0x2e, 0x87, 0xcc, 0x7b, 0x94, 0xc3, 0xfa, 0x2c, 0x13, 0x60, 0xb0, 0x94,
+    0x0d, 0x79, 0xac, 0x85, 0x5d, 0xab, 0xf9, 0xe4, 0x42, 0x46, 0x97, 0xec, 0xd1, 0xfe, 0x7e, 0x8d,
+    0x5d, 0x8e, 0x1c, 0xe0, 0xf6, 0x7a, 0x68, 0x3b, 0x15, 0xb6, 0x84, 0x80, 0x8d, 0x6c, 0x8d, 0x42,
+    0x75, 0x35, 0xe7, 0x68, 0x32, 0x1c, 0x2c, 0x9c, 0xba, 0x00, 0x0b, 0x27, 0x16, 0x86, 0xcd, 0x31,
+    0x16, 0xd2, 0x69, 0x1c, 0xef, 0xd1, 0x70, 0xaa, 0xc5, 0xd7, 0x1a, 0xac, 0x41, 0x54, 0xd8, 0xf9,
+    0xbb, 0x57, 0xa7, 0x82, 0x67, 0xe1, 0xf8, 0x2d, 0x87, 0x6d, 0x49, 0x7b, 0x73, 0x99, 0x42, 0x43,
+    0x13, 0xc4, 0x2a, 0x24, 0x37, 0x05, 0x9a, 0x16, 0xfd, 0x60, 0xcc, 0xb5, 0xe7, 0x7e, 0x0f, 0x78,
+    0xae, 0x6f, 0xc9, 0xc0, 0x06, 0xa9, 0x52, 0x74, 0xc4, 0x09, 0x76, 0x02, 0x10, 0x3f, 0x40, 0x10,
+    0xf2, 0xa3, 0xbd, 0xb2, 0xfa, 0xc2, 0x60, 0x24, 0x19, 0x14, 0xa1, 0xbd, 0x97, 0x9b, 0x16, 0xf6,
+    0xe0, 0x77, 0x1b, 0xd6, 0x3b, 0xed, 0x8a, 0xaf, 0xf2, 0xe5, 0xef, 0xc4, 0xe0, 0x54, 0x85, 0x1f,
+    0x84, 0xf1, 0xd0, 0x54, 0x68, 0xd0, 0xb9, 0xf6, 0x41, 0xa3, 0x20, 0x8c, 0x95, 0x16, 0x9e, 0x5f,
+    0x90, 0x9c, 0x64, 0xca, 0x28, 0xd8, 0xaa, 0x81, 0xcc, 0xaa, 0x06, 0xcb, 0x25, 0x30, 0xbc, 0x3b,
+    0x36, 0x66, 0xa2, 0x7b, 0x2e, 0xfb, 0x82, 0xb9, 0x73, 0x8d, 0x2f, 0x3d, 0x7c, 0xe9, 0xb9, 0x05,
+    0xa1, 0xb9, 0x3e, 0xcf, 0x90, 0xca, 0xfb, 0xc7, 0x37, 0x05, 0xe2, 0xa2, 0xd5, 0x7a, 0x7c, 0xb3,
+    0x4a, 0x75, 0xac, 0xb4, 0x59, 0x3c, 0xbe, 0x29, 0x8c, 0x09, 0xe4, 0x5a, 0x73, 0x4d, 0xd4, 0xe0,
+    0xd9, 0x1a, 0xc8, 0xd4, 0x5d, 0xbc, 0xb7, 0xa6, 0x50, 0x13, 0xe8, 0xaf, 0x23, 0x20, 0x99, 0x3b,
+    0xc5, 0xba, 0x03, 0x4c, 0xbf, 0xd4, 0x8d, 0x98, 0xfa, 0xb8, 0x14, 0x00, 0x26, 0xcf, 0xae, 0xcf,
+    0xae, 0x27, 0x02, 0xa0, 0x5c, 0x9e, 0x65, 0xfc, 0x7a, 0x30, 0x1d, 0x0e, 0x45, 0xe6, 0xd2, 0xb2,
+    0x4a, 0x91, 0x1c, 0x12, 0x2b, 0x0c, 0xe5, 0x15, 0x21, 0xab, 0x62, 0x01, 0xe2, 0x8d, 0x3c, 0xb7,
+    0xa4, 0xbb, 0x2c, 0xd6, 0xe8, 0xb4, 0x52, 0x0e, 0x1b, 0x2b, 0x77, 0xfb, 0xef, 0x5e, 0xdf, 0x4d,
+    0x28, 0x4c, 0x3e, 0x2e, 0x78, 0x6c, 0x26, 0x58, 0x4c, 0x1b, 0x48, 0x50, 0x58, 0x84, 0xeb, 0xb3,
+    0x1f, 0x7f, 0x64, 0xd5, 0x59, 0x28, 0xc5, 0x32, 0xd4, 0xae, 0x8f, 0x1a, 0x81, 0xae, 0x1a, 0xea,
+    0x8a, 0xf7, 0xf5, 0xe9, 0x9b, 0x6f, 0xa0, 0xab, 0xcc, 0xa0, 0xef, 0x86, 0x56, 0xde, 0xbb, 0x71,
+    0x78, 0xde, 0x97, 0xb9, 0x7a, 0x3a, 0xc0, 0xf2, 0x37, 0x10, 0x90, 0xf5, 0x16, 0xb3, 0x57, 0x32,
+    0x81, 0x4c, 0x5d, 0x92, 0x43, 0x36, 0x2e, 0x10, 0xd3, 0x2a, 0xd3, 0x0d, 0xda, 0x87, 0x1b, 0x58,
+    0x54, 0x5c, 0x3f, 0x80, 0x93, 0x84, 0x04, 0xc0, 0x86, 0xeb, 0x37, 0x1c, 0x14, 0xa9, 0x87, 0xe2,
+    0x68, 0x71, 0x0c, 0x05, 0xc5, 0xd4, 0x48, 0x59, 0x79, 0x89, 0x52, 0xa7, 0xed, 0x2c, 0x7c, 0x9f,
+    0xba, 0xbe, 0xdc, 0x23, 0x89, 0xd0, 0x9a, 0x8f, 0x44, 0xcd, 0x29, 0x62, 0x46, 0xf5, 0x00, 0x9a,
+    0x66, 0xea, 0x6d, 0xad, 0xed, 0xa0, 0xfa, 0x70, 0x80, 0xa2, 0xb5, 0x80, 0x06, 0x12, 0xa6, 0x79,
+    0x1a, 0x0a, 0x35, 0x84, 0x2e, 0x09, 0x5c, 0xfd, 0x25, 0xb9, 0xda, 0xf9, 0x02, 0x7a, 0xc5, 0x50,
+    0x45, 0xe2, 0x18, 0x3b, 0x45, 0x6f, 0x09, 0xef, 0x3b, 0x3d, 0x46, 0x06, 0x21, 0x31, 0xab, 0x0b,
+    0xd6, 0xc4, 0x44, 0xf3, 0xd3, 0x4f, 0x89, 0x51, 0x60, 0x28, 0x86, 0x30, 0xe6, 0x21, 0x2a, 0x5c,
+    0x94, 0x85, 0xa6, 0x61, 0xa0, 0x83, 0xa1, 0xca, 0x8e, 0x78, 0x38, 0xf6, 0x00, 0xe0, 0x80, 0x55,
+    0x83, 0xe7, 0xfd, 0xc5, 0xe3, 0x1b, 0x78, 0x03, 0xca, 0xf1, 0xe2, 0x92, 0xde, 0x13, 0x15, 0x4d,
+    0x63, 0xb1, 0xb8, 0x64, 0x34, 0xd0, 0xa3, 0xc5, 0x7b, 0xd2, 0x1e, 0xea, 0xa3, 0x16, 0xec, 0x1e,
+    0xa6, 0x70, 0x84, 0xcd, 0x8c, 0x5b, 0x0d, 0xce, 0x39, 0xcf, 0x52, 0xef, 0xfd, 0x8b, 0x57, 0x47,
+    0xef, 0xce, 0x5e, 0x30, 0xa0, 0x4d, 0x08, 0x15, 0xf2, 0x76, 0x4c, 0x1c, 0xd6, 0x18, 0x20, 0x1d,
+    0x5b, 0xbe, 0xcf, 0x4f, 0xbc, 0x5c, 0x63, 0xf0, 0x00, 0x83, 0x40, 0x0b, 0xc7, 0x60, 0xee, 0x2a,
+    0x1f, 0x91, 0x65, 0x2a, 0xf3, 0xdc, 0x23, 0x78, 0x30, 0x0e, 0x7f, 0x29, 0x9c, 0x59, 0x34, 0xcf,
+    0x40, 0x40, 0xec, 0x5a, 0xe0, 0xe0, 0x2b, 0x6a, 0xee, 0xa3, 0x4a, 0xf2, 0xd0, 0x8c, 0x8a, 0xaa,
+    0xdb, 0x4f, 0x51, 0xfe, 0xf3, 0xcc, 0x02, 0x1b, 0x3c, 0xca, 0xeb, 0x81, 0x5f, 0xa9, 0xb2, 0x36,
+    0xdd, 0x10, 0x70, 0x3d, 0xb1, 0xfa, 0x1b, 0x6b, 0x21, 0xf2, 0xd7, 0xc2, 0x9c, 0xc1, 0xb6, 0xa8,
+    0xa6, 0xc6, 0x03, 0x79, 0xc0, 0x4b, 0x37, 0xeb, 0x79, 0xb9, 0xbd, 0xbd, 0x29, 0x8d, 0x3f, 0x83,
+    0x3c, 0x0e, 0xe8, 0x10, 0xbe, 0x5a, 0x41, 0x41, 0xeb, 0xc6, 0x7a, 0xdd, 0xae, 0x19, 0x83, 0x6c,
+    0x57, 0x8f, 0x64, 0x9c, 0xb9, 0xcb, 0xbc, 0x25, 0x71, 0x32, 0x2b, 0x41, 0x12, 0xa1, 0xb2, 0x3a,
+    0x2f, 0x90, 0xb8, 0x8d, 0xfe, 0xe3, 0x77, 0x2f, 0x5e, 0x1f, 0xfd, 0xe5, 0xf8, 0xe4, 0xe8, 0xd5,
+    0xcb, 0x53, 0xe0, 0x70, 0xe1, 0x5c, 0xb8, 0x94, 0x8c, 0x80, 0x59, 0x6e, 0xfa, 0x0d, 0xd6, 0x6d,
+    0x30, 0x6f, 0xd6, 0x60, 0x8a, 0x74, 0x9e, 0x61, 0xf6, 0x9d, 0xcb, 0xd4, 0x74, 0x76, 0x3d, 0xd5,
+    0x20, 0x4b, 0xfa, 0x97, 0x0d, 0x44, 0xb4, 0xd9, 0x8c, 0xa8, 0xd8, 0x3c, 0x00, 0x9d, 0x64, 0x02,
+    0x83, 0xa7, 0x1b, 0x91, 0x77, 0xba, 0x77, 0x22, 0x67, 0x70, 0x56, 0x3b, 0x84, 0xe3, 0xbf, 0xf9,
+    0x5f, 0x90, 0x2b, 0x2d, 0xd2, 0x46, 0xc1, 0x4f, 0x6a, 0x72, 0xb3, 0x16, 0x96, 0xd7, 0x55, 0x1a,
+    0x45, 0x17, 0xf5, 0x10, 0xcd, 0xab, 0x14, 0x0a, 0xc3, 0x61, 0x9f, 0xf5, 0x95, 0xe0, 0x1f, 0xa1,
+    0x7c, 0x81, 0x99, 0xb7, 0x5d, 0x1f, 0x8d, 0x27, 0x27, 0x2f, 0xa2, 0x28, 0x83, 0x92, 0xb7, 0x8a,
+    0x7a, 0xd1, 0x6e, 0xb0, 0x0e, 0xa9, 0xb1, 0x73, 0x19, 0x24, 0x7c, 0xe2, 0xc9, 0x1a, 0xc1, 0xe7,
+    0x9e, 0x62, 0xdb, 0x4c, 0xfa, 0x7e, 0xf0, 0xbd, 0x92, 0xa9, 0xe7, 0x06, 0xae, 0xbf, 0xaa, 0x4a,
+    0xb5, 0x3d, 0x24, 0x5a, 0x1b, 0xe4, 0x02, 0x32, 0x2b, 0x78, 0x54, 0xcb, 0x37, 0x81, 0x9f, 0x58,
+    0x68, 0xe0, 0xea, 0xb2, 0xe8, 0xcb, 0xc4, 0xad, 0xa3, 0x41, 0x9f, 0xb8, 0x6a, 0xf4, 0x8b, 0x1a,
+    0x97, 0xc6, 0xaa, 0xec, 0x1d, 0xff, 0x72, 0x2d, 0x04, 0xa8, 0xf7, 0x6d, 0xb0, 0xe7, 0x55, 0x32,
+    0x1e, 0x5e, 0x95, 0x94, 0xa1, 0xd1, 0xcb, 0xc9, 0x6e, 0x8a, 0x86, 0x46, 0xdd, 0xcf, 0xc0, 0xe3,
+    0xe9, 0xaa, 0xaf, 0x8b, 0x00, 0x59, 0x21, 0x03, 0xa0, 0xdd, 0xdf, 0x21, 0xb5, 0x5b, 0x27, 0x05,
+    0xbb, 0xd6, 0xa5, 0x73, 0x59, 0xe9, 0xb0, 0xaa, 0x5b, 0x8c, 0x6d, 0x31, 0x96, 0xcd, 0x2f, 0x5e,
+    0x58, 0xe6, 0x7b, 0xfc, 0x4b, 0x28, 0xb6, 0xdf, 0xc2, 0xb0, 0x80, 0xb1, 0xa5, 0x0c, 0x01, 0x02,
+    0x3c, 0x96, 0xbe, 0x12, 0xe9, 0xc8, 0x8c, 0xa1, 0x90, 0x75, 0x71, 0x73, 0xa4, 0xe9, 0xd2, 0x68,
+    0x6d, 0x9f, 0x9a, 0xdd, 0x9d, 0xb2, 0x2f, 0x5e, 0x36, 0xa1, 0x09, 0x74, 0xe8, 0x60, 0xaf, 0xe1,
+    0x10, 0xea, 0x5c, 0x85, 0x62, 0x89, 0xda, 0xf1, 0x69, 0x17, 0xe9, 0xf8, 0x74, 0x35, 0xa6, 0x3f,
+    0x60, 0x0b, 0x72, 0x75, 0x7c, 0x7c, 0x0c, 0x6d, 0x0c, 0xe1, 0xc0, 0xb8, 0x5b, 0xdb, 0x24, 0x36,
+    0xa2, 0x77, 0xb1, 0x26, 0xaf, 0x8a, 0x7a, 0xb0, 0xcf, 0x9e, 0x56, 0xc8, 0x56, 0x11, 0xc1, 0x72,
+    0x85, 0x55, 0x2b, 0x8c, 0x9e, 0x96, 0x8c, 0x6e, 0x9c, 0x9a, 0x22, 0x8b, 0xfa, 0xbe, 0x7e, 0xc3,
+    0xf2, 0xc8, 0xe8, 0xb1, 0x1b, 0x28, 0xb4, 0x14, 0x69, 0xf8, 0xca, 0xf0, 0x0c, 0x02, 0x55, 0xd5,
+    0x43, 0xc5, 0x25, 0x35, 0x53, 0xf0, 0xe8, 0xd7, 0x0a, 0x22, 0x6c, 0xb9, 0x28, 0x1c, 0x2c, 0x6c,
+    0x6f, 0x17, 0x9d, 0xee, 0x23, 0x8f, 0x44, 0xfc, 0x94, 0x79, 0x1d, 0xd6, 0xef, 0x63, 0xea, 0xf8,
+    0x74, 0x7f, 0x2c, 0x53, 0x3a, 0x16, 0x10, 0xeb, 0x0b, 0xbc, 0xbd, 0x9c, 0x34, 0xe8, 0x9e, 0x19,
+    0x58, 0xca, 0x1f, 0x04, 0x56, 0x78, 0x4e, 0x87, 0x84, 0x2a, 0xfd, 0x0b, 0x79, 0x69, 0xcd, 0x9c,
+    0x6b, 0xb5, 0x4d, 0xb0, 0xec, 0x60, 0xd5, 0x3a, 0x2b, 0xae, 0x42, 0xcd, 0x2c, 0x8b, 0xcb, 0x0b,
+    0x64, 0x81, 0x64, 0x91, 0x3c, 0x99, 0xbb, 0xf0, 0xdf, 0xd2, 0x56, 0xdb, 0xfb, 0x44, 0xb6, 0x72,
+    0x10, 0x41, 0x02, 0x38, 0x2c, 0xa3, 0x0e, 0x0c, 0x91, 0x70, 0x73, 0x86, 0x79, 0xe3, 0x51, 0xf6,
+    0x34, 0xd8, 0x34, 0x95, 0x66, 0x19, 0x7a, 0x17, 0xd8, 0x6b, 0xa1, 0x2a, 0xa3, 0x84, 0x5f, 0xd2,
+    0xf6, 0x09, 0x40, 0x56, 0xf6, 0xd7, 0xdc, 0x8c, 0x03, 0x3e, 0xd0, 0x1e, 0x82, 0xf8, 0xac, 0x8f,
+    0x0e, 0xfe, 0xcc, 0x42, 0x96, 0x72, 0x2f, 0x4f, 0xa1, 0xe5, 0xd9, 0x88, 0xc0, 0x41, 0xd5, 0x36,
+    0x76, 0xe9, 0xbf, 0xfd, 0xf4, 0x0f, 0xb6, 0x4d, 0x7d, 0xfa, 0x6f, 0x3f, 0xfd, 0x87, 0xb9, 0x58,
+    0x1d, 0x70, 0x39, 0x30, 0xea, 0x58, 0x5e, 0xc1, 0x61, 0xb0, 0x6b, 0xeb, 0x85, 0x0b, 0xbf, 0x28,
+    0x17, 0x0e, 0x5a, 0x09, 0x74, 0xf3, 0x35, 0x25, 0xea, 0x9d, 0x48, 0xee, 0x2e, 0x6a, 0x5f, 0xf2,
+    0x08, 0x28, 0xe6, 0xb0, 0x1d, 0x82, 0xde, 0xae, 0xba, 0x14, 0x54, 0x6a, 0x83, 0xed, 0x94, 0xd2,
+    0x69, 0x32, 0x80, 0xfe, 0x7e, 0xd9, 0xe2, 0xac, 0x9d, 0x50, 0x37, 0x1c, 0xe3, 0x1b, 0x77, 0x12,
+    0x2d, 0x55, 0xe9, 0x90, 0x2a, 0x78, 0xd2, 0xa7, 0x2d, 0xfe, 0x2e, 0x79, 0x8a, 0x0a, 0xf3, 0x60,
+    0x61, 0x56, 0x2e, 0x0d, 0x1a, 0x9b, 0xc9, 0xad, 0x88, 0xf1, 0x64, 0x29, 0x44, 0x5d, 0x70, 0x74,
+    0xef, 0x43, 0x55, 0x2f, 0xca, 0x6d, 0x35, 0x88, 0xd6, 0xa9, 0x55, 0x8d, 0xd1, 0xc8, 0x0d, 0x00,
+    0xcc, 0x7f, 0x57, 0x9d, 0x07, 0x52, 0x2f, 0xe0, 0x1b, 0xa4, 0x94, 0xed, 0x9e, 0x2a, 0x7a, 0x61,
+    0xd6, 0xd7, 0x43, 0x02, 0x67, 0x82, 0x62, 0xa3, 0xa6, 0x8a, 0x38, 0x4d, 0x23, 0x31, 0x94, 0xd0,
+    0x33, 0xde, 0xa7, 0x78, 0xf5, 0x0a, 0xa5, 0xb0, 0x71, 0x8d, 0x14, 0x58, 0xf8, 0x94, 0x0e, 0x46,
+    0x9e, 0xbf, 0x62, 0xdb, 0x1c, 0xac, 0xb2, 0x9f, 0x7e, 0x0c, 0xdb, 0xfa, 0x36, 0x7c, 0x27, 0xc5,
+    0x4d, 0x4e, 0x25, 0x30, 0xdb, 0x59, 0xac, 0x73, 0xb4, 0xf9, 0x9d, 0xaf, 0xee, 0xb3, 0x35, 0x8c,
+    0xbd, 0xb2, 0x9c, 0x5e, 0xe3, 0x01, 0x93, 0xb2, 0x7d, 0x18, 0x2b, 0x68, 0x36, 0x73, 0x9c, 0x16,
+    0x7b, 0xbe, 0xfb, 0xb4, 0xdd, 0x2e, 0x0f, 0xfd, 0x63, 0x35, 0xcd, 0x56, 0x20, 0x0b, 0xd0, 0x27,
+    0x39, 0x28, 0xe0, 0xec, 0xec, 0x56, 0x50, 0x20, 0x95, 0xa7, 0x46, 0xdc, 0x89, 0x44, 0xb0, 0x80,
+    0xb3, 0xbb, 0xc4, 0xd0, 0xd8, 0x2f, 0x47, 0x88, 0x51, 0x42, 0xed, 0x96, 0xa7, 0x61, 0x1b, 0x2a,
+    0x06, 0x8f, 0xd5, 0x8e, 0x47, 0x72, 0xdb, 0x32, 0x43, 0xaf, 0x60, 0xa0, 0x88, 0x51, 0xa9, 0xc1,
+    0x32, 0xe3, 0x78, 0x56, 0x5c, 0x0b, 0x60, 0xdf, 0x01, 0x62, 0x5c, 0x85, 0x28, 0xa4, 0xb3, 0x30,
+    0xc5, 0x08, 0xa0, 0x92, 0x0a, 0x54, 0x21, 0x10, 0x4c, 0x6b, 0xf7, 0xee, 0xb0, 0x2e, 0xfb, 0xbb,
+    0x52, 0xc6, 0x4d, 0xbe, 0xca, 0x1b, 0xef, 0x87, 0x87, 0xc7, 0xb2, 0x53, 0x5f, 0xa7, 0xf2, 0x3b,
+    0x01, 0x89, 0x8d, 0xda, 0xc3, 0x19, 0x55, 0xef, 0xfd, 0x6a, 0xcc, 0x70, 0x61, 0xa3, 0x2a, 0x93,
+    0xe9, 0x47, 0xa8, 0x51, 0x5c, 0x1b, 0xd6, 0xf5, 0x98, 0x4c, 0xa9, 0x73, 0xc5, 0x5e, 0x4e, 0x52,
+    0x2f, 0xf7, 0x3e, 0xbd, 0xfd, 0x77, 0x18, 0x0b, 0x05, 0xc7, 0x53, 0xb9, 0xe8, 0xc1, 0xef, 0x6c,
+    0xf1, 0xe4, 0x7d, 0xd1, 0xc2, 0xb2, 0x1f, 0x59, 0x59, 0x00, 0xd6, 0x76, 0x87, 0xc3, 0xc9, 0xd4,
+    0x03, 0x7a, 0xcb, 0xc0, 0xcf, 0x6f, 0x87, 0xef, 0xbe, 0x4f, 0x74, 0x2b, 0x17, 0xc4, 0x6e, 0x19,
+    0x7f, 0xa1, 0xb9, 0x02, 0x1c, 0x8b, 0x8c, 0x18, 0x74, 0x45, 0x78, 0x65, 0x3c, 0xb7, 0x1b, 0x11,
+    0x90, 0x5d, 0xa0, 0x0b, 0xea, 0x25, 0x9c, 0x75, 0xc8, 0x77, 0x38, 0x59, 0x82, 0xd8, 0x4f, 0x6a,
+    0xab, 0x30, 0x5f, 0xd1, 0x2c, 0x00, 0x99, 0x2b, 0x98, 0x11, 0x3c, 0x83, 0xd3, 0xa8, 0xc9, 0x3f,
+    0x5f, 0x56, 0x69, 0x97, 0x23, 0x4b, 0x06, 0x38, 0x5f, 0xb8, 0xf9, 0x67, 0x47, 0x6c, 0x84, 0x3f,
+    0x11, 0xbb, 0x9f, 0x8b, 0x6e, 0xd7, 0xbd, 0x2c, 0xaf, 0x16, 0x3c, 0xfa, 0x00, 0x07, 0x68, 0x2a,
+    0x13, 0xf9, 0x01, 0x36, 0x4f, 0x28, 0x38, 0xab, 0xc5, 0x94, 0x82, 0x68, 0xee, 0x5c, 0xdf, 0x0b,
+    0x04, 0xbb, 0xc4, 0x16, 0xf2, 0x22, 0x6f, 0x54, 0x72, 0xb0, 0xbc, 0x31, 0xc2, 0x06, 0xb3, 0xd8,
+    0xe3, 0xcb, 0xcc, 0x34, 0x62, 0xb2, 0x54, 0xc7, 0x5a, 0xa0, 0xb5, 0x86, 0xd8, 0x64, 0xf8, 0x01,
+    0x16, 0xd5, 0xd3, 0x26, 0x53, 0x1f, 0xc4, 0x29, 0xde, 0xe8, 0x23, 0x1a, 0x8a, 0x67, 0x17, 0x06,
+    0x62, 0x24, 0xd3, 0xb7, 0x50, 0x0f, 0xf0, 0xc4, 0x5a, 0xa0, 0x97, 0x7a, 0x60, 0x98, 0x14, 0xe1,
+    0x50, 0xe8, 0x70, 0xbd, 0xe4, 0x9b, 0x9b, 0xb5, 0xc9, 0x10, 0xce, 0xf6, 0xda, 0xd0, 0x94, 0xd4,
+    0x16, 0xad, 0x42, 0x92, 0x36, 0x58, 0x28, 0x2f, 0xc8, 0x32, 0x51, 0x33, 0x71, 0xa6, 0xd0, 0xce,
+    0xd7, 0xfe, 0x9e, 0x6d, 0x2e, 0x71, 0x1a, 0x3f, 0x93, 0xc2, 0xb4, 0xc4, 0xb6, 0x06, 0xb4, 0xa3,
+    0x55, 0x68, 0xdc, 0xab, 0xf2, 0x7b, 0xf9, 0xcc, 0x7d, 0x91, 0x6d, 0xef, 0xbf, 0x1b, 0x64, 0x60,
+    0x3e, 0xe3, 0x32, 0xe6, 0x83, 0x58, 0x38, 0x5f, 0xd0, 0x98, 0xd6, 0x02, 0x1d, 0xcb, 0x50, 0x20,
+    0xfb, 0x67, 0x3e, 0x45, 0xbc, 0xa1, 0x60, 0x7f, 0x7c, 0x63, 0x02, 0x6c, 0xf3, 0x16, 0x0c, 0xdf,
+    0x50, 0xa1, 0x6a, 0xb4, 0xff, 0xfa, 0x2f, 0x08, 0x77, 0x07, 0xca, 0x10, 0x86, 0x20, 0x8f, 0xc0,
+    0x61, 0x1a, 0xbf, 0x69, 0x1a, 0xfa, 0x9a, 0x04, 0x2f, 0xe2, 0x4a, 0x84, 0x53, 0xfa, 0x20, 0xc5,
+    0x64, 0x8a, 0x9f, 0xe9, 0x55, 0x7a, 0xfb, 0xcb, 0x4c, 0x48, 0x6d, 0x77, 0x89, 0x32, 0xec, 0x79,
+    0x14, 0x1d, 0xe1, 0xcd, 0xd5, 0x2b, 0xfc, 0x56, 0x96, 0x8a, 0xcc, 0x73, 0x5f, 0xbe, 0x79, 0x9d,
+    0xdf, 0x7c, 0xbf, 0x02, 0x9e, 0x82, 0x36, 0xe1, 0xd5, 0xdb, 0x98, 0xb5, 0xbb, 0x8c, 0xfc, 0x3e,
+    0x52, 0xc5, 0x31, 0xa4, 0x1a, 0xf8, 0xc3, 0x5e, 0x93, 0x0c, 0x85, 0x01, 0xa7, 0xb9, 0x2d, 0x3c,
+    0xde, 0xf9, 0x4e, 0x60, 0xc6, 0x22, 0xf5, 0x40, 0x50, 0x90, 0x45, 0xd3, 0x65, 0x57, 0xf1, 0x1e,
+    0xe0, 0x5d, 0x36, 0xd4, 0xa9, 0x1c, 0xa4, 0xcc, 0x59, 0x98, 0xa0, 0x3b, 0x25, 0x2f, 0xbf, 0x09,
+    0x59, 0x5e, 0x8f, 0x55, 0xef, 0x3d, 0x52, 0xce, 0x5e, 0xbc, 0x3d, 0x41, 0xa5, 0xf1, 0x03, 0x55,
+    0x79, 0xf7, 0x01, 0x52, 0xe5, 0xf2, 0x50, 0x24, 0x89, 0xf2, 0x8e, 0xc5, 0xcb, 0xa7, 0xc1, 0xde,
+    0x6d, 0xda, 0x8d, 0xaa, 0x6b, 0x75, 0x55, 0xa9, 0xf3, 0x9f, 0x6b, 0x4c, 0x85, 0xb9, 0x0e, 0xb0,
+    0xd9, 0xbe, 0x3e, 0x35, 0xd8, 0xc0, 0x62, 0x6d, 0x2b, 0x0d, 0x10, 0xbc, 0x79, 0x7b, 0xf4, 0x0d,
+    0x82, 0x17, 0xfa, 0x62, 0x15, 0xfb, 0x78, 0x85, 0xcf, 0x4f, 0x3e, 0x46, 0xdf, 0x9a, 0xa2, 0x0b,
+    0xbc, 0x4c, 0xea, 0x5a, 0x6d, 0x30, 0x1e, 0xfb, 0xad, 0xe2, 0x63, 0x54, 0xbf, 0x95, 0x7f, 0xfb,
+    0x6e, 0xd1, 0xff, 0x9d, 0xf9, 0x2f, 0x4b, 0x05, 0x99, 0x54, 0x4b, 0x23, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_ASSETS_H
@@ -29,10 +29,16 @@ struct SensorRawData {
 struct SensorData {
     float temperature;       // Temperatura em graus Celsius
     float humidityPercent;   // Umidade relativa do ar em percentual (0-100%)
+    float temperatureRate;   // Tendência da temperatura (°C/min)
+    float temperatureRateSigma; // Desvio-padrão da tendência da temperatura (°C/min)
+    float humidityRate;      // Tendência da umidade (%/min)
+    float humidityRateSigma; // Desvio-padrão da tendência da umidade (%/min)
     uint32_t timestamp;      // Timestamp da leitura
 
     // Construtor com valores padrão
-    SensorData() : temperature(0.0f), humidityPercent(0.0f), timestamp(0) {}
+    SensorData() : temperature(0.0f), humidityPercent(0.0f), temperatureRate(0.0f),
+                   temperatureRateSigma(0.0f), humidityRate(0.0f), humidityRateSigma(0.0f),
+                   timestamp(0) {}
 
     /**
      * Converte dados brutos para formato físico.
@@ -41,11 +47,9 @@ struct SensorData {
      * @return Referência para o próprio objeto.
      */
     SensorData &fromRaw(const SensorRawData &raw) {
-        // Temperatura e umidade já vêm em unidades físicas do DHT22
-        // Aplica uma correção para a temperatura (valor real do DHT22)
+        // Temperatura e umidade já vêm em unidades físicas do DHT22,
+        // filtradas e calibradas pelas cadeias do SensorManager
         temperature = raw.temperatureRaw;
-
-        // A umidade já está correta, não precisa de ajuste
         humidityPercent = raw.humidityRaw;
 
         // Mantém o timestamp
@@ -65,8 +69,10 @@ struct SensorData {
         if (!buffer || size == 0) return false;
 
         int written = snprintf(buffer, size,
-            "{\"temperature\":%.1f,\"humidity\":%.1f,\"timestamp\":%u}",
+            "{\"temperature\":%.1f,\"humidity\":%.1f,"
+            "\"trend\":{\"temperature\":[%.2f,%.2f],\"humidity\":[%.2f,%.2f]},\"timestamp\":%u}",
             temperature, humidityPercent,
+            temperatureRate, temperatureRateSigma, humidityRate, humidityRateSigma,
             timestamp);
 
         return (written > 0 && written < static_cast<int>(size));
@@ -0,0 +1,66 @@
+/**
+ * @file Dht22Decoder.h
+ * @brief Decodificação de quadros do DHT22 a partir dos tempos dos pulsos.
+ *
+ * Não depende do Arduino nem do driver RMT, para que o benchmark em
+ * bench/dht22_bench.cpp reproduza no host pulsos capturados no barramento.
+ */
+
+#ifndef DHT22_DECODER_H
+#define DHT22_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Decodificador puro do protocolo de um fio do DHT22.
+ */
+class Dht22Decoder {
+public:
+    /**
+     * @enum Status
+     * @brief Resultado de uma aquisição.
+     */
+    enum class Status : uint8_t {
+        NONE,           ///< Nenhuma aquisição concluída ainda
+        OK,             ///< Quadro válido decodificado
+        NO_RESPONSE,    ///< Sensor não respondeu ao pulso de início
+        FRAME_ERROR,    ///< Quadro incompleto ou com tempos inválidos
+        CHECKSUM_ERROR  ///< Soma de verificação não confere
+    };
+
+    /**
+     * Pulso capturado no barramento (nível e duração em μs).
+     */
+    struct Pulse {
+        uint8_t level;
+        uint16_t durationUs;
+    };
+
+    /**
+     * Decodifica um quadro do DHT22 a partir dos pulsos capturados.
+     *
+     * @param pulses Sequência de pulsos do barramento.
+     * @param count Número de pulsos.
+     * @param temperature Temperatura decodificada (°C), alterada só se OK.
+     * @param humidity Umidade decodificada (%), alterada só se OK.
+     * @return Estado da decodificação.
+     */
+    static Status decode(const Pulse *pulses, size_t count,
+                         float &temperature, float &humidity);
+
+    /**
+     * Converte um estado em texto para logs.
+     *
+     * @param status Estado a ser convertido.
+     * @return Descrição curta do estado.
+     */
+    static const char *statusToString(Status status);
+
+private:
+    // Resposta do sensor (~80 μs em cada nível)
+    static constexpr uint16_t RESPONSE_MIN_US = 65;
+    static constexpr uint16_t RESPONSE_MAX_US = 120;
+};
+
+#endif // DHT22_DECODER_H
@@ -0,0 +1,161 @@
+/**
+ * @file Dht22Reader.h
+ * @brief Máquina de estados não bloqueante para aquisição do DHT22.
+ */
+
+#ifndef DHT22_READER_H
+#define DHT22_READER_H
+
+#include <Arduino.h>
+#include <DHT.h>
+#include <esp_timer.h>
+#include <driver/rmt.h>
+#include "Config.h"
+#include "Dht22Decoder.h"
+
+/**
+ * Leitor não bloqueante do sensor DHT22.
+ *
+ * Realiza uma única transação no barramento por ciclo e decodifica
+ * temperatura e umidade do mesmo quadro. O pulso de início é liberado
+ * por um esp_timer e os tempos dos pulsos são capturados pelo periférico
+ * RMT, de modo que quem chama poll() nunca aguarda o barramento. A
+ * decodificação dos pulsos fica em Dht22Decoder, sem dependência de hardware.
+ */
+class Dht22Reader {
+public:
+    typedef Dht22Decoder::Status Status;
+    typedef Dht22Decoder::Pulse Pulse;
+
+    /**
+     * Resultado de uma aquisição.
+     */
+    struct Result {
+        float temperature;      // Temperatura em °C (válida se status == OK)
+        float humidity;         // Umidade relativa em % (válida se status == OK)
+        Status status;          // Estado da aquisição
+        uint32_t timestamp;     // Momento da conclusão (ms desde boot)
+        uint32_t decodeTimeUs;  // Tempo gasto na decodificação (μs)
+
+        Result() : temperature(NAN), humidity(NAN), status(Status::NONE),
+                   timestamp(0), decodeTimeUs(0) {}
+    };
+
+    /**
+     * Construtor.
+     *
+     * @param pin Pino de dados do DHT22.
+     * @param channel Canal RMT utilizado para a captura.
+     */
+    Dht22Reader(uint8_t pin, rmt_channel_t channel);
+
+    /**
+     * Configura o pino, o canal RMT e o temporizador do pulso de início.
+     *
+     * @return true se os recursos foram alocados com sucesso.
+     */
+    bool begin();
+
+    /**
+     * Avança a máquina de estados sem bloquear.
+     *
+     * Deve ser chamado periodicamente pela tarefa de sensores. Inicia
+     * uma nova transação quando o intervalo mínimo do DHT22 expira e
+     * coleta o quadro capturado quando disponível.
+     *
+     * @return true se uma nova aquisição foi concluída nesta chamada.
+     */
+    bool poll();
+
+    /**
+     * Calcula quando poll() voltará a ter trabalho.
+     *
+     * Durante uma transação é o intervalo de verificação da captura; fora
+     * dela, o tempo restante até a próxima transação.
+     *
+     * @return Atraso até a próxima chamada útil de poll() (ms, mínimo 1).
+     */
+    uint32_t getPollDelay() const;
+
+    /**
+     * Obtém o resultado da última aquisição concluída.
+     *
+     * @return Referência para o resultado.
+     */
+    const Result &getLastResult() const;
+
+    /**
+     * Obtém o número de aquisições bem-sucedidas.
+     */
+    uint32_t getSuccessCount() const;
+
+    /**
+     * Obtém o número de aquisições com falha.
+     */
+    uint32_t getErrorCount() const;
+
+    /**
+     * Converte um estado em texto para logs.
+     *
+     * @param status Estado a ser convertido.
+     * @return Descrição curta do estado.
+     */
+    static const char *statusToString(Status status) {
+        return Dht22Decoder::statusToString(status);
+    }
+
+private:
+    // Estados internos da transação
+    enum State : uint8_t {
+        STATE_IDLE,         // Aguardando o intervalo mínimo entre leituras
+        STATE_START_SIGNAL, // Linha mantida em nível baixo pelo host
+        STATE_CAPTURING     // RMT capturando a resposta do sensor
+    };
+
+    // Tempos do protocolo (μs)
+    static constexpr uint32_t START_SIGNAL_US = 1100;  // Pulso de início (mínimo 1 ms)
+
+    // Quadro completo: resposta + 40 bits (baixo/alto) + margem
+    static constexpr size_t MAX_PULSES = 96;
+
+    uint8_t m_pin;
+    rmt_channel_t m_channel;
+    RingbufHandle_t m_ringBuffer;
+    esp_timer_handle_t m_startTimer;
+    DHT m_dht;                        // Usado apenas quando DHT22_USE_RMT == false
+
+    volatile State m_state;
+    uint32_t m_transactionStart;      // Início da transação atual (ms)
+    bool m_ready;
+
+    Result m_result;
+    uint32_t m_successCount;
+    uint32_t m_errorCount;
+
+    /**
+     * Callback do esp_timer: libera a linha e inicia a captura.
+     *
+     * @param arg Ponteiro para a instância.
+     */
+    static void onStartSignalDone(void *arg);
+
+    /**
+     * Inicia uma nova transação no barramento.
+     */
+    void startTransaction();
+
+    /**
+     * Coleta o quadro capturado pelo RMT, se houver.
+     *
+     * @return true se a transação terminou (com sucesso ou erro).
+     */
+    bool collectFrame();
+
+    /**
+     * Finaliza a transação atual e publica o resultado.
+     */
+    void finishTransaction(Status status, float temperature, float humidity,
+                           uint32_t decodeTimeUs);
+};
+
+#endif // DHT22_READER_H
@@ -0,0 +1,66 @@
+/**
+ * @file FieldMode.h
+ * @brief Modo de campo: amostragem em ciclos de deep sleep com estado na memória RTC.
+ */
+
+#ifndef FIELD_MODE_H
+#define FIELD_MODE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * Operação de baixo consumo para bateria ou painel solar.
+ *
+ * Cada ciclo é um boot: acorda pelo temporizador, lê o DHT22 com o filtro
+ * restaurado, acrescenta a amostra ao lote guardado na memória RTC e volta
+ * ao deep sleep. O WiFi só é ligado a cada FIELD_UPLOAD_EVERY ciclos para
+ * enviar o lote. Nenhuma tarefa FreeRTOS nem o servidor web são criados.
+ *
+ * A cada ciclo é registrado o orçamento de tempo e carga, e a média móvel
+ * dos ciclos com e sem envio alimenta a previsão de autonomia para
+ * qualquer combinação de intervalo de amostragem e de envio.
+ */
+namespace FieldMode {
+
+    /**
+     * Tempo e carga de um ciclo.
+     */
+    struct CycleBudget {
+        uint32_t cycle;             // Ciclo desde o último boot a frio
+        uint32_t activeMs;          // CPU acordada com o rádio desligado, incluindo o boot
+        uint32_t radioMs;           // WiFi ligado: conexão, envio e desligamento
+        uint32_t sleepMs;           // Deep sleep programado
+        float chargeUah;            // Carga do ciclo inteiro (μAh)
+    };
+
+    /**
+     * Previsão de consumo para um plano de amostragem.
+     */
+    struct Estimate {
+        float averageUa;            // Corrente média (μA)
+        float lifeDays;             // Autonomia com FIELD_BATTERY_MAH (dias)
+    };
+
+    /**
+     * Executa um ciclo e entra em deep sleep; não retorna.
+     *
+     * Chamado no início de setup() quando FIELD_MODE está habilitado, antes
+     * de qualquer atraso de inicialização.
+     */
+    void run();
+
+    /**
+     * Estima o consumo de um plano a partir dos ciclos medidos.
+     *
+     * Sem medições (primeiro boot), usa o modelo de FIELD_BOOT_TIME e das
+     * correntes configuradas.
+     *
+     * @param intervalS Intervalo entre amostras (s).
+     * @param uploadEvery Ciclos por envio.
+     * @return Corrente média e autonomia previstas.
+     */
+    Estimate estimate(uint32_t intervalS, uint16_t uploadEvery);
+}
+
+#endif // FIELD_MODE_H
@@ -10,6 +10,7 @@
 #include <DHT.h>
 #include <Adafruit_Sensor.h>
 #include "Config.h"
+#include "Dht22Reader.h"
 
 namespace Hardware {
     // Pinos dos sensores
@@ -19,6 +20,9 @@ namespace Hardware {
     // Tipo do sensor DHT
     constexpr uint8_t DHT_TYPE = DHT22;         // Usar DHT22 em vez de DHT11
 
+    // Canal RMT usado para capturar os pulsos do DHT22
+    constexpr rmt_channel_t DHT22_RMT_CHANNEL = RMT_CHANNEL_4;
+
     // Estados de LED
     enum LedState {
         LED_OFF = LOW,
@@ -69,33 +73,37 @@ namespace Hardware {
     bool readButtonDebounced(uint8_t pin, int activeState = LOW);
 
     /**
-     * Inicializa o sensor DHT22.
+     * Inicializa o sensor DHT22 e aguarda a primeira aquisição.
      *
+     * @param powerUpDelay Aguarda a estabilização após a energização; pode
+     *        ser omitida ao despertar do deep sleep, com o sensor alimentado.
      * @return true se a inicialização foi bem-sucedida.
      */
-    bool initDHT();
+    bool initDHT(bool powerUpDelay = true);
 
     /**
-     * Lê a temperatura do sensor DHT22.
+     * Avança a aquisição não bloqueante do DHT22.
+     *
+     * Chamado pelo job do DHT22 na tarefa de sensores. Nunca aguarda
+     * o barramento: inicia transações e coleta quadros já capturados.
      *
-     * @return Temperatura em graus Celsius calibrada ou NAN se ocorrer erro.
+     * @return true se uma nova aquisição foi concluída.
      */
-    float readTemperature();
+    bool pollDHT();
 
     /**
-     * Lê a umidade do sensor DHT22.
+     * Obtém o atraso até a próxima chamada útil de pollDHT().
      *
-     * @return Umidade relativa (0-100%) ou NAN se ocorrer erro.
+     * @return Atraso em milissegundos.
      */
-    float readHumidity();
+    uint32_t getDHTPollDelay();
 
     /**
-     * Obtém a temperatura calibrada para exibição na web.
+     * Obtém o leitor do DHT22 para consulta de estatísticas.
      *
-     * @param rawTemp Temperatura bruta do sensor
-     * @return Temperatura calibrada para exibição
+     * @return Referência para o leitor.
      */
-    float getCalibrationTemperature(float rawTemp);
+    const Dht22Reader &getDHTReader();
 
     /**
      * Define o estado do relé de irrigação.
@@ -61,6 +61,22 @@ public:
      */
     size_t getEntries(char* buffer, size_t maxSize);
 
+    /**
+     * @brief Copia entradas em ordem cronológica a partir de um número de sequência.
+     * @param sequence Sequência da próxima entrada desejada; se ela já foi
+     *        sobrescrita, é avançada para a entrada mais antiga disponível.
+     * @param out Destino das entradas.
+     * @param maxCount Capacidade do destino.
+     * @return Número de entradas copiadas (a primeira tem a sequência indicada).
+     */
+    size_t readSince(uint32_t& sequence, LogEntry* out, size_t maxCount);
+
+    /**
+     * @brief Obtém a sequência da próxima entrada a ser adicionada.
+     * @return Total de entradas já adicionadas.
+     */
+    uint32_t getSequence() const;
+
 private:
     CircularLogBuffer();
     ~CircularLogBuffer();
@@ -72,6 +88,7 @@ private:
     // Dados do buffer
     LogEntry m_entries[LOG_BUFFER_SIZE];   ///< Buffer circular de entradas
     size_t m_head;                         ///< Posição da próxima escrita
+    volatile uint32_t m_sequence;          ///< Total de entradas adicionadas
     SemaphoreHandle_t m_mutex;             ///< Mutex para acesso thread-safe
 
     // Instância singleton
@@ -192,6 +209,14 @@ public:
      */
     const char* levelToString(LogLevel level);
 
+    /**
+     * @brief Converte o nome de um nível de log (sem diferenciar maiúsculas).
+     * @param name Nome do nível, como retornado por levelToString().
+     * @param level Nível correspondente.
+     * @return true se o nome é conhecido, false caso contrário.
+     */
+    bool stringToLevel(const char* name, LogLevel& level);
+
     /**
      * @brief Converte um nível de log para prioridade do ConsoleManager.
      * @param level Nível de log.
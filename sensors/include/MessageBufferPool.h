@@ -0,0 +1,90 @@
+/**
+ * @file MessageBufferPool.h
+ * @brief Pool fixo de buffers compartilhados para broadcast WebSocket.
+ */
+
+#ifndef MESSAGE_BUFFER_POOL_H
+#define MESSAGE_BUFFER_POOL_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <freertos/FreeRTOS.h>
+#include "Config.h"
+
+/**
+ * Pool de AsyncWebSocketMessageBuffer alocados uma única vez.
+ *
+ * Cada quadro é serializado diretamente em um buffer do pool e entregue aos
+ * clientes, que o compartilham por contagem de referências, sem cópias do
+ * payload. O buffer volta a ficar disponível quando o último cliente termina
+ * de enviá-lo (canDelete()).
+ * Como os buffers não são criados por makeBuffer(), a biblioteca nunca os
+ * libera.
+ *
+ * O tamanho de um AsyncWebSocketMessageBuffer é fixo; acquire() prefere um
+ * buffer livre do tamanho pedido e só realoca (reserve()) quando nenhum
+ * serve. Com poucos tamanhos distintos, as realocações cessam após o início.
+ */
+class MessageBufferPool {
+public:
+    /**
+     * Construtor.
+     *
+     * @param bufferSize Tamanho inicial de cada buffer (bytes).
+     */
+    explicit MessageBufferPool(size_t bufferSize);
+
+    ~MessageBufferPool();
+
+    /**
+     * Aloca os buffers do pool.
+     *
+     * @return true se todos os buffers foram alocados.
+     */
+    bool begin();
+
+    /**
+     * Obtém um buffer livre, sem alocar.
+     *
+     * O buffer retorna travado (lock()), para que não seja entregue de novo
+     * antes do envio. Depois de entregá-lo aos clientes (ou de descartar o
+     * quadro), chame unlock(): cada mensagem enfileirada mantém sua própria
+     * referência.
+     *
+     * @param length Tamanho exato do quadro (bytes).
+     * @return Buffer livre ou nullptr se todos ainda estão em uso.
+     */
+    AsyncWebSocketMessageBuffer *acquire(size_t length);
+
+    /**
+     * @return Número de buffers entregues.
+     */
+    uint32_t getAcquiredCount() const { return m_acquired; }
+
+    /**
+     * @return Número de vezes em que não havia buffer livre.
+     */
+    uint32_t getExhaustedCount() const { return m_exhausted; }
+
+    /**
+     * @return Número de realocações por mudança de tamanho.
+     */
+    uint32_t getResizedCount() const { return m_resized; }
+
+    /**
+     * @return Maior número de buffers em uso simultâneo.
+     */
+    uint8_t getHighWater() const { return m_highWater; }
+
+private:
+    AsyncWebSocketMessageBuffer *m_buffers[WS_BUFFER_POOL_SIZE];
+    size_t m_bufferSize;
+    uint8_t m_next;         // Próximo buffer a verificar (rodízio)
+    uint32_t m_acquired;
+    uint32_t m_exhausted;
+    uint32_t m_resized;
+    uint8_t m_highWater;
+    portMUX_TYPE m_lock;
+};
+
+#endif // MESSAGE_BUFFER_POOL_H
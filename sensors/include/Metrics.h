@@ -0,0 +1,216 @@
+/**
+ * @file Metrics.h
+ * @brief Registro central de métricas (contadores, medidores e histogramas).
+ *
+ * As métricas são objetos estáticos registrados em uma lista encadeada na
+ * inicialização, sem alocação. A escrita usa atômicos relaxados e pode
+ * acontecer em qualquer tarefa; a exportação em /metrics percorre a lista
+ * e formata uma linha do formato texto do Prometheus por vez.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "Config.h"
+
+namespace Metrics {
+
+    /**
+     * Tipo da métrica, exportado na linha # TYPE.
+     */
+    enum class MetricType : uint8_t {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    /**
+     * Base das métricas registradas.
+     *
+     * Métricas com o mesmo nome (séries com rótulos diferentes) devem ser
+     * definidas em sequência para que # HELP e # TYPE saiam uma única vez.
+     */
+    class Metric {
+    public:
+        /**
+         * @param name Nome da métrica (literal).
+         * @param help Descrição da linha # HELP (literal).
+         * @param type Tipo da métrica.
+         * @param labels Rótulos já formatados, ex.: task="WebTask" (ou nullptr).
+         */
+        Metric(const char *name, const char *help, MetricType type, const char *labels);
+
+        /**
+         * Formata uma linha da exportação desta métrica.
+         *
+         * As primeiras linhas são # HELP e # TYPE quando esta é a primeira
+         * série do nome; as seguintes são as amostras.
+         *
+         * @param line Índice da linha (a partir de 0).
+         * @param out Destino (METRICS_LINE_SIZE bytes bastam).
+         * @param size Capacidade do destino.
+         * @return Bytes escritos, ou 0 se não há mais linhas.
+         */
+        size_t formatLine(size_t line, char *out, size_t size) const;
+
+        /**
+         * @return Próxima métrica registrada, ou nullptr.
+         */
+        const Metric *next() const { return m_next; }
+
+        /**
+         * @return Primeira métrica registrada, ou nullptr.
+         */
+        static const Metric *first() { return s_head; }
+
+    protected:
+        /**
+         * Formata a amostra de índice sample.
+         *
+         * @return Bytes escritos, ou 0 se não há mais amostras.
+         */
+        virtual size_t formatSample(size_t sample, char *out, size_t size) const = 0;
+
+        /**
+         * Escreve "nome[sufixo]{rótulos[,extra]} valor\n".
+         */
+        size_t formatValue(char *out, size_t size, const char *suffix, const char *extraLabel,
+                           const char *value) const;
+
+        const char *m_name;
+        const char *m_help;
+        const char *m_labels;
+        MetricType m_type;
+
+    private:
+        bool m_header;          // Primeira série do nome: emite # HELP e # TYPE
+        const Metric *m_next;
+
+        static Metric *s_head;
+        static Metric *s_tail;
+    };
+
+    /**
+     * Contador monotônico.
+     */
+    class Counter : public Metric {
+    public:
+        Counter(const char *name, const char *help, const char *labels = nullptr);
+
+        void inc(uint32_t amount = 1) { m_value.fetch_add(amount, std::memory_order_relaxed); }
+        uint32_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+    protected:
+        size_t formatSample(size_t sample, char *out, size_t size) const override;
+
+    private:
+        std::atomic<uint32_t> m_value;
+    };
+
+    /**
+     * Valor instantâneo.
+     */
+    class Gauge : public Metric {
+    public:
+        Gauge(const char *name, const char *help, const char *labels = nullptr);
+
+        void set(int32_t value) { m_value.store(value, std::memory_order_relaxed); }
+        void add(int32_t amount) { m_value.fetch_add(amount, std::memory_order_relaxed); }
+        int32_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+    protected:
+        size_t formatSample(size_t sample, char *out, size_t size) const override;
+
+    private:
+        std::atomic<int32_t> m_value;
+    };
+
+    /**
+     * Histograma de faixas fixas.
+     *
+     * Os limites ficam na unidade do chamador (ex.: ms) e são convertidos
+     * por scale na exportação (ex.: 0.001 para segundos). A soma é de 64
+     * bits: em μs, 32 bits dariam a volta em horas enquanto _count segue
+     * crescendo, e rate(_sum) / rate(_count) sairia errado.
+     */
+    class Histogram : public Metric {
+    public:
+        /**
+         * @param bounds Limites superiores crescentes (estáticos).
+         * @param count Número de limites (até METRICS_HISTOGRAM_BUCKETS).
+         * @param scale Fator de conversão dos limites e da soma na exportação.
+         */
+        Histogram(const char *name, const char *help, const uint32_t *bounds, uint8_t count,
+                  float scale = 1.0f, const char *labels = nullptr);
+
+        /**
+         * Registra uma observação.
+         */
+        void observe(uint32_t value);
+
+    protected:
+        size_t formatSample(size_t sample, char *out, size_t size) const override;
+
+    private:
+        const uint32_t *m_bounds;
+        uint8_t m_count;
+        float m_scale;
+        std::atomic<uint32_t> m_buckets[METRICS_HISTOGRAM_BUCKETS + 1]; // Não cumulativas; a última é +Inf
+        std::atomic<uint64_t> m_sum;    // No Xtensa, emulado pelo IDF com seção crítica
+    };
+
+    // Sensores
+    extern Counter sensorReads;
+    extern Counter dhtTransactionsOk;
+    extern Counter dhtTransactionsFailed;
+    extern Counter temperatureOutliers;
+    extern Counter humidityOutliers;
+
+    // Alertas
+    extern Counter alertsRaised;
+    extern Counter alertsCleared;
+    extern Gauge alertsActive;
+    extern Counter ruleErrors;
+    extern Histogram alertEvaluation;
+
+    // WebSocket
+    extern Counter wsBroadcasts;
+    extern Counter wsFramesSent;
+    extern Counter wsFramesConflated;
+
+    // Envio para a API
+    extern Counter uplinkRequestsOk;
+    extern Counter uplinkRequestsFailed;
+    extern Counter uplinkSamplesSent;
+    extern Counter uplinkSamplesDropped;
+    extern Counter uplinkAlertsDropped;
+    extern Histogram uplinkRequestDuration;
+
+    /**
+     * Métricas de despertar de uma tarefa, alimentadas pelo Scheduler.
+     */
+    struct TaskMetrics {
+        Counter &wakeups;           // Despertares da tarefa
+        Counter &deadlineMisses;    // Jobs iniciados mais de um período após o prazo
+        Histogram &wakeLatency;     // Atraso do despertar em relação ao prazo (μs)
+        Histogram &busy;            // Tempo de execução dos jobs por despertar (μs)
+    };
+
+    // Tarefas
+    extern const TaskMetrics sensorTask;
+    extern const TaskMetrics webTask;
+    extern Histogram sensorMutexWait;
+    extern Counter sensorMutexTimeouts;
+
+    /**
+     * Atualiza os medidores amostrados (heap, uptime e pilhas das tarefas).
+     *
+     * Chamado antes de cada exportação; percorre a lista de tarefas do
+     * FreeRTOS, portanto não deve ser chamado em laços rápidos.
+     */
+    void sampleSystem();
+}
+
+#endif // METRICS_H
@@ -10,9 +10,64 @@
 #include "LogSystem.h"
 #include "ConsoleFormat.h"
 #include "TelemetryBuffer.h"
+#include "TelemetryDelta.h"
+#include "ClientSubscriptions.h"
 
 // Forward declarations
 class AsyncSoilWebServer;
+class AsyncWebSocketClient;
+class AsyncWebSocketMessageBuffer;
+
+/**
+ * @struct WireFormatStats
+ * @brief Custo de serialização de um formato de telemetria.
+ */
+struct WireFormatStats {
+    uint32_t frames;        ///< Quadros serializados
+    uint32_t lastBytes;     ///< Tamanho do último quadro (bytes)
+    uint32_t totalBytes;    ///< Soma dos tamanhos (bytes)
+    uint32_t lastUs;        ///< Tempo de CPU do último quadro (μs)
+    uint32_t totalUs;       ///< Soma dos tempos de CPU (μs)
+    uint32_t suppressed;    ///< Quadros omitidos por não haver mudança
+    uint32_t lastFullBytes; ///< Tamanho do último quadro completo (bytes)
+    uint32_t lastFullUs;    ///< Custo do último quadro completo (μs)
+    uint32_t savedBytes;    ///< Bytes economizados por cliente vs. quadros completos
+    uint32_t savedUs;       ///< Tempo de CPU economizado vs. quadros completos (μs)
+
+    WireFormatStats() : frames(0), lastBytes(0), totalBytes(0), lastUs(0), totalUs(0),
+                        suppressed(0), lastFullBytes(0), lastFullUs(0), savedBytes(0),
+                        savedUs(0) {}
+
+    /**
+     * @brief Registra a serialização de um quadro.
+     *
+     * @param full true para quadro completo, false para delta
+     */
+    void record(uint32_t bytes, uint32_t us, bool full) {
+        frames++;
+        lastBytes = bytes;
+        totalBytes += bytes;
+        lastUs = us;
+        totalUs += us;
+
+        if (full) {
+            lastFullBytes = bytes;
+            lastFullUs = us;
+        } else {
+            savedBytes += lastFullBytes > bytes ? lastFullBytes - bytes : 0;
+            savedUs += lastFullUs > us ? lastFullUs - us : 0;
+        }
+    }
+
+    /**
+     * @brief Registra um quadro omitido (nenhum campo alterado).
+     */
+    void suppress() {
+        suppressed++;
+        savedBytes += lastFullBytes;
+        savedUs += lastFullUs;
+    }
+};
 
 /**
  * @class OutputManager
@@ -72,6 +127,19 @@ public:
      */
     static void telemetry(const char* sensor, TelemetryBuffer& data);
 
+    /**
+     * @brief Envia o estado completo dos tópicos assinados a um único cliente.
+     *
+     * Usado na conexão e a cada nova assinatura: os envios periódicos são
+     * incrementais, e o cliente precisa partir de um estado completo.
+     *
+     * @param client Cliente de destino
+     * @param subscription Tópicos e formato do cliente
+     * @param data Buffer com dados de telemetria
+     */
+    static void telemetrySnapshot(AsyncWebSocketClient* client, const ClientSubscription& subscription,
+                                  const TelemetryBuffer& data);
+
     /**
      * @brief Verifica se deve atualizar com base em tipo e destino.
      *
@@ -95,11 +163,31 @@ public:
      */
     static void attachConsoleManager(ConsoleManager* console);
 
+    /**
+     * @brief Obtém o custo de serialização da telemetria JSON.
+     *
+     * @return Estatísticas do formato JSON
+     */
+    static const WireFormatStats& getJsonStats();
+
+    /**
+     * @brief Obtém o custo de serialização da telemetria binária.
+     *
+     * @return Estatísticas do formato binário
+     */
+    static const WireFormatStats& getBinaryStats();
+
 private:
     static AsyncSoilWebServer* s_webSocketServer;  ///< Servidor WebSocket
     static ConsoleManager* s_consoleManager;       ///< Gerenciador de console
     static uint32_t s_lastUpdateTime[4][3];        ///< Último tempo de atualização [tipo][destino]
     static bool s_initialized;                    ///< Flag de inicialização
+    static WireFormatStats s_jsonStats;            ///< Custo da telemetria JSON
+    static WireFormatStats s_binaryStats;          ///< Custo da telemetria binária
+    static TelemetryDelta s_telemetryDelta[WS_RATE_CLASS_COUNT]; ///< Campos alterados por classe de taxa
+    static uint32_t s_lastClassSend[WS_RATE_CLASS_COUNT];  ///< Último envio de cada classe de taxa
+    static uint32_t s_logSequence[WS_RATE_CLASS_COUNT];    ///< Próxima entrada de log de cada classe
+    static char s_logFrame[WS_LOG_FRAME_SIZE + 1];         ///< Área de montagem dos quadros de log
 
     /**
      * @brief Roteia mensagem para o console.
@@ -113,11 +201,76 @@ private:
     /**
      * @brief Roteia telemetria para o WebSocket.
      *
+     * Para cada classe de taxa cujo período venceu, serializa um quadro por
+     * combinação de tópicos e formato e o entrega a todos os clientes
+     * assinantes daquela combinação.
+     *
      * @param sensor Nome do sensor ou componente
      * @param data Buffer de telemetria
      */
     static void routeToWebSocket(const char* sensor, TelemetryBuffer& data);
 
+    /**
+     * @brief Envia a telemetria de uma classe de taxa aos seus assinantes.
+     *
+     * @param sensor Nome do sensor ou componente
+     * @param data Buffer de telemetria
+     * @param rateClass Classe de taxa
+     * @param subscriptions Assinaturas ativas
+     * @param count Número de assinaturas
+     * @param clients Número de clientes conectados
+     * @param now Tempo atual (ms)
+     */
+    static void routeTelemetryClass(const char* sensor, const TelemetryBuffer& data, uint8_t rateClass,
+                                    const ClientSubscription* subscriptions, size_t count,
+                                    uint16_t clients, uint32_t now);
+
+    /**
+     * @brief Envia as novas entradas de log aos assinantes de uma classe de taxa.
+     *
+     * @param rateClass Classe de taxa
+     * @param subscriptions Assinaturas ativas
+     * @param count Número de assinaturas
+     */
+    static void routeLogClass(uint8_t rateClass, const ClientSubscription* subscriptions, size_t count);
+
+    /**
+     * @brief Serializa um TelemetryFrame (completo ou delta) em um buffer do pool.
+     *
+     * @param data Buffer de telemetria
+     * @param fields Máscara TELEMETRY_FIELD_*
+     * @param clients Número de clientes conectados
+     * @return Buffer travado ou nullptr se o pool está esgotado
+     */
+    static AsyncWebSocketMessageBuffer* buildBinaryFrame(const TelemetryBuffer& data, uint16_t fields,
+                                                         uint16_t clients);
+
+    /**
+     * @brief Serializa um quadro JSON de telemetria em um buffer do pool.
+     *
+     * @param sensor Nome do sensor ou componente
+     * @param data Buffer de telemetria
+     * @param fields Máscara TELEMETRY_FIELD_*
+     * @param clients Número de clientes conectados
+     * @param full true se o quadro traz o estado completo dos tópicos
+     * @return Buffer travado ou nullptr se o pool está esgotado
+     */
+    static AsyncWebSocketMessageBuffer* buildJsonFrame(const char* sensor, const TelemetryBuffer& data,
+                                                       uint16_t fields, uint16_t clients, bool full);
+
+    /**
+     * @brief Monta o documento JSON de telemetria com os campos indicados.
+     *
+     * @param doc Documento de destino
+     * @param sensor Nome do sensor ou componente
+     * @param data Buffer de telemetria
+     * @param fields Máscara TELEMETRY_FIELD_*
+     * @param clients Número de clientes conectados
+     * @param full true se o quadro traz o estado completo dos tópicos
+     */
+    static void buildJson(JsonDocument& doc, const char* sensor, const TelemetryBuffer& data,
+                          uint16_t fields, uint16_t clients, bool full);
+
     /**
      * @brief Roteia mensagem para armazenamento em memória.
      *
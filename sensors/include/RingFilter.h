@@ -0,0 +1,194 @@
+/**
+ * @file RingFilter.h
+ * @brief Média móvel de janela fixa com soma incremental.
+ */
+
+#ifndef RING_FILTER_H
+#define RING_FILTER_H
+
+#include <stdint.h>
+#include <math.h>
+#include <type_traits>
+
+/**
+ * Tipo da soma acumulada de um RingFilter.
+ *
+ * Ponto flutuante soma no próprio tipo; inteiros usam um tipo com folga
+ * para 255 amostras do maior valor representável.
+ */
+template <typename T, bool Floating = std::is_floating_point<T>::value>
+struct RingFilterSum {
+    typedef T type;
+};
+
+template <typename T>
+struct RingFilterSum<T, false> {
+    typedef typename std::conditional<std::is_signed<T>::value,
+        typename std::conditional<(sizeof(T) <= 2), int32_t, int64_t>::type,
+        typename std::conditional<(sizeof(T) <= 2), uint32_t, uint64_t>::type>::type type;
+};
+
+/**
+ * Média móvel de N amostras em O(1) por amostra.
+ *
+ * A soma da janela é mantida incrementalmente: cada amostra nova entra e
+ * a mais antiga sai. Durante o aquecimento a média considera apenas as
+ * amostras já recebidas, sem zeros iniciais. Em ponto flutuante, a soma
+ * é refeita a cada volta do anel para não acumular erro de arredondamento
+ * (custo amortizado de uma soma por amostra).
+ *
+ * Não tem construtor para continuar trivial (pode ficar na memória RTC);
+ * o estado inicial vem de reset() ou da inicialização por valor ({}).
+ *
+ * @tparam T Tipo aritmético das amostras.
+ * @tparam N Tamanho da janela (1 a 255).
+ */
+template <typename T, uint8_t N>
+class RingFilter {
+    static_assert(N > 0, "RingFilter exige uma janela de pelo menos uma amostra");
+    static_assert(std::is_arithmetic<T>::value, "RingFilter exige um tipo aritmético");
+
+public:
+    typedef typename RingFilterSum<T>::type Sum;
+
+    /**
+     * Descarta todas as amostras.
+     */
+    void reset() {
+        m_sum = 0;
+        m_index = 0;
+        m_count = 0;
+    }
+
+    /**
+     * Acrescenta uma amostra.
+     *
+     * @param value Nova amostra.
+     * @return Média da janela após a inclusão.
+     */
+    T update(T value) {
+        if (m_count < N) {
+            m_count++;
+        } else {
+            m_sum -= m_values[m_index];
+        }
+
+        m_values[m_index] = value;
+        m_sum += value;
+
+        if (++m_index == N) {
+            m_index = 0;
+            if (std::is_floating_point<T>::value) {
+                resum();
+            }
+        }
+
+        return average();
+    }
+
+    /**
+     * @return Média das amostras na janela (0 se vazia).
+     */
+    T average() const {
+        return m_count > 0 ? static_cast<T>(m_sum / static_cast<Sum>(m_count)) : T(0);
+    }
+
+    /**
+     * @return Soma das amostras na janela.
+     */
+    Sum sum() const { return m_sum; }
+
+    /**
+     * @return Número de amostras na janela (até N).
+     */
+    uint8_t count() const { return m_count; }
+
+    /**
+     * @return true quando a janela está completa.
+     */
+    bool ready() const { return m_count == N; }
+
+    /**
+     * @return Tamanho da janela.
+     */
+    static constexpr uint8_t size() { return N; }
+
+private:
+    /**
+     * Recalcula a soma a partir das amostras.
+     */
+    void resum() {
+        Sum sum = 0;
+        for (uint8_t i = 0; i < m_count; i++) {
+            sum += m_values[i];
+        }
+        m_sum = sum;
+    }
+
+    T m_values[N];
+    Sum m_sum;
+    uint8_t m_index;        // Próxima posição a escrever
+    uint8_t m_count;
+};
+
+/**
+ * Média móvel em ponto fixo para grandezas em ponto flutuante.
+ *
+ * As amostras são guardadas como inteiros em 1/Scale da unidade, então a
+ * soma incremental é exata e nunca precisa ser refeita. A resolução é
+ * 1/Scale e a faixa de cada amostra é a de int32_t dividida por Scale.
+ *
+ * @tparam N Tamanho da janela (1 a 255).
+ * @tparam Scale Unidades inteiras por unidade da grandeza (ex.: 100).
+ */
+template <uint8_t N, int32_t Scale>
+class FixedRingFilter {
+    static_assert(Scale > 0, "FixedRingFilter exige escala positiva");
+
+public:
+    /**
+     * Descarta todas as amostras.
+     */
+    void reset() {
+        m_filter.reset();
+    }
+
+    /**
+     * Acrescenta uma amostra, arredondada para 1/Scale.
+     *
+     * @param value Nova amostra.
+     * @return Média da janela após a inclusão.
+     */
+    float update(float value) {
+        m_filter.update(static_cast<int32_t>(lroundf(value * Scale)));
+        return average();
+    }
+
+    /**
+     * @return Média das amostras na janela (0 se vazia).
+     */
+    float average() const {
+        uint8_t count = m_filter.count();
+        return count > 0 ? static_cast<float>(m_filter.sum()) / (static_cast<float>(count) * Scale) : 0.0f;
+    }
+
+    /**
+     * @return Número de amostras na janela (até N).
+     */
+    uint8_t count() const { return m_filter.count(); }
+
+    /**
+     * @return true quando a janela está completa.
+     */
+    bool ready() const { return m_filter.ready(); }
+
+    /**
+     * @return Tamanho da janela.
+     */
+    static constexpr uint8_t size() { return N; }
+
+private:
+    RingFilter<int32_t, N> m_filter;
+};
+
+#endif // RING_FILTER_H
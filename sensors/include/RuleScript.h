@@ -0,0 +1,178 @@
+/**
+ * @file RuleScript.h
+ * @brief Linguagem de regras configuráveis em campo: compilador e interpretador.
+ *
+ * Não depende do Arduino nem do FreeRTOS, para que o benchmark em
+ * bench/rule_bench.cpp compile no host com os mesmos fontes.
+ */
+
+#ifndef RULE_SCRIPT_H
+#define RULE_SCRIPT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @enum RuleInput
+ * @brief Variáveis disponíveis para as expressões.
+ */
+enum class RuleInput : uint8_t {
+    TEMPERATURE,            ///< temperatura (°C)
+    HUMIDITY,               ///< umidade (%)
+    TEMPERATURE_RATE,       ///< taxa_temperatura (°C/min)
+    HUMIDITY_RATE,          ///< taxa_umidade (%/min)
+    TEMPERATURE_SIGMA,      ///< sigma_temperatura (°C/min)
+    HUMIDITY_SIGMA,         ///< sigma_umidade (%/min)
+    ACTIVE,                 ///< ativo (1 se a regra está disparada)
+    COUNT
+};
+
+/**
+ * @enum RuleOp
+ * @brief Instruções da máquina de pilha.
+ *
+ * Saltos têm deslocamento de 1 byte e só avançam, então nenhuma instrução
+ * é executada duas vezes e o tempo de uma regra é limitado pelo tamanho
+ * do código.
+ */
+enum class RuleOp : uint8_t {
+    CONST,                  ///< Empilha constants[operando]
+    LOAD,                   ///< Empilha inputs[operando]
+    NEG,                    ///< -a
+    NOT,                    ///< !a (1 ou 0)
+    ABS,                    ///< abs(a)
+    ADD,                    ///< a + b
+    SUB,                    ///< a - b
+    MUL,                    ///< a * b
+    DIV,                    ///< a / b
+    MIN,                    ///< min(a, b)
+    MAX,                    ///< max(a, b)
+    LT,                     ///< a < b (1 ou 0)
+    LE,                     ///< a <= b
+    GT,                     ///< a > b
+    GE,                     ///< a >= b
+    EQ,                     ///< a == b
+    NE,                     ///< a != b
+    AND,                    ///< Topo falso: salta mantendo-o; senão o desempilha
+    OR,                     ///< Topo verdadeiro: salta mantendo-o; senão o desempilha
+    JZ,                     ///< Desempilha e salta se falso
+    JMP,                    ///< Salta
+    BOOL,                   ///< Converte o topo em 1 ou 0
+    COUNT
+};
+
+/**
+ * Regra compilada: bytecode, constantes e tempos de disparo.
+ *
+ * Trivial para atravessar um SeqLock e ser copiada entre tarefas.
+ */
+struct RuleProgram {
+    static constexpr uint8_t NAME_SIZE = 24;        // Nome, com o terminador
+    static constexpr uint8_t MAX_CODE = 64;         // Bytes de código (= orçamento de instruções)
+    static constexpr uint8_t MAX_CONSTANTS = 8;     // Constantes distintas
+    static constexpr uint8_t STACK_SIZE = 8;        // Profundidade da pilha
+
+    char name[NAME_SIZE];
+    uint32_t holdMs;                // Duração da condição para disparar (ms)
+    uint32_t clearMs;               // Duração da normalização para encerrar (ms)
+    uint8_t length;                 // Bytes de código
+    uint8_t constantCount;
+    uint8_t maxStack;               // Profundidade calculada pelo compilador
+    uint8_t code[MAX_CODE];
+    float constants[MAX_CONSTANTS];
+};
+
+/**
+ * Conjunto de regras publicado para a tarefa de sensores.
+ */
+struct RuleSet {
+    static constexpr uint8_t MAX_RULES = 4;
+
+    uint8_t count;
+    RuleProgram rules[MAX_RULES];
+};
+
+/**
+ * Erro de compilação.
+ */
+struct RuleCompileError {
+    uint8_t position;               // Posição na expressão (caracteres)
+    const char *message;            // Descrição estática
+};
+
+/**
+ * Compilador de expressões para bytecode.
+ *
+ * Gramática (precedência crescente):
+ *   expr    := or ('?' expr ':' expr)?
+ *   or      := and ('||' and)*
+ *   and     := eq ('&&' eq)*
+ *   eq      := cmp (('==' | '!=') cmp)*
+ *   cmp     := sum (('<' | '<=' | '>' | '>=') sum)*
+ *   sum     := product (('+' | '-') product)*
+ *   product := unary (('*' | '/') unary)*
+ *   unary   := ('-' | '!') unary | primary
+ *   primary := número | variável | abs(expr) | min(expr, expr)
+ *            | max(expr, expr) | '(' expr ')'
+ *
+ * Variáveis: temperatura, umidade, taxa_temperatura, taxa_umidade,
+ * sigma_temperatura, sigma_umidade e ativo. Taxas em unidades por
+ * minuto. Valores diferentes de zero são verdadeiros.
+ *
+ * Exemplo com histerese: "ativo ? umidade > 92 : umidade > 95".
+ */
+class RuleCompiler {
+public:
+    /**
+     * Compila uma expressão.
+     *
+     * Rejeita programas acima de RuleProgram::MAX_CODE bytes, com mais de
+     * MAX_CONSTANTS constantes ou que excedam STACK_SIZE na pilha, de modo
+     * que todo programa aceito roda dentro do orçamento do interpretador.
+     *
+     * @param source Expressão (terminada em nulo).
+     * @param program Destino do código; nome e tempos não são alterados.
+     * @param error Posição e descrição do erro, se houver.
+     * @return true se a expressão foi compilada.
+     */
+    static bool compile(const char *source, RuleProgram &program, RuleCompileError &error);
+
+    /**
+     * @param input Variável.
+     * @return Nome da variável na linguagem.
+     */
+    static const char *inputName(RuleInput input);
+};
+
+/**
+ * Interpretador do bytecode.
+ */
+class RuleInterpreter {
+public:
+    /**
+     * @enum Status
+     * @brief Resultado de uma execução.
+     */
+    enum class Status : uint8_t {
+        OK,
+        BUDGET,         ///< Orçamento de instruções esgotado
+        STACK,          ///< Pilha estourada ou vazia
+        INVALID         ///< Instrução ou operando inválido
+    };
+
+    /**
+     * Executa uma regra.
+     *
+     * Executa no máximo RuleProgram::MAX_CODE instruções, com a pilha na
+     * pilha do chamador (STACK_SIZE floats). Código inválido nunca lê nem
+     * escreve fora do programa, das entradas ou da pilha.
+     *
+     * @param program Regra compilada.
+     * @param inputs Valores das variáveis, indexados por RuleInput.
+     * @param result Valor da expressão (com Status::OK).
+     * @return Resultado da execução.
+     */
+    static Status run(const RuleProgram &program, const float *inputs, float &result);
+};
+
+#endif // RULE_SCRIPT_H
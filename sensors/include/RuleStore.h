@@ -0,0 +1,121 @@
+/**
+ * @file RuleStore.h
+ * @brief Regras de alerta configuradas em campo: validação, persistência e publicação.
+ */
+
+#ifndef RULE_STORE_H
+#define RULE_STORE_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "RuleScript.h"
+#include "SeqLock.h"
+
+/**
+ * Regra como enviada pelo usuário.
+ */
+struct RuleSource {
+    char name[RuleProgram::NAME_SIZE];      // Identificador enviado à API e ao painel
+    char expression[RULE_SOURCE_SIZE];      // Condição de alarme (RuleScript.h)
+    uint32_t holdMs;                        // Duração da condição para disparar (ms)
+    uint32_t clearMs;                       // Duração da normalização para encerrar (ms)
+};
+
+/**
+ * Erro de uma atualização rejeitada.
+ */
+struct RuleUpdateError {
+    uint8_t rule;                   // Índice da regra com erro
+    uint8_t position;               // Posição na expressão (caracteres)
+    const char *message;            // Descrição estática
+};
+
+/**
+ * Repositório das regras configuradas.
+ *
+ * As regras são compiladas uma vez, no envio: a tarefa de sensores só
+ * recebe o bytecode pronto, publicado por um SeqLock, e troca o conjunto
+ * quando a sequência muda. Os fontes ficam na NVS e são recompilados no
+ * boot.
+ *
+ * update() deve ser chamado por uma única tarefa (a do AsyncTCP, que
+ * atende o WebSocket e o HTTP); read() pode ser chamado de qualquer tarefa.
+ */
+class RuleStore {
+public:
+    /**
+     * Obtém a instância do singleton.
+     *
+     * @return Referência para a instância única.
+     */
+    static RuleStore &getInstance();
+
+    /**
+     * Carrega e publica as regras salvas na NVS.
+     *
+     * Regras salvas que não compilam mais (firmware com outra linguagem)
+     * são descartadas por inteiro.
+     *
+     * @return Número de regras carregadas.
+     */
+    uint8_t begin();
+
+    /**
+     * Substitui todas as regras.
+     *
+     * Tudo ou nada: se alguma regra não compila, nada muda.
+     *
+     * @param sources Regras novas.
+     * @param count Número de regras (até RuleSet::MAX_RULES; 0 remove todas).
+     * @param error Regra e posição do erro, se houver.
+     * @return true se as regras foram publicadas.
+     */
+    bool update(const RuleSource *sources, uint8_t count, RuleUpdateError &error);
+
+    /**
+     * Obtém uma cópia do conjunto compilado.
+     *
+     * @param set Destino.
+     * @return Sequência do conjunto copiado.
+     */
+    uint32_t read(RuleSet &set) const { return m_published.read(set); }
+
+    /**
+     * @return Número de publicações; muda a cada update() aceito.
+     */
+    uint32_t getSequence() const { return m_published.getSequence(); }
+
+    /**
+     * @return Número de regras atuais (apenas na tarefa de update()).
+     */
+    uint8_t getCount() const { return m_count; }
+
+    /**
+     * @param index Índice da regra.
+     * @return Fonte da regra, ou nullptr fora do conjunto (apenas na tarefa de update()).
+     */
+    const RuleSource *getSource(uint8_t index) const;
+
+private:
+    // Singleton
+    static RuleStore *s_instance;
+
+    RuleStore();
+
+    /**
+     * Valida e compila as regras em m_staging.
+     */
+    bool compile(const RuleSource *sources, uint8_t count, RuleUpdateError &error);
+
+    /**
+     * Grava as regras atuais na NVS.
+     */
+    bool persist();
+
+    RuleSource m_sources[RuleSet::MAX_RULES];
+    uint8_t m_count;
+    RuleSet m_staging;                  // Fora da pilha da tarefa do AsyncTCP
+    SeqLock<RuleSet> m_published;
+};
+
+#endif // RULE_STORE_H
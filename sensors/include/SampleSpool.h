@@ -0,0 +1,256 @@
+/**
+ * @file SampleSpool.h
+ * @brief Armazenamento local de amostras não enviadas (store-and-forward).
+ */
+
+#ifndef SAMPLE_SPOOL_H
+#define SAMPLE_SPOOL_H
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#include "Config.h"
+#include "DataTypes.h"
+
+/**
+ * Estatísticas do spool.
+ */
+struct SpoolStats {
+    uint16_t ramDepth;          // Amostras pendentes na RAM
+    uint32_t flashRecords;      // Amostras pendentes na flash
+    uint32_t flashBytes;        // Bytes ocupados no log da flash
+    uint32_t spilled;           // Amostras transferidas da RAM para a flash
+    uint32_t drained;           // Amostras confirmadas pela API
+    uint32_t lost;              // Descartadas por falta de espaço ou recusadas pela API
+    uint32_t segmentErases;     // Setores apagados (desgaste da flash)
+    float drainRate;            // Vazão de drenagem (amostras/s)
+    uint32_t oldestAgeMs;       // Idade da amostra pendente mais antiga (ms)
+    bool flashAvailable;        // true se a partição do spool foi encontrada
+
+    SpoolStats() : ramDepth(0), flashRecords(0), flashBytes(0), spilled(0),
+                   drained(0), lost(0), segmentErases(0), drainRate(0.0f),
+                   oldestAgeMs(0), flashAvailable(false) {}
+};
+
+/**
+ * Spool de amostras com anel em RAM e log append-only na flash.
+ *
+ * As amostras entram no anel em RAM; quando ele enche, o bloco mais antigo
+ * é transferido para um log circular em uma partição de dados, dividido em
+ * setores de 4 KB usados em rodízio (cada setor é apagado uma vez por volta,
+ * distribuindo o desgaste). A drenagem é sempre em ordem: primeiro a flash,
+ * depois a RAM. Cada lote confirmado pela API grava um registro de ACK no
+ * próprio log, de modo que após um reinício apenas amostras não confirmadas
+ * são reenviadas.
+ *
+ * Os timestamps são millis() do boot que gravou a amostra. Cada registro
+ * guarda o boot de origem (contador na NVS) e peek() nunca mistura boots
+ * em um lote, então a API recebe t0 e deltas de um único relógio.
+ *
+ * Não é thread-safe: push(), peek(), ack() e discard() devem ser chamados
+ * apenas pela tarefa de envio. getStats() pode ser chamado de qualquer tarefa.
+ */
+class SampleSpool {
+public:
+    SampleSpool();
+
+    /**
+     * Localiza a partição e reconstrói o estado a partir do log.
+     *
+     * Sem partição, o spool opera apenas em RAM.
+     *
+     * @return true se a flash está disponível.
+     */
+    bool begin();
+
+    /**
+     * Armazena uma amostra, transferindo a RAM para a flash se necessário.
+     *
+     * @param data Amostra a ser armazenada.
+     */
+    void push(const SensorData &data);
+
+    /**
+     * Copia as amostras pendentes mais antigas sem removê-las.
+     *
+     * @param out Destino das amostras.
+     * @param maxCount Capacidade do destino.
+     * @return Número de amostras copiadas.
+     */
+    size_t peek(SensorData *out, size_t maxCount);
+
+    /**
+     * @return Boot em que as amostras do último peek() foram gravadas.
+     */
+    uint32_t peekBoot() const { return m_peekBoot; }
+
+    /**
+     * @return Boot atual (contador persistido na NVS; 0 antes de begin()).
+     */
+    uint32_t bootId() const { return m_bootId; }
+
+    /**
+     * Confirma as amostras do último peek(), removendo-as do spool.
+     */
+    void ack();
+
+    /**
+     * Remove as amostras do último peek() sem entregá-las, contando-as
+     * como perdidas (lote recusado pela API).
+     */
+    void discard();
+
+    /**
+     * @return Total de amostras pendentes (RAM + flash).
+     */
+    size_t pending() const;
+
+    /**
+     * @return Número de amostras pendentes na flash.
+     */
+    size_t flashPending() const { return m_flashPending; }
+
+    /**
+     * @return Timestamp da amostra pendente mais antiga (0 se vazio), no
+     *         relógio do boot que a gravou.
+     */
+    uint32_t oldestTimestamp() const;
+
+    /**
+     * Obtém uma cópia das estatísticas.
+     *
+     * @return Estatísticas atuais.
+     */
+    SpoolStats getStats() const;
+
+private:
+    /**
+     * Registro do log na flash (16 bytes, alinhado para escrita).
+     *
+     * Registros de dados usam o serial como número de sequência da amostra;
+     * registros de ACK guardam em value o serial da última amostra confirmada.
+     * boot guarda os 8 bits menos significativos do boot de origem: o log
+     * cobre bem menos de 256 boots, então o boot completo é reconstruído a
+     * partir do atual.
+     */
+    struct SpoolRecord {
+        uint32_t serial;        // Número de sequência do registro
+        uint32_t value;         // Timestamp (dados) ou serial confirmado (ACK)
+        int16_t temperature;    // Temperatura em centésimos de °C
+        uint16_t humidity;      // Umidade em centésimos de %
+        uint8_t type;           // RECORD_DATA ou RECORD_ACK
+        uint8_t boot;           // Boot de origem (8 bits menos significativos)
+        uint16_t crc;           // CRC-16 dos 14 bytes anteriores
+    };
+    static_assert(sizeof(SpoolRecord) == 16, "SpoolRecord deve ter 16 bytes");
+
+    static const uint8_t RECORD_DATA = 0xA5;
+    static const uint8_t RECORD_ACK = 0x5A;
+    static const size_t SEGMENT_SIZE = 4096;
+    static const size_t SLOTS_PER_SEGMENT = SEGMENT_SIZE / sizeof(SpoolRecord);
+
+    // Anel em RAM
+    SensorData m_ram[SPOOL_RAM_CAPACITY];
+    size_t m_ramHead;
+    size_t m_ramCount;
+
+    // Log na flash (posições em registros)
+    const esp_partition_t *m_partition;
+    size_t m_totalSlots;
+    size_t m_readPos;
+    size_t m_writePos;
+    size_t m_flashPending;
+    uint32_t m_nextSerial;
+    uint32_t m_ackedSerial;
+    uint32_t m_flashOldestTimestamp;
+    uint8_t m_flashOldestBoot;
+    uint32_t m_bootId;
+
+    // Último peek() aguardando confirmação
+    bool m_peekFromFlash;
+    size_t m_peekCount;
+    size_t m_peekEndPos;
+    uint32_t m_peekLastSerial;
+    uint32_t m_peekBoot;
+    uint32_t m_lastAckMs;
+
+    // Contadores (apenas tarefa de envio)
+    uint32_t m_spilled;
+    uint32_t m_drained;
+    uint32_t m_lost;
+    uint32_t m_segmentErases;
+    float m_drainRate;
+
+    // Estatísticas publicadas para outras tarefas
+    SpoolStats m_stats;
+    uint32_t m_oldestTimestamp;
+    bool m_oldestPreviousBoot;
+    mutable portMUX_TYPE m_statsLock;
+
+    /**
+     * Transfere as amostras mais antigas da RAM para a flash.
+     *
+     * @param count Número de amostras a transferir.
+     */
+    void spill(size_t count);
+
+    /**
+     * Acrescenta registros ao log, preparando setores quando necessário.
+     *
+     * @return true se todos os registros foram gravados.
+     */
+    bool appendRecords(const SpoolRecord *records, size_t count);
+
+    /**
+     * Apaga um setor antes de reutilizá-lo, descartando dados não lidos nele.
+     *
+     * @param segment Índice do setor.
+     * @return true se o setor foi apagado.
+     */
+    bool prepareSegment(size_t segment);
+
+    /**
+     * Lê e valida um registro do log.
+     *
+     * @return true se o registro é válido (tipo e CRC corretos).
+     */
+    bool readRecord(size_t pos, SpoolRecord &record) const;
+
+    /**
+     * @return Número de posições entre a leitura e a escrita.
+     */
+    size_t occupiedSlots() const;
+
+    /**
+     * Avança a leitura até o próximo registro pendente e atualiza o
+     * timestamp mais antigo da flash.
+     */
+    void refreshFlashOldest();
+
+    /**
+     * Incrementa e persiste o contador de boots.
+     */
+    void loadBootId();
+
+    /**
+     * Reconstrói o boot completo a partir dos 8 bits de um registro.
+     */
+    uint32_t expandBoot(uint8_t boot) const;
+
+    /**
+     * Remove as amostras do último peek() do spool.
+     *
+     * @param delivered true se foram confirmadas pela API.
+     */
+    void release(bool delivered);
+
+    /**
+     * Publica as estatísticas para leitura por outras tarefas.
+     */
+    void updateStats();
+
+    static void fillCrc(SpoolRecord &record);
+    static uint16_t crc16(const uint8_t *data, size_t length);
+};
+
+#endif // SAMPLE_SPOOL_H
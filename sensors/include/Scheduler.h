@@ -0,0 +1,109 @@
+/**
+ * @file Scheduler.h
+ * @brief Escalonador de prazos por tarefa, acordado por tempo ou por eventos.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Config.h"
+#include "Metrics.h"
+
+/**
+ * Escalonador de jobs de uma única tarefa FreeRTOS.
+ *
+ * Cada job declara seu período e, opcionalmente, os eventos que o
+ * disparam. A tarefa dorme em xTaskNotifyWait() até o prazo mais próximo
+ * ou até outra tarefa sinalizar um evento com notify(); sem prazos
+ * pendentes, dorme indefinidamente. Entre despertares o núcleo fica ocioso,
+ * o que permite ao light sleep automático atuar.
+ *
+ * Os prazos são absolutos (esp_timer, μs) e avançam de um período por
+ * execução, sem deriva. Um job atrasado mais de um período conta como
+ * prazo perdido e é reagendado a partir do instante atual, sem rajadas.
+ *
+ * Deve ser construído na própria tarefa que chamará run(); addJob() vem
+ * antes de run() e notify() pode ser chamado de qualquer tarefa.
+ */
+class Scheduler {
+public:
+    /**
+     * Função de um job.
+     *
+     * @param context Contexto informado em addJob().
+     * @return Atraso até a próxima execução (ms); 0 mantém o período
+     *         declarado e SUSPEND aguarda apenas eventos.
+     */
+    typedef uint32_t (*JobFunction)(void *context);
+
+    static constexpr uint32_t SUSPEND = 0xFFFFFFFF;   // Retorno: dorme até um evento
+    static constexpr int INVALID_JOB = -1;
+
+    /**
+     * Construtor.
+     *
+     * @param name Nome da tarefa, usado nos logs (literal).
+     * @param metrics Métricas de despertar da tarefa.
+     */
+    Scheduler(const char *name, const Metrics::TaskMetrics &metrics);
+
+    /**
+     * Registra um job.
+     *
+     * @param name Nome do job (literal).
+     * @param period Período (ms); 0 executa apenas por eventos ou atrasos pedidos.
+     * @param function Função do job.
+     * @param context Contexto repassado à função.
+     * @param events Máscara de eventos que disparam o job imediatamente.
+     * @param initialDelay Atraso da primeira execução (ms).
+     * @return Índice do job, ou INVALID_JOB se a tabela está cheia.
+     */
+    int addJob(const char *name, uint32_t period, JobFunction function, void *context = nullptr,
+               uint32_t events = 0, uint32_t initialDelay = 0);
+
+    /**
+     * Executa os jobs da tarefa atual; não retorna.
+     */
+    void run();
+
+    /**
+     * Sinaliza eventos para a tarefa do escalonador.
+     *
+     * Os bits se acumulam na notificação da tarefa; eventos sinalizados
+     * antes de run() são tratados no primeiro despertar.
+     *
+     * @param events Máscara de eventos.
+     */
+    void notify(uint32_t events);
+
+private:
+    static constexpr int64_t NEVER = INT64_MAX;
+
+    struct Job {
+        const char *name;
+        JobFunction function;
+        void *context;
+        uint32_t events;
+        int64_t periodUs;
+        int64_t deadline;           // Próximo prazo absoluto (μs), ou NEVER
+    };
+
+    /**
+     * Executa os jobs vencidos ou disparados pelos eventos.
+     *
+     * @param events Eventos recebidos neste despertar.
+     * @return Prazo mais próximo após as execuções.
+     */
+    int64_t dispatch(uint32_t events);
+
+    const char *m_name;
+    const Metrics::TaskMetrics &m_metrics;
+    TaskHandle_t m_task;
+    Job m_jobs[SCHEDULER_MAX_JOBS];
+    size_t m_jobCount;
+};
+
+#endif // SCHEDULER_H
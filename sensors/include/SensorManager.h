@@ -12,6 +12,21 @@
 #include "Hardware.h"
 #include "MemoryManager.h"
 #include "TelemetryBuffer.h"
+#include "SeqLock.h"
+#include "SensorPipeline.h"
+
+/**
+ * Snapshot publicado pela tarefa de sensores.
+ *
+ * Reúne os dados processados e a telemetria correspondente para que
+ * leitores em outros núcleos obtenham uma visão consistente sem mutex.
+ */
+struct SensorSnapshot {
+    SensorData data;            // Dados processados dos sensores
+    TelemetryBuffer telemetry;  // Telemetria preparada no momento da publicação
+    uint32_t sampleSequence;    // Aquisição do DHT22 refletida nos dados (getSampleSequence())
+    uint32_t sampleTime;        // Instante da última aquisição bem-sucedida do DHT22 (ms)
+};
 
 /**
  * Gerenciador de sensores
@@ -32,28 +47,87 @@ private:
     // Contadores
     uint16_t m_readCount;
 
-    // Filtro de média móvel para sensores analógicos
+    // Snapshot publicado para leitores sem bloqueio (escritor: tarefa de sensores)
+    SeqLock<SensorSnapshot> m_snapshot;
+
+public:
+    // Média móvel das leituras do DHT22: janela e resolução do ponto fixo
     static constexpr uint8_t FILTER_SIZE = 5;
-    uint16_t m_moistureReadings[FILTER_SIZE];
-    uint8_t m_filterIndex;
+    static constexpr int32_t FILTER_SCALE = 100;    // Centésimos de °C e de %
+
+    // Rejeição de picos: janela, limiar em desvios robustos e desvio mínimo
+    static constexpr uint8_t OUTLIER_WINDOW = 7;
+    static constexpr uint8_t OUTLIER_SIGMA = 3;
+    static constexpr int32_t OUTLIER_FLOOR_TEMPERATURE = 50;   // 0,5 °C
+    static constexpr int32_t OUTLIER_FLOOR_HUMIDITY = 200;     // 2 %
+
+    // Taxa considerada significativa: acima deste múltiplo do seu desvio-padrão
+    static constexpr float TREND_SIGNIFICANCE = 2.0f;
 
     /**
-     * Aplica um filtro de média móvel às leituras analógicas.
-     *
-     * @param readings Array de leituras históricas.
-     * @param newValue Novo valor a ser adicionado.
-     * @return Média dos valores no buffer.
+     * Modelos de tendência (variâncias do filtro de Kalman) de cada canal.
+     */
+    struct TemperatureTrendModel {
+        static constexpr float MEASUREMENT_NOISE = 0.01f;       // Ruído do DHT22: 0,1 °C
+        static constexpr float RATE_NOISE = 0.25f;              // Taxa muda ~0,5 °C/min por minuto
+        static constexpr float INITIAL_RATE_VARIANCE = 1.0f;
+    };
+
+    struct HumidityTrendModel {
+        static constexpr float MEASUREMENT_NOISE = 0.25f;       // Ruído do DHT22: 0,5 %
+        static constexpr float RATE_NOISE = 1.0f;               // Taxa muda ~1 %/min por minuto
+        static constexpr float INITIAL_RATE_VARIANCE = 4.0f;
+    };
+
+    /**
+     * Correção da temperatura medida contra uma referência.
      */
-    uint16_t applyFilter(uint16_t readings[], uint16_t newValue);
+    struct TemperatureCalibration {
+        static constexpr float GAIN = 1.0f;         // Sem correção por enquanto
+        static constexpr float OFFSET = 0.0f;
+    };
+
+    // Cadeias de processamento de cada canal do DHT22
+    typedef Hampel<OUTLIER_WINDOW, OUTLIER_SIGMA, OUTLIER_FLOOR_TEMPERATURE, FILTER_SCALE> TemperatureOutliers;
+    typedef Hampel<OUTLIER_WINDOW, OUTLIER_SIGMA, OUTLIER_FLOOR_HUMIDITY, FILTER_SCALE> HumidityOutliers;
+
+    typedef Pipeline<RangeGate<-40, 80>,
+                     TemperatureOutliers,
+                     Calibrate<TemperatureCalibration>,
+                     Clamp<-40, 80>,
+                     KalmanTrend<TemperatureTrendModel>,
+                     MovingAverage<FILTER_SIZE, FILTER_SCALE>> TemperaturePipeline;
+    typedef Pipeline<RangeGate<0, 100>,
+                     HumidityOutliers,
+                     KalmanTrend<HumidityTrendModel>,
+                     MovingAverage<FILTER_SIZE, FILTER_SCALE>> HumidityPipeline;
+
+    // Posição dos estágios consultados: Hampel nas duas cadeias e tendência em cada uma
+    static constexpr size_t OUTLIER_STAGE = 1;
+    static constexpr size_t TEMPERATURE_TREND_STAGE = 4;
+    static constexpr size_t HUMIDITY_TREND_STAGE = 2;
 
     /**
-     * Aplica um filtro de média móvel às leituras de ponto flutuante do DHT22.
+     * Relógio em ms usado pelo estimador de tendência.
+     */
+    typedef uint32_t (*Clock)();
+
+    /**
+     * Estado das cadeias do DHT22, preservado entre ciclos do modo de campo.
      *
-     * @param readings Array de leituras históricas.
-     * @param newValue Novo valor a ser adicionado.
-     * @return Média dos valores no buffer.
+     * Trivial: zerado por memset equivale a cadeias recém-iniciadas.
      */
-    float applyFilter(float readings[], float newValue);
+    struct FilterState {
+        TemperaturePipeline temperature;
+        HumidityPipeline humidity;
+    };
+
+private:
+    FilterState m_filter;
+    uint32_t m_lastDhtSample;   // Contador de aquisições do DHT22 já processadas
+    uint32_t m_lastSampleTime;  // Instante da última aquisição processada (ms)
+    bool m_sampleAccepted;      // Última aquisição aceita pelas duas cadeias
+    Clock m_clock;
 
     /**
      * Verifica mudanças nos sensores digitais e gera eventos.
@@ -62,8 +136,10 @@ private:
 
     /**
      * Realiza as leituras dos sensores.
+     *
+     * @return true se uma aquisição nova do DHT22 foi aceita pelas duas cadeias.
      */
-    void readSensors();
+    bool readSensors();
 
     /**
      * Processa os dados brutos para unidades físicas.
@@ -88,6 +164,9 @@ public:
     /**
      * Atualiza os sensores se o intervalo adequado tiver passado.
      *
+     * Publica um novo snapshot a cada leitura; deve ser chamado apenas
+     * pela tarefa de sensores, que é o escritor único do snapshot.
+     *
      * @param forceUpdate Force atualização mesmo sem intervalo.
      * @return true se os sensores foram atualizados.
      */
@@ -117,11 +196,15 @@ public:
     bool getDataJson(char *buffer, size_t size) const;
 
     /**
-     * Verifica se um sensor específico mudou de estado.
+     * Verifica se um sensor está variando de forma significativa.
+     *
+     * Usa a taxa do estimador de tendência: exige que ela passe do limiar
+     * e de TREND_SIGNIFICANCE vezes a sua incerteza, para que o ruído de
+     * uma leitura isolada não conte como mudança.
      *
-     * @param sensorType Tipo de sensor (0=PH, 1=Moisture, 2=Phosphorus, 3=Potassium)
-     * @param threshold Limiar para considerar mudança (para sensores analógicos)
-     * @return true se o sensor mudou além do threshold.
+     * @param sensorType Tipo de sensor (0=umidade, 1=temperatura)
+     * @param threshold Taxa mínima, em unidades por minuto (% ou °C).
+     * @return true se o sensor varia mais rápido que o threshold.
      */
     bool sensorChanged(uint8_t sensorType, float threshold = 0.5f) const;
 
@@ -134,6 +217,83 @@ public:
      * @return Buffer de telemetria preenchido com dados atuais
      */
     TelemetryBuffer prepareTelemetry();
+
+    /**
+     * Publica o snapshot atual de dados e telemetria.
+     *
+     * Deve ser chamado apenas pela tarefa de sensores (escritor único).
+     */
+    void publishSnapshot();
+
+    /**
+     * Obtém uma cópia consistente do último snapshot publicado.
+     *
+     * Pode ser chamado de qualquer tarefa ou núcleo sem adquirir mutex.
+     *
+     * @param snapshot Destino da cópia.
+     * @return Número de sequência do snapshot (incrementa a cada publicação).
+     */
+    uint32_t getSnapshot(SensorSnapshot &snapshot) const;
+
+    /**
+     * Obtém o número de leituras de snapshot repetidas por concorrência.
+     *
+     * @return Total de repetições desde o boot.
+     */
+    uint32_t getSnapshotRetryCount() const;
+
+    /**
+     * Obtém o número de picos descartados pelo filtro de Hampel.
+     *
+     * @param humidity true para o canal de umidade, false para temperatura.
+     * @return Amostras descartadas desde o boot (ou o boot a frio, no modo de campo).
+     */
+    uint32_t getOutlierCount(bool humidity) const;
+
+    /**
+     * Obtém o número de aquisições do DHT22 que já passaram pelas cadeias.
+     *
+     * Muda a cada amostra nova; leituras entre aquisições repetem o valor.
+     *
+     * @return Sequência da última amostra processada.
+     */
+    uint32_t getSampleSequence() const;
+
+    /**
+     * Indica se a última aquisição processada foi aceita pelas duas cadeias.
+     *
+     * Sem nenhuma aceita, getData() ainda traz os valores padrão do
+     * construtor; o modo de campo não os registra como leitura.
+     *
+     * @return true se temperatura e umidade vieram da última aquisição.
+     */
+    bool isSampleAccepted() const;
+
+    /**
+     * Substitui o relógio do estimador de tendência (padrão: millis()).
+     *
+     * O modo de campo usa um relógio que continua contando no deep sleep.
+     *
+     * @param clock Função que retorna o tempo em ms.
+     */
+    void setClock(Clock clock);
+
+    /**
+     * Copia o estado das cadeias de temperatura e umidade.
+     *
+     * @param state Destino da cópia.
+     */
+    void getFilterState(FilterState &state) const;
+
+    /**
+     * Restaura o estado das cadeias salvo por getFilterState().
+     *
+     * Deve ser chamado antes de init(), cuja leitura inicial já passa
+     * pelas cadeias.
+     *
+     * @param state Estado a restaurar.
+     */
+    void setFilterState(const FilterState &state);
 };
 
 #endif // SENSOR_MANAGER_H
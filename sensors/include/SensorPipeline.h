@@ -0,0 +1,447 @@
+/**
+ * @file SensorPipeline.h
+ * @brief Cadeia de processamento de sensores montada em tempo de compilação.
+ *
+ * Não depende do Arduino, para que bench/pipeline_bench.cpp meça as
+ * cadeias no host com os mesmos estágios.
+ */
+
+#ifndef SENSOR_PIPELINE_H
+#define SENSOR_PIPELINE_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "RingFilter.h"
+
+/**
+ * Cadeia de estágios aplicada a cada amostra de um canal.
+ *
+ * Cada estágio é uma classe com dois métodos não virtuais:
+ *
+ *     bool process(float &value);  // Transforma o valor; false descarta a amostra
+ *     void reset();                // Volta ao estado inicial
+ *
+ * A cadeia é resolvida por templates: o compilador expande process() em
+ * código linear, sem chamadas virtuais nem alocação. A primeira rejeição
+ * interrompe a cadeia e o canal mantém a última saída aceita.
+ *
+ * Todos os estágios devem ser triviais (sem construtor), para que o estado
+ * da cadeia possa ser copiado ou guardado na memória RTC; reset() ou
+ * memset com zero levam ao estado inicial.
+ *
+ * Exemplo:
+ *
+ *     typedef Pipeline<RangeGate<-40, 80>, Hampel<7, 3, 50>, MovingAverage<5, 100>> Canal;
+ */
+template <typename... Stages>
+class Pipeline;
+
+template <size_t I, typename P>
+struct PipelineStage;
+
+/**
+ * Fim da cadeia: aceita o valor sem alteração.
+ */
+template <>
+class Pipeline<> {
+public:
+    void reset() {}
+    bool process(float &) { return true; }
+};
+
+template <typename First, typename... Rest>
+class Pipeline<First, Rest...> {
+public:
+    /**
+     * Reinicia todos os estágios.
+     */
+    void reset() {
+        m_first.reset();
+        m_rest.reset();
+    }
+
+    /**
+     * Passa uma amostra pelos estágios, em ordem.
+     *
+     * @param value Amostra de entrada; na saída, o valor processado.
+     * @return false se algum estágio descartou a amostra.
+     */
+    bool process(float &value) {
+        return m_first.process(value) && m_rest.process(value);
+    }
+
+    /**
+     * Acesso ao estágio de índice I, para consulta de estado e estatísticas.
+     */
+    template <size_t I>
+    typename PipelineStage<I, Pipeline>::type &stage() {
+        return PipelineStage<I, Pipeline>::get(*this);
+    }
+
+    template <size_t I>
+    const typename PipelineStage<I, Pipeline>::type &stage() const {
+        return PipelineStage<I, Pipeline>::get(*this);
+    }
+
+private:
+    template <size_t, typename> friend struct PipelineStage;
+
+    First m_first;
+    Pipeline<Rest...> m_rest;
+};
+
+/**
+ * Localiza o estágio de índice I de uma cadeia.
+ */
+template <size_t I, typename First, typename... Rest>
+struct PipelineStage<I, Pipeline<First, Rest...>> {
+    typedef PipelineStage<I - 1, Pipeline<Rest...>> Next;
+    typedef typename Next::type type;
+
+    static type &get(Pipeline<First, Rest...> &pipeline) { return Next::get(pipeline.m_rest); }
+    static const type &get(const Pipeline<First, Rest...> &pipeline) { return Next::get(pipeline.m_rest); }
+};
+
+template <typename First, typename... Rest>
+struct PipelineStage<0, Pipeline<First, Rest...>> {
+    typedef First type;
+
+    static type &get(Pipeline<First, Rest...> &pipeline) { return pipeline.m_first; }
+    static const type &get(const Pipeline<First, Rest...> &pipeline) { return pipeline.m_first; }
+};
+
+/**
+ * Descarta amostras fora da faixa [Min, Max] e valores não numéricos.
+ */
+template <int Min, int Max>
+class RangeGate {
+    static_assert(Min < Max, "RangeGate exige Min < Max");
+
+public:
+    void reset() {}
+
+    bool process(float &value) {
+        // Comparações com NaN são falsas: NaN também é descartado
+        return value >= static_cast<float>(Min) && value <= static_cast<float>(Max);
+    }
+};
+
+/**
+ * Limita o valor à faixa [Min, Max] sem descartar a amostra.
+ */
+template <int Min, int Max>
+class Clamp {
+    static_assert(Min < Max, "Clamp exige Min < Max");
+
+public:
+    void reset() {}
+
+    bool process(float &value) {
+        if (value < static_cast<float>(Min)) {
+            value = static_cast<float>(Min);
+        } else if (value > static_cast<float>(Max)) {
+            value = static_cast<float>(Max);
+        }
+        return true;
+    }
+};
+
+/**
+ * Correção linear de calibração.
+ *
+ * Table declara os coeficientes obtidos contra uma referência:
+ *
+ *     struct Tabela {
+ *         static constexpr float GAIN = 1.0f;
+ *         static constexpr float OFFSET = 0.0f;
+ *     };
+ */
+template <typename Table>
+class Calibrate {
+public:
+    void reset() {}
+
+    bool process(float &value) {
+        value = value * Table::GAIN + Table::OFFSET;
+        return true;
+    }
+};
+
+/**
+ * Filtro de Hampel: descarta picos isolados que ainda estão na faixa válida.
+ *
+ * Compara cada amostra com a mediana das últimas N e a descarta se o
+ * desvio passar de Sigma desvios-padrão robustos (1,4826 × MAD), nunca
+ * menos que Floor. O piso evita descartar variações reais quando a janela
+ * é constante e o MAD é zero, o que é comum com a resolução de 0,1 do DHT22.
+ *
+ * A janela é um anel em ordem de chegada acompanhado de uma cópia ordenada
+ * em ponto fixo: a posição de remoção e de inserção vem de busca binária
+ * (O(log N)) e o deslocamento é de no máximo N inteiros. O MAD sai da
+ * intercalação dos dois lados da mediana, que já estão ordenados.
+ *
+ * Amostras descartadas também entram na janela: um degrau real passa a
+ * ser aceito depois de N/2 + 1 amostras, enquanto um pico isolado nunca
+ * move a mediana. Até a janela ter N/2 + 1 amostras, tudo é aceito.
+ *
+ * @tparam N Janela (ímpar, 3 a 255).
+ * @tparam Sigma Limiar em desvios-padrão robustos.
+ * @tparam Floor Desvio mínimo para descarte, em 1/Scale da unidade.
+ * @tparam Scale Unidades inteiras por unidade da grandeza.
+ */
+template <uint8_t N, uint8_t Sigma, int32_t Floor, int32_t Scale = 100>
+class Hampel {
+    static_assert(N >= 3 && N % 2 == 1, "Hampel exige janela ímpar de pelo menos 3 amostras");
+    static_assert(Floor >= 0 && Scale > 0, "Hampel exige piso não negativo e escala positiva");
+
+public:
+    void reset() {
+        m_index = 0;
+        m_count = 0;
+        m_rejected = 0;
+    }
+
+    bool process(float &value) {
+        int32_t sample = static_cast<int32_t>(lroundf(value * Scale));
+        bool accept = true;
+
+        if (m_count > N / 2) {
+            int32_t center = median();
+            int32_t deviation = sample >= center ? sample - center : center - sample;
+            float limit = Sigma * MAD_TO_SIGMA * mad(center);
+            accept = deviation <= Floor || deviation <= limit;
+        }
+
+        insert(sample);
+
+        if (!accept) {
+            m_rejected++;
+        }
+        return accept;
+    }
+
+    /**
+     * @return Amostras descartadas desde o último reset().
+     */
+    uint32_t rejected() const { return m_rejected; }
+
+    /**
+     * @return true quando a janela está completa.
+     */
+    bool ready() const { return m_count == N; }
+
+private:
+    // Converte o MAD no desvio-padrão de uma distribuição normal
+    static constexpr float MAD_TO_SIGMA = 1.4826f;
+
+    /**
+     * Posição da primeira amostra ordenada maior que value.
+     */
+    uint8_t upperBound(int32_t value) const {
+        uint8_t low = 0;
+        uint8_t high = m_count;
+        while (low < high) {
+            uint8_t mid = (low + high) / 2;
+            if (m_sorted[mid] <= value) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * Acrescenta uma amostra, retirando a mais antiga com a janela cheia.
+     */
+    void insert(int32_t sample) {
+        if (m_count == N) {
+            // A última ocorrência do valor mais antigo fica antes do upperBound
+            uint8_t pos = upperBound(m_ring[m_index]) - 1;
+            memmove(&m_sorted[pos], &m_sorted[pos + 1], sizeof(int32_t) * (m_count - pos - 1));
+            m_count--;
+        }
+
+        uint8_t pos = upperBound(sample);
+        memmove(&m_sorted[pos + 1], &m_sorted[pos], sizeof(int32_t) * (m_count - pos));
+        m_sorted[pos] = sample;
+        m_count++;
+
+        m_ring[m_index] = sample;
+        if (++m_index == N) {
+            m_index = 0;
+        }
+    }
+
+    /**
+     * Mediana das amostras na janela (m_count > 0).
+     */
+    int32_t median() const {
+        uint8_t mid = m_count / 2;
+        return (m_count & 1) ? m_sorted[mid] : (m_sorted[mid - 1] + m_sorted[mid]) / 2;
+    }
+
+    /**
+     * Mediana dos desvios absolutos em relação a center.
+     *
+     * Os desvios crescem para os dois lados da mediana; basta intercalar
+     * os lados até a posição central.
+     */
+    int32_t mad(int32_t center) const {
+        int16_t left = static_cast<int16_t>(upperBound(center)) - 1;
+        int16_t right = left + 1;
+        int32_t deviation = 0;
+
+        for (uint8_t k = 0; k <= (m_count - 1) / 2; k++) {
+            if (right >= m_count || (left >= 0 && center - m_sorted[left] <= m_sorted[right] - center)) {
+                deviation = center - m_sorted[left--];
+            } else {
+                deviation = m_sorted[right++] - center;
+            }
+        }
+        return deviation;
+    }
+
+    int32_t m_ring[N];          // Amostras em ordem de chegada
+    int32_t m_sorted[N];        // As mesmas amostras, ordenadas
+    uint8_t m_index;            // Próxima posição do anel
+    uint8_t m_count;
+    uint32_t m_rejected;
+};
+
+/**
+ * Estimador de nível e tendência por filtro de Kalman de velocidade constante.
+ *
+ * Não altera a amostra: acompanha o nível, a taxa de variação (unidades
+ * por minuto) e a incerteza de ambos, em tempo constante por amostra. O
+ * intervalo entre amostras vem de setTime(), chamado antes de process(),
+ * e pode variar (ex.: ciclos de deep sleep). Depois de MAX_GAP_MS sem
+ * amostras, o estimador recomeça.
+ *
+ * Model declara as variâncias do modelo:
+ *
+ *     struct Modelo {
+ *         static constexpr float MEASUREMENT_NOISE = 0.01f;   // Da leitura (unidade²)
+ *         static constexpr float RATE_NOISE = 0.25f;          // Da taxa ((unidade/min)² por minuto)
+ *         static constexpr float INITIAL_RATE_VARIANCE = 1.0f; // Da taxa inicial ((unidade/min)²)
+ *     };
+ */
+template <typename Model>
+class KalmanTrend {
+public:
+    // Intervalo máximo entre amostras antes de recomeçar (1 h)
+    static constexpr uint32_t MAX_GAP_MS = 3600000;
+
+    void reset() {
+        m_level = 0.0f;
+        m_rate = 0.0f;
+        m_p00 = 0.0f;
+        m_p01 = 0.0f;
+        m_p11 = 0.0f;
+        m_last = 0;
+        m_now = 0;
+        m_initialized = false;
+    }
+
+    /**
+     * Define o instante da próxima amostra.
+     *
+     * @param nowMs Tempo em ms de um relógio monotônico.
+     */
+    void setTime(uint32_t nowMs) { m_now = nowMs; }
+
+    bool process(float &value) {
+        uint32_t elapsed = m_now - m_last;
+        m_last = m_now;
+
+        if (!m_initialized || elapsed > MAX_GAP_MS) {
+            m_level = value;
+            m_rate = 0.0f;
+            m_p00 = Model::MEASUREMENT_NOISE;
+            m_p01 = 0.0f;
+            m_p11 = Model::INITIAL_RATE_VARIANCE;
+            m_initialized = true;
+            return true;
+        }
+
+        // Predição: x = F·x, P = F·P·Fᵀ + Q (aceleração como ruído branco)
+        float dt = elapsed / 60000.0f;
+        float q = Model::RATE_NOISE;
+        m_level += m_rate * dt;
+        m_p00 += dt * (2.0f * m_p01 + dt * m_p11) + q * dt * dt * dt / 3.0f;
+        m_p01 += dt * m_p11 + q * dt * dt / 2.0f;
+        m_p11 += q * dt;
+
+        // Correção com a leitura (H = [1 0])
+        float innovation = value - m_level;
+        float s = m_p00 + Model::MEASUREMENT_NOISE;
+        float k0 = m_p00 / s;
+        float k1 = m_p01 / s;
+
+        m_level += k0 * innovation;
+        m_rate += k1 * innovation;
+        m_p11 -= k1 * m_p01;
+        m_p00 -= k0 * m_p00;
+        m_p01 -= k0 * m_p01;
+
+        return true;
+    }
+
+    /**
+     * @return Nível estimado.
+     */
+    float level() const { return m_initialized ? m_level : 0.0f; }
+
+    /**
+     * @return Taxa de variação estimada (unidades por minuto).
+     */
+    float rate() const { return m_initialized ? m_rate : 0.0f; }
+
+    /**
+     * @return Desvio-padrão da taxa (unidades por minuto).
+     */
+    float rateSigma() const { return m_initialized ? sqrtf(m_p11) : 0.0f; }
+
+    /**
+     * @return Desvio-padrão do nível (unidades).
+     */
+    float levelSigma() const { return m_initialized ? sqrtf(m_p00) : 0.0f; }
+
+private:
+    float m_level;
+    float m_rate;
+    float m_p00;                // Covariância do erro [nível, taxa]
+    float m_p01;
+    float m_p11;
+    uint32_t m_last;            // Instante da última amostra (ms)
+    uint32_t m_now;             // Instante da amostra em processamento (ms)
+    bool m_initialized;
+};
+
+/**
+ * Média móvel de N amostras em ponto fixo (ver FixedRingFilter).
+ */
+template <uint8_t N, int32_t Scale>
+class MovingAverage {
+public:
+    void reset() {
+        m_filter.reset();
+    }
+
+    bool process(float &value) {
+        value = m_filter.update(value);
+        return true;
+    }
+
+    /**
+     * @return true quando a janela está completa.
+     */
+    bool ready() const { return m_filter.ready(); }
+
+private:
+    FixedRingFilter<N, Scale> m_filter;
+};
+
+#endif // SENSOR_PIPELINE_H
@@ -0,0 +1,115 @@
+/**
+ * @file SeqLock.h
+ * @brief Snapshot sem bloqueio com um escritor e múltiplos leitores.
+ */
+
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <string.h>
+#include <stdint.h>
+#include <atomic>
+#include <type_traits>
+
+// Fora do ESP-IDF (bench/seqlock_bench.cpp no host) o leitor cede a CPU
+// pela biblioteca padrão
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define SEQ_LOCK_YIELD() vTaskDelay(1)
+#else
+#include <thread>
+#define SEQ_LOCK_YIELD() std::this_thread::yield()
+#endif
+
+/**
+ * Seqlock para publicação de estruturas entre núcleos.
+ *
+ * Um único escritor publica cópias completas de T; qualquer número de
+ * leitores obtém uma cópia consistente sem adquirir mutex. O contador de
+ * sequência é ímpar durante a escrita e o leitor repete a cópia se a
+ * sequência mudou no meio da leitura.
+ *
+ * @tparam T Tipo trivialmente copiável a ser publicado.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqLock exige um tipo trivialmente copiável");
+
+public:
+    SeqLock() : m_sequence(0), m_retries(0) {}
+
+    /**
+     * Publica um novo valor. Deve ser chamado por um único escritor.
+     *
+     * @param value Valor a ser publicado.
+     */
+    void write(const T &value) {
+        uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+
+        // Sequência ímpar sinaliza escrita em andamento
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        memcpy(static_cast<void *>(&m_value), &value, sizeof(T));
+
+        std::atomic_thread_fence(std::memory_order_release);
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Obtém uma cópia consistente do último valor publicado.
+     *
+     * @param out Destino da cópia.
+     * @return Número de publicações realizadas até a cópia obtida.
+     */
+    uint32_t read(T &out) const {
+        uint16_t attempts = 0;
+
+        while (true) {
+            uint32_t before = m_sequence.load(std::memory_order_acquire);
+
+            if ((before & 1) == 0) {
+                memcpy(static_cast<void *>(&out), &m_value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (m_sequence.load(std::memory_order_relaxed) == before) {
+                    return before / 2;
+                }
+            }
+
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+
+            // Se o escritor foi preemptado no mesmo núcleo, cede a CPU
+            // para que ele conclua a escrita em vez de girar indefinidamente
+            if (++attempts >= SPIN_LIMIT) {
+                attempts = 0;
+                SEQ_LOCK_YIELD();
+            }
+        }
+    }
+
+    /**
+     * Obtém o número de publicações realizadas.
+     */
+    uint32_t getSequence() const {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+    /**
+     * Obtém o número de leituras repetidas por concorrência com o escritor.
+     */
+    uint32_t getRetryCount() const {
+        return m_retries.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint16_t SPIN_LIMIT = 64;
+
+    std::atomic<uint32_t> m_sequence;
+    mutable std::atomic<uint32_t> m_retries;
+    T m_value;
+};
+
+#endif // SEQ_LOCK_H
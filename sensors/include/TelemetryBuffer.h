@@ -11,6 +11,67 @@
 #include "Config.h"
 #include "StringUtils.h"
 
+// Versão do formato binário de telemetria (incrementar ao mudar o layout)
+#define TELEMETRY_FRAME_VERSION   3
+#define TELEMETRY_FRAME_FULL      1   // Quadro completo com todos os campos
+#define TELEMETRY_FRAME_DELTA     2   // Apenas os campos indicados na máscara
+
+// Identificadores de campo (bits da máscara, na ordem do TelemetryFrame)
+#define TELEMETRY_FIELD_CLIENTS        (1u << 0)
+#define TELEMETRY_FIELD_TIMESTAMP      (1u << 1)
+#define TELEMETRY_FIELD_READ_COUNT     (1u << 2)
+#define TELEMETRY_FIELD_TEMPERATURE    (1u << 3)
+#define TELEMETRY_FIELD_HUMIDITY       (1u << 4)
+#define TELEMETRY_FIELD_FREE_HEAP      (1u << 5)
+#define TELEMETRY_FIELD_UPTIME         (1u << 6)
+#define TELEMETRY_FIELD_IP_ADDRESS     (1u << 7)
+#define TELEMETRY_FIELD_FRAGMENTATION  (1u << 8)
+#define TELEMETRY_FIELD_WIFI_RSSI      (1u << 9)
+#define TELEMETRY_FIELD_CPU_LOAD       (1u << 10)
+#define TELEMETRY_FIELD_TREND          (1u << 11)
+#define TELEMETRY_FIELDS_ALL           0x0FFFu
+#define TELEMETRY_FIELD_COUNT          12
+
+// Maior quadro delta: cabeçalho (versão, tipo, máscara) + todos os campos
+#define TELEMETRY_DELTA_MAX_SIZE       (4 + 38)
+
+/**
+ * @struct TelemetryFrame
+ * @brief Quadro binário de telemetria enviado via WebSocket.
+ *
+ * Layout fixo, empacotado e little-endian (nativo do ESP32), decodificado
+ * na página com DataView. Offsets em bytes:
+ *   0 version, 1 type, 2 clients, 4 timestamp, 8 readCount,
+ *  12 temperature, 14 humidity, 16 freeHeap, 20 uptime, 24 ipAddress[4],
+ *  28 heapFragmentation, 29 wifiRssi, 30 cpuLoad[2], 32 temperatureRate,
+ *  34 humidityRate, 36 temperatureRateSigma, 38 humidityRateSigma.
+ *
+ * O quadro delta (TELEMETRY_FRAME_DELTA) tem version, type, uma máscara
+ * uint16 com os TELEMETRY_FIELD_* presentes e, em seguida, apenas esses
+ * campos, na mesma ordem e tamanho do quadro completo.
+ */
+struct __attribute__((packed)) TelemetryFrame {
+    uint8_t version;            ///< TELEMETRY_FRAME_VERSION
+    uint8_t type;               ///< Tipo do quadro (TELEMETRY_FRAME_FULL)
+    uint16_t clients;           ///< Clientes WebSocket conectados
+    uint32_t timestamp;         ///< Timestamp em milissegundos desde o boot
+    uint32_t readCount;         ///< Contador de leituras
+    int16_t temperature;        ///< Temperatura em centésimos de °C
+    uint16_t humidity;          ///< Umidade em centésimos de %
+    uint32_t freeHeap;          ///< Heap livre em bytes
+    uint32_t uptime;            ///< Tempo de atividade em segundos
+    uint8_t ipAddress[4];       ///< Endereço IP
+    uint8_t heapFragmentation;  ///< Fragmentação do heap em percentual
+    int8_t wifiRssi;            ///< Força do sinal WiFi em dBm
+    uint8_t cpuLoad[2];         ///< Carga de cada núcleo em percentual
+    int16_t temperatureRate;    ///< Tendência da temperatura em centésimos de °C/min
+    int16_t humidityRate;       ///< Tendência da umidade em centésimos de %/min
+    uint16_t temperatureRateSigma; ///< Desvio-padrão da tendência da temperatura (centésimos de °C/min)
+    uint16_t humidityRateSigma; ///< Desvio-padrão da tendência da umidade (centésimos de %/min)
+};
+
+static_assert(sizeof(TelemetryFrame) == 40, "Layout do TelemetryFrame alterado");
+
 /**
  * @struct TelemetryBuffer
  * @brief Estrutura unificada para armazenamento e transmissão de dados de telemetria.
@@ -23,12 +84,17 @@ struct TelemetryBuffer {
     // Dados dos sensores
     float temperature;       ///< Temperatura em graus Celsius
     float humidity;          ///< Umidade relativa do ar em percentual (0-100%)
+    float temperatureRate;   ///< Tendência da temperatura (°C/min)
+    float temperatureRateSigma; ///< Desvio-padrão da tendência da temperatura (°C/min)
+    float humidityRate;      ///< Tendência da umidade (%/min)
+    float humidityRateSigma; ///< Desvio-padrão da tendência da umidade (%/min)
 
     // Estatísticas do sistema
     uint32_t freeHeap;             ///< Heap livre em bytes
     uint16_t heapFragmentation;    ///< Fragmentação do heap em percentual
     uint32_t uptime;               ///< Tempo de atividade em segundos
     uint32_t wifiRssi;             ///< Força do sinal WiFi em dBm
+    uint8_t cpuLoad[2];            ///< Carga de cada núcleo em percentual
 
     // Metadados
     uint32_t timestamp;       ///< Timestamp em milissegundos desde o boot
@@ -58,6 +124,15 @@ struct TelemetryBuffer {
      */
     void toJson(JsonObject& json) const;
 
+    /**
+     * @brief Acrescenta a tendência dos sensores a um objeto JSON.
+     *
+     * Cria "trend" com [taxa, desvio-padrão] por canal, em unidades por minuto.
+     *
+     * @param sensors Objeto "sensors" de destino
+     */
+    void trendToJson(JsonObject& sensors) const;
+
     /**
      * @brief Converte o buffer para string formatada para console.
      *
@@ -67,6 +142,32 @@ struct TelemetryBuffer {
      * @return Ponteiro para o buffer preenchido
      */
     char* toConsoleString(char* buffer, size_t bufferSize, TelemetryType type) const;
+
+    /**
+     * @brief Serializa o buffer para o quadro binário compacto.
+     *
+     * @param frame Quadro de destino
+     * @param clients Número de clientes WebSocket conectados
+     */
+    void toBinary(TelemetryFrame& frame, uint16_t clients) const;
+
+    /**
+     * @brief Serializa apenas os campos indicados em um quadro delta.
+     *
+     * @param buffer Destino (ao menos TELEMETRY_DELTA_MAX_SIZE bytes)
+     * @param fields Máscara de campos TELEMETRY_FIELD_*
+     * @param clients Número de clientes WebSocket conectados
+     * @return Tamanho do quadro em bytes
+     */
+    size_t toBinaryDelta(uint8_t* buffer, uint16_t fields, uint16_t clients) const;
+
+    /**
+     * @brief Calcula o tamanho de um quadro delta.
+     *
+     * @param fields Máscara de campos TELEMETRY_FIELD_*
+     * @return Tamanho do quadro em bytes
+     */
+    static size_t binaryDeltaSize(uint16_t fields);
 };
 
 #endif // TELEMETRY_BUFFER_H
\ No newline at end of file
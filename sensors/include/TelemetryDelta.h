@@ -0,0 +1,53 @@
+/**
+ * @file TelemetryDelta.h
+ * @brief Rastreamento de campos alterados para telemetria incremental.
+ */
+
+#ifndef TELEMETRY_DELTA_H
+#define TELEMETRY_DELTA_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "TelemetryBuffer.h"
+
+/**
+ * Decide quais campos de telemetria precisam ser enviados.
+ *
+ * Cada campo é comparado com o último valor enviado (não com a última
+ * amostra), de modo que variações lentas se acumulam até ultrapassar a
+ * banda morta. Campos que mudam sempre ou devagar (uptime, readCount) só
+ * seguem em quadros completos, enviados a cada TELEMETRY_KEYFRAME_INTERVAL.
+ */
+class TelemetryDelta {
+public:
+    TelemetryDelta();
+
+    /**
+     * Calcula a máscara de campos a enviar.
+     *
+     * @param data Telemetria atual.
+     * @param clients Número de clientes conectados.
+     * @param now Tempo atual (ms).
+     * @return TELEMETRY_FIELDS_ALL para quadro completo, 0 se nada mudou,
+     *         ou a máscara dos campos alterados.
+     */
+    uint16_t compute(const TelemetryBuffer &data, uint16_t clients, uint32_t now) const;
+
+    /**
+     * Registra os campos enviados como nova referência.
+     *
+     * @param data Telemetria enviada.
+     * @param clients Número de clientes enviado.
+     * @param fields Máscara retornada por compute().
+     * @param now Tempo atual (ms).
+     */
+    void commit(const TelemetryBuffer &data, uint16_t clients, uint16_t fields, uint32_t now);
+
+private:
+    TelemetryBuffer m_reference;    // Últimos valores enviados
+    uint16_t m_clients;             // Último número de clientes enviado
+    uint32_t m_lastKeyframe;        // Envio do último quadro completo (ms)
+    bool m_valid;                   // false até o primeiro quadro completo
+};
+
+#endif // TELEMETRY_DELTA_H
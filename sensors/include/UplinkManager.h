@@ -0,0 +1,192 @@
+/**
+ * @file UplinkManager.h
+ * @brief Tarefa dedicada de envio para a API com fila limitada.
+ */
+
+#ifndef UPLINK_MANAGER_H
+#define UPLINK_MANAGER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "Config.h"
+#include "DataTypes.h"
+#include "ApiClient.h"
+#include "SampleSpool.h"
+
+/**
+ * Estatísticas da fila de envio.
+ */
+struct UplinkStats {
+    uint32_t enqueued;          // Amostras aceitas na fila
+    uint32_t dropped;           // Amostras descartadas por overflow
+    uint32_t sent;              // Envios bem-sucedidos
+    uint32_t failed;            // Envios com falha
+    uint32_t samplesSent;       // Amostras entregues (soma dos lotes)
+    uint16_t lastBatchSize;     // Amostras no último lote enviado
+    uint16_t queueDepth;        // Profundidade atual da fila
+    uint16_t queueHighWater;    // Maior profundidade já observada
+    uint32_t lastEnqueueUs;     // Latência do último enfileiramento (μs)
+    uint32_t maxEnqueueUs;      // Maior latência de enfileiramento (μs)
+    uint32_t lastSendMs;        // Duração do último envio (ms)
+    uint32_t alertsSent;        // Alertas entregues
+    uint32_t alertsDropped;     // Alertas descartados (overflow ou recusa 4xx)
+
+    UplinkStats() : enqueued(0), dropped(0), sent(0), failed(0),
+                    samplesSent(0), lastBatchSize(0), queueDepth(0), queueHighWater(0), lastEnqueueUs(0),
+                    maxEnqueueUs(0), lastSendMs(0), alertsSent(0), alertsDropped(0) {}
+};
+
+/**
+ * Gerenciador do envio de dados para a API.
+ *
+ * Desacopla a aquisição da latência de rede: a tarefa de sensores apenas
+ * enfileira amostras (sem bloquear) e uma tarefa dedicada, fixada fora do
+ * núcleo de aquisição, consome a fila e executa o POST HTTP.
+ *
+ * Toda amostra passa pelo SampleSpool: sem conexão ou com falha no envio,
+ * ela permanece na RAM ou na flash e é drenada em ordem quando a conexão
+ * volta, em lotes espaçados por SPOOL_DRAIN_INTERVAL. Com API_BATCH_MODE,
+ * um lote é enviado quando atinge API_BATCH_MAX_SAMPLES ou quando a amostra
+ * mais antiga completa API_BATCH_MAX_AGE.
+ *
+ * Alertas têm uma fila própria e passam à frente do spool: são enviados
+ * assim que chegam, sem esperar API_SEND_INTERVAL nem o lote, e repetidos
+ * a cada SPOOL_RETRY_INTERVAL até serem aceitos. Não vão para a flash;
+ * com a tarefa sem conexão, os mais antigos são descartados quando os
+ * UPLINK_ALERT_QUEUE_LENGTH lugares se esgotam.
+ */
+class UplinkManager {
+public:
+    /**
+     * @enum OverflowPolicy
+     * @brief Comportamento quando a fila está cheia.
+     */
+    enum class OverflowPolicy : uint8_t {
+        DROP_OLDEST,    ///< Descarta a amostra mais antiga da fila
+        DROP_NEWEST     ///< Descarta a amostra recebida
+    };
+
+    /**
+     * Construtor.
+     *
+     * @param apiClient Cliente de API usado pela tarefa de envio.
+     * @param policy Política de overflow da fila.
+     */
+    UplinkManager(ApiClient &apiClient, OverflowPolicy policy = OverflowPolicy::DROP_OLDEST);
+
+    /**
+     * Cria a fila e a tarefa de envio.
+     *
+     * @return true se a fila e a tarefa foram criadas.
+     */
+    bool begin();
+
+    /**
+     * Enfileira uma amostra para envio, sem bloquear.
+     *
+     * @param data Amostra a ser enviada.
+     * @return true se a amostra entrou na fila, false se foi descartada.
+     */
+    bool enqueue(const SensorData &data);
+
+    /**
+     * Enfileira uma transição de alerta para envio imediato, sem bloquear.
+     *
+     * @param event Transição informada pelo AlertEngine.
+     * @return true se o alerta entrou na fila, false se foi descartado.
+     */
+    bool enqueueAlert(const AlertEvent &event);
+
+    /**
+     * Obtém uma cópia das estatísticas da fila.
+     *
+     * @return Estatísticas atuais.
+     */
+    UplinkStats getStats() const;
+
+    /**
+     * Obtém uma cópia das estatísticas do spool offline.
+     *
+     * @return Estatísticas atuais do spool.
+     */
+    SpoolStats getSpoolStats() const;
+
+private:
+    ApiClient &m_apiClient;
+    OverflowPolicy m_policy;
+    QueueHandle_t m_queue;
+    QueueHandle_t m_alertQueue;
+    TaskHandle_t m_task;
+
+    UplinkStats m_stats;
+    mutable portMUX_TYPE m_statsLock;
+
+    SampleSpool m_spool;                        // Amostras ainda não confirmadas
+    SensorData m_batch[API_BATCH_MAX_SAMPLES];  // Lote em envio (apenas tarefa de envio)
+    uint32_t m_nextAttempt;                     // Próximo envio permitido (ms)
+
+    AlertEvent m_alerts[UPLINK_ALERT_QUEUE_LENGTH]; // Alertas pendentes (apenas tarefa de envio)
+    uint8_t m_alertHead;                        // Alerta mais antigo
+    uint8_t m_alertCount;
+    uint32_t m_nextAlertAttempt;                // Próximo envio de alerta permitido (ms)
+
+    /**
+     * Função da tarefa de envio.
+     *
+     * @param pvParameters Ponteiro para a instância.
+     */
+    static void taskFunc(void *pvParameters);
+
+    /**
+     * Laço principal da tarefa de envio.
+     */
+    void run();
+
+    /**
+     * Transfere as filas para os alertas pendentes e para o spool.
+     */
+    void receive();
+
+    /**
+     * Envia os alertas pendentes, do mais antigo ao mais novo.
+     *
+     * @param now Tempo atual (ms).
+     */
+    void sendAlerts(uint32_t now);
+
+    /**
+     * Verifica se há um lote pronto e o envio é permitido.
+     *
+     * @param now Tempo atual (ms).
+     * @return true se o spool deve ser drenado agora.
+     */
+    bool drainDue(uint32_t now) const;
+
+    /**
+     * Calcula quanto tempo aguardar pela próxima amostra ou alerta.
+     *
+     * @param now Tempo atual (ms).
+     * @return Ticks até o próximo envio possível, ou portMAX_DELAY se vazio.
+     */
+    TickType_t waitTicks(uint32_t now) const;
+
+    /**
+     * Envia o lote mais antigo do spool e o confirma em caso de sucesso.
+     *
+     * @param now Tempo atual (ms).
+     */
+    void drain(uint32_t now);
+
+    /**
+     * Registra o resultado de um envio nas estatísticas.
+     *
+     * @param success Resultado do envio.
+     * @param samples Número de amostras enviadas.
+     * @param elapsed Duração do envio (ms).
+     */
+    void recordSend(bool success, size_t samples, uint32_t elapsed);
+};
+
+#endif // UPLINK_MANAGER_H
@@ -0,0 +1,126 @@
+"""
+Gera o painel web comprimido para o firmware.
+
+Registrado como script "pre:" em todos os ambientes do platformio.ini, para
+que include/DashboardAssets.h e a ETag acompanhem web/index.html em qualquer
+build. Também pode ser executado diretamente, no diretório sensors:
+
+    python3 scripts/dashboard_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+# Diretório do projeto: do PlatformIO, ou o diretório atual fora dele
+if 'env' not in globals():
+    try:
+        Import("env")  # noqa: F821 (injetado pelo PlatformIO)
+    except NameError:
+        env = None
+
+PROJECT_DIR = env['PROJECT_DIR'] if env is not None else os.getcwd()
+
+
+def minify_html(html):
+    """
+    Minifica o painel de forma conservadora.
+
+    Remove comentários HTML, indentação, linhas vazias e linhas que contêm
+    apenas comentários JavaScript. As quebras de linha são preservadas, para
+    que a inserção automática de ponto e vírgula do JavaScript não mude o
+    significado do código.
+
+    Args:
+        html: Conteúdo original
+
+    Returns:
+        str: Conteúdo minificado
+    """
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.DOTALL)
+
+    lines = []
+    for line in html.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+
+    return "\n".join(lines)
+
+
+def build_dashboard_assets():
+    """
+    Gera include/DashboardAssets.h a partir de web/index.html.
+
+    O painel é minificado, comprimido com gzip e gravado como array em
+    flash, junto com o tamanho e uma ETag derivada do conteúdo. O servidor
+    envia o blob com Content-Encoding: gzip, sem descomprimir no dispositivo.
+    O cabeçalho só é reescrito quando o conteúdo muda, evitando recompilações.
+    """
+    print("✓ Gerando painel web comprimido")
+
+    source = os.path.join(PROJECT_DIR, "web", "index.html")
+    target = os.path.join(PROJECT_DIR, "include", "DashboardAssets.h")
+
+    if not os.path.exists(source):
+        print(f"  Aviso: {source} não encontrado, mantendo cabeçalho existente")
+        return
+
+    with open(source, "r", encoding="utf-8") as f:
+        original = f.read()
+
+    minified = minify_html(original).encode("utf-8")
+
+    # mtime fixo: o mesmo conteúdo gera sempre os mesmos bytes (e a mesma ETag)
+    compressed = gzip.compress(minified, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(compressed).hexdigest()[:16]
+
+    rows = []
+    for i in range(0, len(compressed), 16):
+        chunk = compressed[i:i + 16]
+        rows.append("    " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+
+    header = (
+        "/**\n"
+        " * @file DashboardAssets.h\n"
+        " * @brief Painel web minificado e comprimido (gzip).\n"
+        " *\n"
+        " * Gerado por scripts/pre_build.py a partir de web/index.html; não editar.\n"
+        f" * Original: {len(original.encode('utf-8'))} bytes, minificado: {len(minified)} bytes,\n"
+        f" * gzip: {len(compressed)} bytes.\n"
+        " */\n"
+        "\n"
+        "#ifndef DASHBOARD_ASSETS_H\n"
+        "#define DASHBOARD_ASSETS_H\n"
+        "\n"
+        "#include <Arduino.h>\n"
+        "\n"
+        f"#define DASHBOARD_INDEX_ETAG      \"\\\"{etag}\\\"\"\n"
+        f"#define DASHBOARD_INDEX_GZ_LEN    {len(compressed)}\n"
+        "\n"
+        "static const uint8_t DASHBOARD_INDEX_GZ[] PROGMEM = {\n"
+        + "\n".join(rows) + "\n"
+        "};\n"
+        "\n"
+        "#endif // DASHBOARD_ASSETS_H\n"
+    )
+
+    current = None
+    if os.path.exists(target):
+        with open(target, "r", encoding="utf-8") as f:
+            current = f.read()
+
+    if current == header:
+        print(f"  Painel inalterado ({len(compressed)} bytes comprimidos)")
+        return
+
+    with open(target, "w", encoding="utf-8") as f:
+        f.write(header)
+
+    print(f"  {len(original.encode('utf-8'))} → {len(minified)} → {len(compressed)} bytes (ETag {etag})")
+
+
+# Ponto de entrada do script (PlatformIO ou execução direta)
+build_dashboard_assets()
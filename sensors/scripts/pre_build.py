@@ -7,6 +7,9 @@ Este script resolve problemas de concorrência durante a compilação:
 3. Otimiza flags de compilação
 4. Remove bibliotecas incompatíveis com ESP32
 
+O painel web (include/DashboardAssets.h) é gerado por
+scripts/dashboard_assets.py, registrado em todos os ambientes.
+
 Autor: Leonardo Sena (slayerlab)
 Data: 11/05/2025
 Versão: 2.5.0
@@ -0,0 +1,243 @@
+/**
+ * @file AlertEngine.cpp
+ * @brief Implementação do motor de alertas.
+ */
+
+#include "AlertEngine.h"
+#include "Metrics.h"
+#include "StringUtils.h"
+#include <math.h>
+
+// Tempos das regras padrão
+static const uint32_t MINUTE_MS = 60000;
+
+const AlertRule AlertEngine::DEFAULT_RULES[] = {
+    // Solo encharcado: RH > 95% por 10 min
+    { "umidade_alta", AlertChannel::HUMIDITY, AlertMetric::LEVEL, AlertComparison::ABOVE,
+      95.0f, 3.0f, 0, 10 * MINUTE_MS, MINUTE_MS },
+
+    // Solo seco: RH < 20% por 10 min
+    { "umidade_baixa", AlertChannel::HUMIDITY, AlertMetric::LEVEL, AlertComparison::BELOW,
+      20.0f, 3.0f, 0, 10 * MINUTE_MS, MINUTE_MS },
+
+    // Superaquecimento: T > 45 °C por 1 min
+    { "temperatura_alta", AlertChannel::TEMPERATURE, AlertMetric::LEVEL, AlertComparison::ABOVE,
+      45.0f, 2.0f, 0, MINUTE_MS, MINUTE_MS },
+
+    // Risco de geada: dT/dt < -3 °C/h na média de 10 min
+    { "temperatura_caindo", AlertChannel::TEMPERATURE, AlertMetric::RATE, AlertComparison::BELOW,
+      -3.0f / 60.0f, 1.0f / 60.0f, 10 * MINUTE_MS, MINUTE_MS, 5 * MINUTE_MS },
+
+    // Alagamento: dRH/dt > 10 %/h na média de 10 min
+    { "umidade_subindo", AlertChannel::HUMIDITY, AlertMetric::RATE, AlertComparison::ABOVE,
+      10.0f / 60.0f, 5.0f / 60.0f, 10 * MINUTE_MS, MINUTE_MS, 5 * MINUTE_MS },
+};
+
+const uint8_t AlertEngine::DEFAULT_RULE_COUNT = sizeof(DEFAULT_RULES) / sizeof(DEFAULT_RULES[0]);
+
+AlertEngine::AlertEngine(const AlertRule *rules, uint8_t count)
+    : m_rules(rules),
+    m_count(count < ALERT_MAX_RULES ? count : ALERT_MAX_RULES),
+    m_activeCount(0),
+    m_scriptErrors(0),
+    m_listener(nullptr),
+    m_listenerContext(nullptr) {
+    m_scripts.count = 0;
+    reset();
+}
+
+void AlertEngine::setListener(Listener listener, void *context) {
+    m_listener = listener;
+    m_listenerContext = context;
+}
+
+void AlertEngine::reset() {
+    memset(m_state, 0, sizeof(m_state));
+    memset(m_scriptState, 0, sizeof(m_scriptState));
+    m_activeCount = 0;
+}
+
+void AlertEngine::setScripts(const RuleSet &set, uint32_t now) {
+    for (uint8_t i = 0; i < m_scripts.count; i++) {
+        if (m_scriptState[i].active) {
+            m_activeCount--;
+            notify(nullptr, m_scripts.rules[i].name, false, 0.0f, now);
+        }
+    }
+
+    m_scripts = set;
+    if (m_scripts.count > RuleSet::MAX_RULES) {
+        m_scripts.count = RuleSet::MAX_RULES;
+    }
+    memset(m_scriptState, 0, sizeof(m_scriptState));
+}
+
+float AlertEngine::measure(const AlertRule &rule, const SensorData &data) {
+    if (rule.channel == AlertChannel::TEMPERATURE) {
+        return rule.metric == AlertMetric::RATE ? data.temperatureRate : data.temperature;
+    }
+    return rule.metric == AlertMetric::RATE ? data.humidityRate : data.humidityPercent;
+}
+
+uint8_t AlertEngine::evaluate(const SensorData &data, uint32_t now) {
+    uint8_t transitions = 0;
+
+    for (uint8_t i = 0; i < m_count; i++) {
+        const AlertRule &rule = m_rules[i];
+        RuleState &state = m_state[i];
+
+        // Média exponencial com passo proporcional ao intervalo real; no
+        // início, a média simples das amostras recebidas evita que a
+        // primeira amostra domine a média por várias constantes de tempo
+        float sample = measure(rule, data);
+        if (!state.initialized || rule.smoothingMs == 0) {
+            state.value = sample;
+            if (!state.initialized) {
+                state.initialized = true;
+                state.startedAt = now;
+            }
+        } else {
+            float dt = static_cast<float>(now - state.lastUpdate);
+            float alpha = 1.0f - expf(-dt / rule.smoothingMs);
+            float warmup = dt / static_cast<float>(now - state.startedAt);
+            state.value += (warmup > alpha ? warmup : alpha) * (sample - state.value);
+        }
+        state.lastUpdate = now;
+
+        // Aquecimento da média
+        if (now - state.startedAt < rule.smoothingMs) {
+            continue;
+        }
+
+        // Disparada, a regra só procura a normalização (limiar recuado pela histerese)
+        bool above = rule.comparison == AlertComparison::ABOVE;
+        bool crossing = state.active
+            ? (above ? state.value < rule.threshold - rule.hysteresis
+                     : state.value > rule.threshold + rule.hysteresis)
+            : (above ? state.value > rule.threshold
+                     : state.value < rule.threshold);
+
+        if (advance(state, crossing, rule.holdMs, rule.clearMs, now)) {
+            transitions++;
+            notify(&rule, rule.name, state.active, state.value, now);
+        }
+    }
+
+    // Regras configuradas: a expressão é a condição de alarme
+    float inputs[static_cast<size_t>(RuleInput::COUNT)];
+    inputs[static_cast<size_t>(RuleInput::TEMPERATURE)] = data.temperature;
+    inputs[static_cast<size_t>(RuleInput::HUMIDITY)] = data.humidityPercent;
+    inputs[static_cast<size_t>(RuleInput::TEMPERATURE_RATE)] = data.temperatureRate;
+    inputs[static_cast<size_t>(RuleInput::HUMIDITY_RATE)] = data.humidityRate;
+    inputs[static_cast<size_t>(RuleInput::TEMPERATURE_SIGMA)] = data.temperatureRateSigma;
+    inputs[static_cast<size_t>(RuleInput::HUMIDITY_SIGMA)] = data.humidityRateSigma;
+
+    for (uint8_t i = 0; i < m_scripts.count; i++) {
+        const RuleProgram &program = m_scripts.rules[i];
+        RuleState &state = m_scriptState[i];
+        inputs[static_cast<size_t>(RuleInput::ACTIVE)] = state.active ? 1.0f : 0.0f;
+
+        // Execução interrompida não muda o estado da regra
+        float result = 0.0f;
+        if (RuleInterpreter::run(program, inputs, result) != RuleInterpreter::Status::OK) {
+            m_scriptErrors++;
+            Metrics::ruleErrors.inc();
+            state.pending = false;
+            continue;
+        }
+
+        bool alarm = result != 0.0f && !isnan(result);
+        state.value = result;
+        if (advance(state, alarm != state.active, program.holdMs, program.clearMs, now)) {
+            transitions++;
+            notify(nullptr, program.name, state.active, result, now);
+        }
+    }
+
+    return transitions;
+}
+
+bool AlertEngine::advance(RuleState &state, bool crossing, uint32_t holdMs, uint32_t clearMs, uint32_t now) {
+    if (!crossing) {
+        state.pending = false;
+        return false;
+    }
+
+    if (!state.pending) {
+        state.pending = true;
+        state.pendingSince = now;
+    }
+
+    uint32_t required = state.active ? clearMs : holdMs;
+    if (now - state.pendingSince < required) {
+        return false;
+    }
+
+    state.active = !state.active;
+    state.pending = false;
+    m_activeCount = state.active ? m_activeCount + 1 : m_activeCount - 1;
+    return true;
+}
+
+void AlertEngine::notify(const AlertRule *rule, const char *name, bool active, float value, uint32_t now) {
+    if (m_listener == nullptr) {
+        return;
+    }
+
+    AlertEvent event;
+    event.rule = rule;
+    StringUtils::safeCopyString(event.name, name, sizeof(event.name));
+    event.active = active;
+    event.value = value;
+    event.timestamp = now;
+    m_listener(event, m_listenerContext);
+}
+
+bool AlertEngine::isActive(uint8_t index) const {
+    return index < m_count && m_state[index].active;
+}
+
+uint8_t AlertEngine::getActiveCount() const {
+    return m_activeCount;
+}
+
+const AlertRule *AlertEngine::getRule(uint8_t index) const {
+    return index < m_count ? &m_rules[index] : nullptr;
+}
+
+size_t AlertEngine::describe(const AlertEvent &event, char *buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return 0;
+    }
+
+    // Regras configuradas não têm canal nem limiar únicos
+    if (!event.rule) {
+        int length = snprintf(buffer, size, "%s %s (regra configurada, valor %.2f)",
+            event.name, event.active ? "ativo" : "normalizado", event.value);
+        if (length < 0) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        return static_cast<size_t>(length) < size ? static_cast<size_t>(length) : size - 1;
+    }
+
+    const AlertRule &rule = *event.rule;
+    bool temperature = rule.channel == AlertChannel::TEMPERATURE;
+    const char *channel = temperature ? "temperatura" : "umidade";
+    const char *unit = temperature
+        ? (rule.metric == AlertMetric::RATE ? "°C/min" : "°C")
+        : (rule.metric == AlertMetric::RATE ? "%/min" : "%");
+    int precision = rule.metric == AlertMetric::RATE ? 2 : 1;
+
+    int length = snprintf(buffer, size, "%s %s: %s %.*f %s (limiar %c %.*f %s)",
+        event.name, event.active ? "ativo" : "normalizado",
+        channel, precision, event.value, unit,
+        rule.comparison == AlertComparison::ABOVE ? '>' : '<',
+        precision, rule.threshold, unit);
+
+    if (length < 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return static_cast<size_t>(length) < size ? static_cast<size_t>(length) : size - 1;
+}
@@ -6,68 +6,403 @@
 #include "ApiClient.h"
 #include "Config.h"
 #include "LogSystem.h"
-#include <HTTPClient.h>
 #include <WiFi.h>
 #include <ArduinoJson.h> // Usaremos para criar o corpo da requisição
 
 #define MODULE_NAME "ApiClient"
 
-ApiClient::ApiClient(const char* endpointUrl) : m_endpointUrl(endpointUrl) {
+ApiClient::ApiClient(const char* endpointUrl)
+    : m_endpointUrl(endpointUrl),
+    m_port(80),
+    m_lastActivity(0),
+    m_discardResponse(API_DISCARD_RESPONSE_BODY),
+    m_reusedCount(0),
+    m_connectCount(0) {
+    m_host[0] = '\0';
+    m_path[0] = '\0';
+
+    if (!parseUrl()) {
+        LOG_ERROR(MODULE_NAME, "URL de endpoint inválida: %s", m_endpointUrl.c_str());
+    }
+
     LOG_INFO(MODULE_NAME, "Cliente de API inicializado. Endpoint: %s", m_endpointUrl.c_str());
 }
 
-bool ApiClient::sendData(const SensorData& data) {
+bool ApiClient::parseUrl() {
+    const char* url = m_endpointUrl.c_str();
+    const char* scheme = "http://";
+
+    // Apenas HTTP simples é suportado pela conexão persistente
+    if (strncmp(url, scheme, strlen(scheme)) != 0) {
+        return false;
+    }
+
+    const char* hostStart = url + strlen(scheme);
+    const char* pathStart = strchr(hostStart, '/');
+    const char* hostEnd = pathStart ? pathStart : hostStart + strlen(hostStart);
+    const char* portStart = static_cast<const char*>(memchr(hostStart, ':', hostEnd - hostStart));
+
+    size_t hostLen = (portStart ? portStart : hostEnd) - hostStart;
+    if (hostLen == 0 || hostLen >= sizeof(m_host)) {
+        return false;
+    }
+
+    memcpy(m_host, hostStart, hostLen);
+    m_host[hostLen] = '\0';
+
+    m_port = portStart ? static_cast<uint16_t>(atoi(portStart + 1)) : 80;
+
+    StringUtils::safeCopyString(m_path, pathStart ? pathStart : "/", sizeof(m_path));
+    return true;
+}
+
+int ApiClient::sendData(const SensorData& data, uint32_t boot) {
     // 1. Verifica se estamos conectados ao WiFi
     if (WiFi.status() != WL_CONNECTED) {
         LOG_WARN(MODULE_NAME, "Não conectado ao WiFi. Envio cancelado.");
-        return false;
+        return API_ERROR_CONNECT;
     }
 
-    // 2. Cria o corpo da requisição (payload) em formato JSON
+    // 2. Cria o corpo da requisição (payload) em formato JSON, sem alocar no heap
     StaticJsonDocument<256> doc;
     doc["temperatura"] = data.temperature;
     doc["umidade"] = data.humidityPercent;
     doc["timestamp"] = data.timestamp;
+    if (boot != 0) {
+        doc["boot"] = boot;
+    }
 
-    String jsonPayload;
-    serializeJson(doc, jsonPayload);
-
-    // 3. Prepara e envia a requisição HTTP POST
-    HTTPClient http;
-    bool success = false;
-
-    // Inicia a requisição
-    if (http.begin(m_endpointUrl)) {
-        LOG_INFO(MODULE_NAME, "Enviando dados para a API...");
-        
-        // Define o cabeçalho da requisição
-        http.addHeader("Content-Type", "application/json");
-
-        // Envia o POST com o payload JSON
-        int httpCode = http.POST(jsonPayload);
-
-        // 4. Analisa a resposta
-        if (httpCode > 0) {
-            LOG_INFO(MODULE_NAME, "Resposta da API: %d", httpCode);
-            String responseBody = http.getString();
-            LOG_DEBUG(MODULE_NAME, "Corpo da resposta: %s", responseBody.c_str());
-
-            // Consideramos sucesso se o código for da família 2xx (ex: 200 OK, 201 Created)
-            if (httpCode >= 200 && httpCode < 300) {
-                success = true;
-                LOG_INFO(MODULE_NAME, "Dados enviados com sucesso!");
-            } else {
-                LOG_ERROR(MODULE_NAME, "Falha no envio, código de erro HTTP: %d", httpCode);
-            }
-        } else {
-            LOG_ERROR(MODULE_NAME, "Falha na conexão com a API. Erro: %s", http.errorToString(httpCode).c_str());
+    char payload[128];
+    size_t length = serializeJson(doc, payload, sizeof(payload));
+    if (length == 0 || length >= sizeof(payload) - 1) {
+        LOG_ERROR(MODULE_NAME, "Falha ao montar payload dos dados");
+        return API_ERROR_PAYLOAD;
+    }
+
+    // 3. Envia a requisição HTTP POST pela conexão persistente
+    LOG_INFO(MODULE_NAME, "Enviando dados para a API...");
+    int httpCode = post(payload, length);
+
+    // 4. Analisa a resposta
+    handleResult(httpCode);
+    return httpCode;
+}
+
+int ApiClient::sendBatch(const SensorData* samples, size_t count, uint32_t boot) {
+    if (!samples || count == 0) {
+        return API_ERROR_PAYLOAD;
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        LOG_WARN(MODULE_NAME, "Não conectado ao WiFi. Envio de lote cancelado.");
+        return API_ERROR_CONNECT;
+    }
+
+    // Cabeçalho compartilhado: versão, boot, timestamp base, colunas e divisores
+    char payload[API_BATCH_PAYLOAD_SIZE];
+    uint32_t base = samples[0].timestamp;
+    int length = boot != 0
+        ? snprintf(payload, sizeof(payload), "{\"v\":1,\"boot\":%u,", static_cast<unsigned>(boot))
+        : snprintf(payload, sizeof(payload), "{\"v\":1,");
+    length += snprintf(payload + length, sizeof(payload) - length,
+        "\"t0\":%u,\"cols\":[\"dt\",\"temperatura\",\"umidade\"],"
+        "\"div\":[1,10,10],\"rows\":[",
+        base);
+
+    // Uma linha por amostra: delta do timestamp e valores em décimos
+    size_t written = 0;
+    for (size_t i = 0; i < count && length > 0 && length < static_cast<int>(sizeof(payload)); i++) {
+        int rowLen = snprintf(payload + length, sizeof(payload) - length, "%s[%u,%ld,%ld]",
+            written > 0 ? "," : "",
+            samples[i].timestamp - base,
+            lroundf(samples[i].temperature * 10.0f),
+            lroundf(samples[i].humidityPercent * 10.0f));
+
+        // Mantém o lote limitado ao buffer: amostras que não cabem são omitidas
+        if (rowLen <= 0 || length + rowLen + 2 >= static_cast<int>(sizeof(payload))) {
+            break;
+        }
+        length += rowLen;
+        written++;
+    }
+
+    if (length <= 0 || length + 2 >= static_cast<int>(sizeof(payload))) {
+        LOG_ERROR(MODULE_NAME, "Falha ao montar payload do lote");
+        return API_ERROR_PAYLOAD;
+    }
+    payload[length++] = ']';
+    payload[length++] = '}';
+    payload[length] = '\0';
+
+    if (written < count) {
+        LOG_WARN(MODULE_NAME, "Lote truncado: %u de %u amostras",
+            static_cast<unsigned>(written), static_cast<unsigned>(count));
+    }
+
+    LOG_INFO(MODULE_NAME, "Enviando lote de %u amostras (%d bytes)...",
+        static_cast<unsigned>(written), length);
+    int httpCode = post(payload, length);
+    handleResult(httpCode);
+    return httpCode;
+}
+
+int ApiClient::sendAlert(const AlertEvent& event) {
+    if (WiFi.status() != WL_CONNECTED) {
+        LOG_WARN(MODULE_NAME, "Não conectado ao WiFi. Envio de alerta cancelado.");
+        return API_ERROR_CONNECT;
+    }
+
+    StaticJsonDocument<192> doc;
+    doc["alerta"] = event.name;
+    doc["ativo"] = event.active;
+    doc["valor"] = event.value;
+    // Regras configuradas não têm limiar único
+    if (event.rule) {
+        doc["limiar"] = event.rule->threshold;
+    }
+    doc["timestamp"] = event.timestamp;
+
+    char payload[160];
+    size_t length = serializeJson(doc, payload, sizeof(payload));
+    if (length == 0 || length >= sizeof(payload) - 1) {
+        LOG_ERROR(MODULE_NAME, "Falha ao montar payload do alerta");
+        return API_ERROR_PAYLOAD;
+    }
+
+    LOG_INFO(MODULE_NAME, "Enviando alerta %s para a API...", event.name);
+    int httpCode = post(payload, length);
+    handleResult(httpCode);
+    return httpCode;
+}
+
+bool ApiClient::handleResult(int httpCode) {
+    if (httpCode > 0) {
+        LOG_INFO(MODULE_NAME, "Resposta da API: %d", httpCode);
+
+        // Consideramos sucesso se o código for da família 2xx (ex: 200 OK, 201 Created)
+        if (httpCode >= 200 && httpCode < 300) {
+            LOG_INFO(MODULE_NAME, "Dados enviados com sucesso!");
+            return true;
         }
 
-        // Libera os recursos
-        http.end();
+        LOG_ERROR(MODULE_NAME, "Falha no envio, código de erro HTTP: %d", httpCode);
     } else {
-        LOG_ERROR(MODULE_NAME, "Não foi possível iniciar a conexão HTTP.");
+        LOG_ERROR(MODULE_NAME, "Falha na conexão com a API. Erro: %d", httpCode);
+    }
+
+    return false;
+}
+
+int ApiClient::post(const char* payload, size_t length) {
+    if (m_host[0] == '\0') {
+        return API_ERROR_INVALID_URL;
+    }
+
+    // Encerra conexões que ficaram ociosas além do limite configurado
+    if (m_client.connected() && millis() - m_lastActivity > API_KEEPALIVE_IDLE_TIMEOUT) {
+        LOG_DEBUG(MODULE_NAME, "Conexão ociosa por mais de %u ms, encerrando", API_KEEPALIVE_IDLE_TIMEOUT);
+        m_client.stop();
+    }
+
+    ApiRequestTiming timing;
+    bool keepAlive = false;
+    int result = attemptPost(payload, length, timing, keepAlive);
+
+    // Conexão reutilizada pode ter sido fechada pelo servidor: reconecta uma vez
+    if (result < 0 && timing.reused) {
+        LOG_DEBUG(MODULE_NAME, "Conexão reutilizada falhou (%d), reconectando", result);
+        m_client.stop();
+        timing = ApiRequestTiming();
+        result = attemptPost(payload, length, timing, keepAlive);
+    }
+
+    if (result < 0 || !keepAlive) {
+        m_client.stop();
     }
 
-    return success;
+    m_lastActivity = millis();
+    timing.statusCode = static_cast<int16_t>(result);
+    m_lastTiming = timing;
+
+    if (timing.reused) {
+        m_reusedCount++;
+    }
+
+    LOG_DEBUG(MODULE_NAME, "Tempos (us): conexão=%u envio=%u primeiro byte=%u total=%u (%s)",
+        timing.connectUs, timing.sendUs, timing.firstByteUs, timing.totalUs,
+        timing.reused ? "reutilizada" : "nova");
+
+    return result;
+}
+
+int ApiClient::attemptPost(const char* payload, size_t length, ApiRequestTiming& timing, bool& keepAlive) {
+    uint32_t requestStart = micros();
+    keepAlive = false;
+
+    // 1. Conexão: reutiliza se ainda aberta, senão abre uma nova
+    timing.reused = m_client.connected();
+    if (!timing.reused) {
+        uint32_t connectStart = micros();
+        if (!m_client.connect(m_host, m_port, API_CONNECT_TIMEOUT)) {
+            timing.connectUs = micros() - connectStart;
+            timing.totalUs = micros() - requestStart;
+            return API_ERROR_CONNECT;
+        }
+        timing.connectUs = micros() - connectStart;
+        m_connectCount++;
+    }
+
+    // 2. Envio de cabeçalhos e corpo
+    uint32_t sendStart = micros();
+    char header[256];
+    int headerLen = snprintf(header, sizeof(header),
+        "POST %s HTTP/1.1\r\n"
+        "Host: %s\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n",
+        m_path, m_host, static_cast<unsigned>(length));
+
+    if (headerLen <= 0 || headerLen >= static_cast<int>(sizeof(header))) {
+        return API_ERROR_SEND;
+    }
+
+    if (m_client.write(reinterpret_cast<const uint8_t*>(header), headerLen) != static_cast<size_t>(headerLen) ||
+        m_client.write(reinterpret_cast<const uint8_t*>(payload), length) != length) {
+        timing.sendUs = micros() - sendStart;
+        timing.totalUs = micros() - requestStart;
+        return API_ERROR_SEND;
+    }
+    timing.sendUs = micros() - sendStart;
+
+    // 3. Espera pelo primeiro byte da resposta
+    uint32_t waitStart = micros();
+    uint32_t deadline = millis() + API_RESPONSE_TIMEOUT;
+    while (!m_client.available()) {
+        if (!m_client.connected() || static_cast<int32_t>(millis() - deadline) >= 0) {
+            timing.firstByteUs = micros() - waitStart;
+            timing.totalUs = micros() - requestStart;
+            return API_ERROR_NO_RESPONSE;
+        }
+        vTaskDelay(1);
+    }
+    timing.firstByteUs = micros() - waitStart;
+
+    // 4. Linha de status: "HTTP/1.1 200 OK"
+    char line[128];
+    if (readLine(line, sizeof(line), deadline) < 0 || strncmp(line, "HTTP/1.", 7) != 0) {
+        timing.totalUs = micros() - requestStart;
+        return API_ERROR_NO_RESPONSE;
+    }
+
+    int statusCode = atoi(line + 9);
+    keepAlive = (line[7] == '1');   // HTTP/1.1 mantém a conexão por padrão
+
+    // 5. Cabeçalhos relevantes para reutilizar a conexão
+    long contentLength = -1;
+    bool chunked = false;
+    while (true) {
+        int len = readLine(line, sizeof(line), deadline);
+        if (len < 0) {
+            timing.totalUs = micros() - requestStart;
+            return API_ERROR_NO_RESPONSE;
+        }
+        if (len == 0) {
+            break; // Fim dos cabeçalhos
+        }
+
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            contentLength = atol(line + 15);
+        } else if (strncasecmp(line, "Connection:", 11) == 0) {
+            keepAlive = (strcasestr(line + 11, "close") == nullptr);
+        } else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+            chunked = (strcasestr(line + 18, "chunked") != nullptr);
+        }
+    }
+
+    // 6. Corpo: consumido com buffer fixo para que a conexão possa ser reutilizada
+    if (chunked || contentLength < 0) {
+        // Tamanho desconhecido: não é possível delimitar o corpo, fecha a conexão
+        keepAlive = false;
+    } else if (!drainBody(static_cast<size_t>(contentLength), deadline)) {
+        keepAlive = false;
+    }
+
+    timing.totalUs = micros() - requestStart;
+    return statusCode;
+}
+
+int ApiClient::readLine(char* buffer, size_t size, uint32_t deadline) {
+    size_t count = 0;
+
+    while (true) {
+        int c = m_client.read();
+        if (c < 0) {
+            if (!m_client.connected() || static_cast<int32_t>(millis() - deadline) >= 0) {
+                return -1;
+            }
+            vTaskDelay(1);
+            continue;
+        }
+
+        if (c == '\n') {
+            break;
+        }
+        if (c != '\r' && count + 1 < size) {
+            buffer[count++] = static_cast<char>(c);
+        }
+    }
+
+    buffer[count] = '\0';
+    return static_cast<int>(count);
+}
+
+bool ApiClient::drainBody(size_t contentLength, uint32_t deadline) {
+    uint8_t chunk[64];
+    size_t remaining = contentLength;
+    bool logged = false;
+
+    while (remaining > 0) {
+        int available = m_client.available();
+        if (available <= 0) {
+            if (!m_client.connected() || static_cast<int32_t>(millis() - deadline) >= 0) {
+                return false;
+            }
+            vTaskDelay(1);
+            continue;
+        }
+
+        size_t toRead = remaining < sizeof(chunk) ? remaining : sizeof(chunk);
+        int read = m_client.read(chunk, toRead);
+        if (read <= 0) {
+            continue;
+        }
+
+        // Sem descarte, registra apenas o início do corpo (sem alocar String)
+        if (!m_discardResponse && !logged) {
+            LOG_DEBUG(MODULE_NAME, "Corpo da resposta: %.*s", read, reinterpret_cast<const char*>(chunk));
+            logged = true;
+        }
+
+        remaining -= read;
+    }
+
+    return true;
+}
+
+void ApiClient::setDiscardResponse(bool discard) {
+    m_discardResponse = discard;
+}
+
+const ApiRequestTiming& ApiClient::getLastTiming() const {
+    return m_lastTiming;
+}
+
+uint32_t ApiClient::getReusedCount() const {
+    return m_reusedCount;
+}
+
+uint32_t ApiClient::getConnectCount() const {
+    return m_connectCount;
 }
@@ -7,227 +7,17 @@
 #include "LogSystem.h"
 #include "OutputManager.h"
 #include "TelemetryBuffer.h"
+#include "DashboardAssets.h"
+#include "Metrics.h"
+#include "CpuMonitor.h"
+#include "Scheduler.h"
 
 // Nome do módulo para logs
 #define MODULE_NAME "WebServer"
 
-// HTML da página principal (armazenado em PROGMEM para economizar RAM)
-// Com sistema de atualização inteligente para evitar flickering
-const char AsyncSoilWebServer::INDEX_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html lang="pt-br">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Sistema de Monitoramento Climático</title>
-    <style>
-    body {
-        font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-        margin: 0;
-        padding: 20px;
-        background-color: #f5f5f5;
-        color: #333;
-    }
-    h1 {
-        color: #2c3e50;
-        text-align: center;
-        margin-bottom: 20px;
-    }
-    .container {
-        display: flex;
-        flex-wrap: wrap;
-        gap: 20px;
-        justify-content: center;
-    }
-    .box {
-        background-color: white;
-        border-radius: 10px;
-        padding: 20px;
-        box-shadow: 0 3px 10px rgba(0, 0, 0, 0.1);
-        min-width: 200px;
-        flex: 1;
-    }
-    h2 {
-        margin-top: 0;
-        margin-bottom: 15px;
-        font-size: 1.2em;
-        color: #3498db;
-    }
-    .value {
-        font-size: 2em;
-        font-weight: bold;
-        text-align: center;
-        margin: 10px 0;
-    }
-    .stats {
-        font-size: 1em;
-        line-height: 1.6;
-    }
-    @media (max-width: 768px) {
-        .container {
-            flex-direction: column;
-        }
-        .box {
-            min-width: auto;
-        }
-    }
-    </style>
-</head>
-<body>
-    <h1>Sistema de Monitoramento Climático</h1>
-
-    <div class="container">
-        <div class="box">
-            <h2>Temperatura</h2>
-            <div class="value" id="temperature-value">0.0°C</div>
-        </div>
-        <div class="box">
-            <h2>Umidade do Ar</h2>
-            <div class="value" id="humidity-value">0.0%</div>
-        </div>
-    </div>
-
-    <div class="container" style="margin-top: 20px;">
-        <div class="box" style="width: 100%;">
-            <h2>Estatísticas do Sistema</h2>
-            <div class="stats">
-                <div>Memória livre: <span id="free-memory">0</span> bytes</div>
-                <div>Fragmentação: <span id="fragmentation">0</span>%</div>
-                <div>Tempo ativo: <span id="uptime">0</span></div>
-                <div>Clientes conectados: <span id="clients">0</span></div>
-                <div>WiFi: <span id="wifi-status">Desconectado</span></div>
-            </div>
-        </div>
-    </div>
-
-    <script>
-    const currentValues = {
-        'temperature-value': '0.0°C',
-        'humidity-value': '0.0%',
-        'free-memory': '0',
-        'fragmentation': '0%',
-        'uptime': '0',
-        'clients': '0',
-        'wifi-status': 'Desconectado'
-    };
-
-    function updateElementIfChanged(id, newValue) {
-        const element = document.getElementById(id);
-        if (!element) return false;
-
-        if (currentValues[id] !== newValue) {
-            element.textContent = newValue;
-            currentValues[id] = newValue;
-            return true;
-        }
-
-        return false;
-    }
-
-    let ws = null;
-    let reconnectInterval = 1000;
-    let reconnectAttempts = 0;
-    const maxReconnectAttempts = 10;
-
-    function connectWebSocket() {
-        if (ws) ws.close();
-
-        const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
-        const wsUrl = `${protocol}//${window.location.host}/ws`;
-        ws = new WebSocket(wsUrl);
-
-        ws.onopen = function () {
-            console.log('WebSocket conectado');
-            reconnectInterval = 1000;
-            reconnectAttempts = 0;
-        };
-
-        ws.onmessage = function (event) {
-            try {
-                const data = JSON.parse(event.data);
-                updateUI(data);
-            } catch (e) {
-                console.error('Erro ao analisar dados:', e);
-            }
-        };
-
-        ws.onclose = function () {
-            console.log('WebSocket desconectado');
-            if (reconnectAttempts < maxReconnectAttempts) {
-                setTimeout(() => {
-                    reconnectAttempts++;
-                    reconnectInterval *= 1.5;
-                    connectWebSocket();
-                }, reconnectInterval);
-            }
-        };
-
-        ws.onerror = function (error) {
-            console.error('Erro WebSocket:', error);
-            ws.close();
-        };
-    }
-
-    function updateUI(data) {
-        if (data.sensors) {
-            if (typeof data.sensors.temperature === 'number') {
-                updateElementIfChanged('temperature-value', data.sensors.temperature.toFixed(1) + '°C');
-            }
-            if (typeof data.sensors.humidity === 'number') {
-                updateElementIfChanged('humidity-value', data.sensors.humidity.toFixed(1) + '%');
-            }
-        }
-
-        if (data.stats) {
-            if (data.stats.freeHeap !== undefined) {
-                updateElementIfChanged('free-memory', data.stats.freeHeap.toString());
-            }
-
-            if (data.stats.fragmentation !== undefined) {
-                updateElementIfChanged('fragmentation', data.stats.fragmentation + '%');
-            }
-
-            if (data.stats.uptime !== undefined) {
-                const uptime = data.stats.uptime;
-                const days = Math.floor(uptime / 86400);
-                const hours = Math.floor((uptime % 86400) / 3600);
-                const minutes = Math.floor((uptime % 3600) / 60);
-                const seconds = uptime % 60;
-                const formatted =
-                    (days > 0 ? days + 'd ' : '') +
-                    (hours > 0 ? hours + 'h ' : '') +
-                    (minutes > 0 ? minutes + 'm ' : '') +
-                    seconds + 's';
-                updateElementIfChanged('uptime', formatted);
-            }
+// Maior tempo de disparo ou normalização de uma regra configurada (s)
+static const uint32_t RULE_MAX_DURATION = 86400;
 
-            if (data.stats.clients !== undefined) {
-                updateElementIfChanged('clients', data.stats.clients.toString());
-            }
-
-            if (data.stats.wifi !== undefined) {
-                updateElementIfChanged('wifi-status', data.stats.wifi);
-            }
-        }
-    }
-
-    document.addEventListener('DOMContentLoaded', function () {
-        connectWebSocket();
-
-        // Fallback com polling
-        setInterval(function () {
-            if (!ws || ws.readyState !== WebSocket.OPEN) {
-                fetch('/data')
-                    .then(response => response.json())
-                    .then(updateUI)
-                    .catch(error => console.error('Erro na API:', error));
-            }
-        }, 2000);
-    });
-    </script>
-</body>
-</html>
-)rawliteral";
 
 // Armazena um ponteiro para a instância que está sendo usada
 // Uma vez que a biblioteca não fornece meios de associar o ponteiro this ao websocket
@@ -236,22 +26,48 @@ static AsyncSoilWebServer* s_instance = nullptr;
 AsyncSoilWebServer::AsyncSoilWebServer(uint16_t port, SensorManager &sensorManager)
     : m_server(port),
     m_websocket("/ws"),
+    m_binarySocket(WS_BINARY_PATH),
+    m_jsonPool(WS_JSON_FRAME_SIZE),
+    m_binaryPool(sizeof(TelemetryFrame)),
+    m_logPool(WS_LOG_SIZE_CLASS),
     m_sensorManager(sensorManager),
-    m_lastBroadcastTime(0),
     m_clientCount(0),
-    m_broadcastCount(0) {
+    m_broadcastCount(0),
+    m_dataRequests(0),
+    m_dataNotModified(0),
+    m_dataMaxUs(0),
+    m_bootNonce(esp_random()),
+    m_alertHead(0),
+    m_alertDelivered(0),
+    m_alertBacklog(false),
+    m_alertLock(portMUX_INITIALIZER_UNLOCKED),
+    m_scheduler(nullptr),
+    m_alertEvent(0),
+    m_clientEvent(0) {
 }
 
 bool AsyncSoilWebServer::begin() {
     // Armazena a instância atual na variável estática
     s_instance = this;
 
+    // Buffers de broadcast alocados uma única vez, antes de aceitar clientes
+    if (!m_jsonPool.begin() || !m_binaryPool.begin() || !m_logPool.begin()) {
+        LOG_ERROR(MODULE_NAME, "Falha ao alocar pools de broadcast");
+        return false;
+    }
+
     // Configura o handler de eventos WebSocket
     m_websocket.onEvent(onWebSocketEvent);
 
     // Adiciona o handler WebSocket ao servidor
     m_server.addHandler(&m_websocket);
 
+    // Endpoint opcional com quadros binários compactos (TelemetryFrame)
+    if (WS_BINARY_TELEMETRY) {
+        m_binarySocket.onEvent(onWebSocketEvent);
+        m_server.addHandler(&m_binarySocket);
+    }
+
     // Configura as rotas do servidor
     m_server.on("/", HTTP_GET,
         [this](AsyncWebServerRequest *request) { handleRoot(request); });
@@ -263,6 +79,22 @@ bool AsyncSoilWebServer::begin() {
     m_server.on("/logs", HTTP_GET,
         [this](AsyncWebServerRequest *request) { handleLogs(request); });
 
+    // Carga da CPU: núcleos, histórico e tempo por tarefa
+    m_server.on("/cpu", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleCpu(request); });
+
+    // Métricas no formato texto do Prometheus
+    m_server.on("/metrics", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleMetrics(request); });
+
+    // Regras de alerta configuradas em campo
+    m_server.on("/rules", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleRulesGet(request); });
+
+    m_server.on("/rules", HTTP_POST,
+        [this](AsyncWebServerRequest *request) { handleRulesPost(request); },
+        nullptr, handleRulesBody);
+
     // Handler para rotas não encontradas
     m_server.onNotFound(
         [this](AsyncWebServerRequest *request) { handleNotFound(request); });
@@ -277,8 +109,30 @@ bool AsyncSoilWebServer::begin() {
 }
 
 void AsyncSoilWebServer::handleRoot(AsyncWebServerRequest *request) {
-    // Envia a página HTML
-    request->send(200, "text/html", INDEX_HTML);
+    AsyncWebServerResponse *response;
+
+    if (request->hasHeader("If-None-Match") &&
+        strstr(request->getHeader("If-None-Match")->value().c_str(), DASHBOARD_INDEX_ETAG) != nullptr) {
+        // Painel em cache no navegador e inalterado desde o build
+        response = request->beginResponse(304);
+    } else if (request->hasHeader("Accept-Encoding") &&
+               strstr(request->getHeader("Accept-Encoding")->value().c_str(), "gzip") == nullptr) {
+        // O painel só existe comprimido; descomprimir no dispositivo não compensa
+        request->send(406, "text/plain", "Navegador sem suporte a gzip");
+        return;
+    } else {
+        // Blob gerado por scripts/pre_build.py, enviado direto da flash
+        response = request->beginResponse_P(200, "text/html; charset=utf-8",
+                                            DASHBOARD_INDEX_GZ, DASHBOARD_INDEX_GZ_LEN);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+
+    char cacheControl[32];
+    snprintf(cacheControl, sizeof(cacheControl), "public, max-age=%d", DASHBOARD_CACHE_MAX_AGE);
+    response->addHeader("ETag", DASHBOARD_INDEX_ETAG);
+    response->addHeader("Cache-Control", cacheControl);
+    response->addHeader("Vary", "Accept-Encoding");
+    request->send(response);
 
     if (DEBUG_MODE) {
         {
@@ -291,108 +145,441 @@ void AsyncSoilWebServer::handleRoot(AsyncWebServerRequest *request) {
 }
 
 void AsyncSoilWebServer::handleData(AsyncWebServerRequest *request) {
-    // Força atualização dos sensores
-    m_sensorManager.update(true);
-
-    // Agora que a telemetria está centralizada no OutputManager,
-    // usamos a rota prepareTelemetry e enviamos ao cliente HTTP
-    TelemetryBuffer telemetry = m_sensorManager.prepareTelemetry();
-
-    // Cria documento JSON usando o mesmo formato que usamos para WebSocket
-    StaticJsonDocument<512> doc;
-    JsonObject root = doc.to<JsonObject>();
-    JsonObject sensors = root.createNestedObject("sensors");
-
-    // Dados de sensores (suficiente para a API /data)
-    sensors["temperature"] = telemetry.temperature;
-    sensors["humidity"] = telemetry.humidity;
-    sensors["timestamp"] = telemetry.timestamp;
-    sensors["readCount"] = telemetry.readCount;
+    uint32_t start = micros();
+
+    // Lê o último snapshot publicado pela tarefa de sensores, sem mutex e
+    // sem leitura do sensor no contexto do AsyncTCP
+    SensorSnapshot snapshot;
+    m_sensorManager.getSnapshot(snapshot);
+    const TelemetryBuffer &telemetry = snapshot.telemetry;
+
+    // O snapshot é republicado a cada SENSOR_CHECK_INTERVAL, mas a amostra
+    // só muda a cada aquisição do DHT22: a ETag segue a aquisição, com o
+    // nonce do boot para que um contador reiniciado não gere um 304 falso.
+    // Fraca porque readCount continua mudando entre aquisições
+    char etag[24];
+    snprintf(etag, sizeof(etag), "W/\"%08x%08x\"",
+        static_cast<unsigned>(m_bootNonce), static_cast<unsigned>(snapshot.sampleSequence));
+
+    // Idade da última aquisição bem-sucedida, em segundos: cresce enquanto o DHT22 falha
+    char age[12];
+    snprintf(age, sizeof(age), "%u", static_cast<unsigned>((millis() - snapshot.sampleTime) / 1000));
+
+    m_dataRequests++;
+
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") &&
+        strstr(request->getHeader("If-None-Match")->value().c_str(), etag) != nullptr) {
+        // Nenhuma amostra nova desde a última consulta do cliente
+        response = request->beginResponse(304);
+        m_dataNotModified++;
+    } else {
+        // Cria documento JSON usando o mesmo formato que usamos para WebSocket
+        StaticJsonDocument<320> doc;
+        JsonObject root = doc.to<JsonObject>();
+        JsonObject sensors = root.createNestedObject("sensors");
+
+        // Dados de sensores (suficiente para a API /data)
+        sensors["temperature"] = telemetry.temperature;
+        sensors["humidity"] = telemetry.humidity;
+        sensors["timestamp"] = snapshot.sampleTime;
+        sensors["readCount"] = telemetry.readCount;
+        telemetry.trendToJson(sensors);
+
+        // Serializa para string
+        String body;
+        serializeJson(doc, body);
+        response = request->beginResponse(200, "application/json", body);
+    }
 
-    // Serializa para string
-    String response;
-    serializeJson(doc, response);
+    // Armazenável, mas sempre revalidado: uma amostra nova a cada DHT22_READ_INTERVAL
+    response->addHeader("Cache-Control", "no-cache");
+    response->addHeader("ETag", etag);
+    response->addHeader("Age", age);
+    request->send(response);
 
-    // Envia a resposta
-    request->send(200, "application/json", response);
+    uint32_t elapsed = micros() - start;
+    if (elapsed > m_dataMaxUs) {
+        m_dataMaxUs = elapsed;
+    }
 
     if (DEBUG_MODE) {
         {
             IPAddress ip = request->client()->remoteIP();
             char ipStr[16];
             snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-            DBG_DEBUG(MODULE_NAME, "API dados requisitada por %s", ipStr);
+            DBG_DEBUG(MODULE_NAME, "API dados requisitada por %s (ETag %s, %u us)", ipStr, etag, elapsed);
         }
     }
 }
 
 void AsyncSoilWebServer::handleLogs(AsyncWebServerRequest *request) {
-    // Tamanho máximo do buffer para armazenar os logs
-    const size_t bufferSize = LOG_BUFFER_SIZE * (LOG_MAX_MESSAGE_SIZE + 64);
-
-    // Aloca buffer para armazenar os logs
-    char* logBuffer = new char[bufferSize];
-    if (!logBuffer) {
-        // Caso não consiga alocar memória, retorna erro
-        LOG_ERROR(MODULE_NAME, "Falha ao alocar memória para buffer de logs");
-        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+    // Formato: texto legível ou NDJSON (um objeto por linha)
+    String format = request->hasParam("format") ? request->getParam("format")->value() : "ndjson";
+    bool ndjson = !(format.equalsIgnoreCase("text") || format.equalsIgnoreCase("plain"));
+
+    // Nível mínimo: desconhecido é erro do cliente, não filtro silencioso
+    LogLevel minLevel = LogLevel::TRACE;
+    if (request->hasParam("level") &&
+        !LogRouter::getInstance().stringToLevel(request->getParam("level")->value().c_str(), minLevel)) {
+        request->send(400, "text/plain", "Nível de log inválido");
         return;
     }
 
-    // Inicializa o buffer
-    memset(logBuffer, 0, bufferSize);
+    // Sequências anteriores à entrada mais antiga são ajustadas por readSince()
+    uint32_t sequence = request->hasParam("since") ?
+        strtoul(request->getParam("since")->value().c_str(), nullptr, 10) : 0;
+
+    // A resposta termina nas entradas existentes agora; as seguintes ficam
+    // para a próxima consulta com since=end
+    uint32_t end = CircularLogBuffer::getInstance().getSequence();
+    size_t offset = 0;
+
+    // Lacuna pendente: entrada sobrescrita depois de parte da linha já enviada
+    bool gap = false;
+    uint32_t gapFrom = 0;
+    uint32_t gapTo = 0;
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse(
+        ndjson ? "application/x-ndjson" : "text/plain; charset=utf-8",
+        [sequence, end, offset, minLevel, ndjson, gap, gapFrom, gapTo](uint8_t *buffer, size_t maxLen,
+                                                                       size_t index) mutable -> size_t {
+            CircularLogBuffer &logBuffer = CircularLogBuffer::getInstance();
+            LogEntry entry;
+            char line[LOG_STREAM_LINE_SIZE];
+
+            while (true) {
+                size_t length;
+
+                if (gap) {
+                    length = formatLogGap(gapFrom, gapTo, ndjson, line, sizeof(line));
+                } else {
+                    if (sequence >= end) {
+                        return 0;
+                    }
 
-    // Obtém os logs do buffer circular
-    size_t bytesWritten = LogRouter::getInstance().getStoredLogs(logBuffer, bufferSize - 1);
+                    uint32_t read = sequence;
+                    bool available = logBuffer.readSince(read, &entry, 1) == 1 && read < end;
+
+                    if (!available || read != sequence) {
+                        // Entrada sobrescrita durante o envio: a linha já
+                        // começada é encerrada pelo registro de lacuna
+                        if (offset > 0) {
+                            gap = true;
+                            gapFrom = sequence;
+                            gapTo = available ? read : end;
+                            offset = 0;
+                        }
+                        sequence = available ? read : end;
+                        continue;
+                    }
 
-    if (bytesWritten == 0) {
-        // Se não há logs, retorna array vazio
-        delete[] logBuffer;
-        request->send(200, "application/json", "{\"logs\":[]}");
-        return;
-    }
+                    if (entry.level < minLevel) {
+                        sequence++;
+                        continue;
+                    }
 
-    // Verifica o parâmetro de formato - padrão é JSON
-    String format = request->hasParam("format") ? request->getParam("format")->value() : "json";
+                    // A linha é refeita a cada chamada; só o deslocamento é guardado
+                    length = formatLogLine(entry, sequence, ndjson, line, sizeof(line));
+                }
 
-    if (format.equalsIgnoreCase("text") || format.equalsIgnoreCase("plain")) {
-        // Retorna como texto simples
-        AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", logBuffer);
-        request->send(response);
-    } else {
-        // Formata como JSON
-        StaticJsonDocument<512> doc;
-        JsonArray logs = doc.createNestedArray("logs");
-
-        // Converte as linhas de log em um array JSON
-        char* line = strtok(logBuffer, "\n");
-        while (line != nullptr) {
-            if (strlen(line) > 0) {
-                logs.add(line);
-            }
-            line = strtok(nullptr, "\n");
-        }
+                size_t chunk = length - offset < maxLen ? length - offset : maxLen;
 
-        // Serializa o documento JSON
-        String jsonResponse;
-        serializeJson(doc, jsonResponse);
+                memcpy(buffer, line + offset, chunk);
+                offset += chunk;
+                if (offset >= length) {
+                    if (gap) {
+                        gap = false;
+                    } else {
+                        sequence++;
+                    }
+                    offset = 0;
+                }
 
-        // Envia a resposta
-        request->send(200, "application/json", jsonResponse);
-    }
+                return chunk;
+            }
+        });
 
-    // Libera o buffer
-    delete[] logBuffer;
+    char endStr[12];
+    snprintf(endStr, sizeof(endStr), "%u", end);
+    response->addHeader("X-Log-Sequence", endStr);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
 
     if (DEBUG_MODE) {
         {
             IPAddress ip = request->client()->remoteIP();
             char ipStr[16];
             snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-            DBG_DEBUG(MODULE_NAME, "API logs requisitada por %s (formato: %s)",
-                ipStr, format.c_str());
+            DBG_DEBUG(MODULE_NAME, "API logs requisitada por %s (formato: %s, desde: %u)",
+                ipStr, ndjson ? "ndjson" : "text", sequence);
+        }
+    }
+}
+
+size_t AsyncSoilWebServer::formatLogLine(const LogEntry &entry, uint32_t sequence, bool ndjson,
+                                         char *out, size_t size) {
+    const char *level = LogRouter::getInstance().levelToString(entry.level);
+    int written;
+
+    if (ndjson) {
+        // Strings referenciadas, não copiadas: o documento só guarda ponteiros
+        StaticJsonDocument<128> doc;
+        doc["seq"] = sequence;
+        doc["t"] = entry.timestamp;
+        doc["level"] = level;
+        doc["module"] = static_cast<const char*>(entry.module);
+        doc["msg"] = static_cast<const char*>(entry.message);
+
+        // Escapes podem estourar a linha; a mensagem é trocada para manter JSON válido
+        if (measureJson(doc) + 2 > size) {
+            doc["msg"] = "(mensagem muito longa)";
         }
+        written = serializeJson(doc, out, size - 1);
+        out[written++] = '\n';
+        out[written] = '\0';
+        return written;
+    }
+
+    written = snprintf(out, size, "%u [%5u.%03u][%-5s][%-10s] %s\n",
+        sequence, entry.timestamp / 1000, entry.timestamp % 1000,
+        level, entry.module, entry.message);
+
+    if (written < 0) {
+        return 0;
+    }
+    return (size_t)written < size ? written : size - 1;
+}
+
+size_t AsyncSoilWebServer::formatLogGap(uint32_t from, uint32_t to, bool ndjson, char *out, size_t size) {
+    int written = ndjson
+        ? snprintf(out, size, "\n{\"gap\":{\"from\":%u,\"to\":%u}}\n", from, to)
+        : snprintf(out, size, "\n%u [lacuna: entradas %u a %u sobrescritas durante o envio]\n",
+            from, from, to - 1);
+
+    if (written < 0) {
+        return 0;
+    }
+    return (size_t)written < size ? written : size - 1;
+}
+
+void AsyncSoilWebServer::handleCpu(AsyncWebServerRequest *request) {
+    CpuMonitor &cpuMonitor = CpuMonitor::getInstance();
+
+    // Escrito direto no stream da resposta, sem documento JSON na pilha
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->printf("{\"available\":%s,\"interval\":%u,\"cores\":[",
+        cpuMonitor.isAvailable() ? "true" : "false", CPU_SAMPLE_INTERVAL);
+
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        response->printf(core ? ",%u" : "%u", cpuMonitor.getCoreLoad(core));
+    }
+
+    // Histórico do mais antigo ao mais recente, um vetor por núcleo
+    response->print("],\"history\":[");
+    uint8_t history[CPU_LOAD_HISTORY];
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        size_t count = cpuMonitor.getHistory(core, history, CPU_LOAD_HISTORY);
+        response->print(core ? ",[" : "[");
+        for (size_t i = 0; i < count; i++) {
+            response->printf(i ? ",%u" : "%u", history[i]);
+        }
+        response->print("]");
+    }
+
+    response->print("],\"tasks\":[");
+    CpuTaskLoad tasks[CPU_MAX_TASKS];
+    size_t count = cpuMonitor.getTasks(tasks, CPU_MAX_TASKS);
+    for (size_t i = 0; i < count; i++) {
+        // Nomes de tarefas do FreeRTOS não contêm aspas
+        response->printf("%s{\"name\":\"%s\",\"core\":%d,\"load\":%u}",
+            i ? "," : "", tasks[i].name, tasks[i].core, tasks[i].load);
+    }
+    response->print("]}");
+
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+void AsyncSoilWebServer::handleMetrics(AsyncWebServerRequest *request) {
+    // Medidores amostrados só quando alguém lê: nenhum custo sem coletor
+    Metrics::sampleSystem();
+
+    const Metrics::Metric *metric = Metrics::Metric::first();
+    size_t line = 0;
+    size_t offset = 0;
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse(
+        "text/plain; version=0.0.4; charset=utf-8",
+        [metric, line, offset](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            while (metric) {
+                // A linha é refeita a cada chamada; só o cursor é guardado
+                char text[METRICS_LINE_SIZE];
+                size_t length = metric->formatLine(line, text, sizeof(text));
+
+                if (length == 0) {
+                    metric = metric->next();
+                    line = 0;
+                    continue;
+                }
+
+                size_t chunk = length - offset < maxLen ? length - offset : maxLen;
+                memcpy(buffer, text + offset, chunk);
+                offset += chunk;
+                if (offset >= length) {
+                    line++;
+                    offset = 0;
+                }
+
+                return chunk;
+            }
+
+            return 0;
+        });
+
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+void AsyncSoilWebServer::handleRulesGet(AsyncWebServerRequest *request) {
+    RuleStore &store = RuleStore::getInstance();
+
+    // O RuleStore só guarda nomes e expressões sem aspas, barras nem caracteres de controle
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->printf("{\"maxRules\":%u,\"maxExpression\":%u,\"maxCode\":%u,\"rules\":[",
+        RuleSet::MAX_RULES, RULE_SOURCE_SIZE - 1, RuleProgram::MAX_CODE);
+
+    for (uint8_t i = 0; i < store.getCount(); i++) {
+        const RuleSource *source = store.getSource(i);
+        response->printf("%s{\"name\":\"%s\",\"expr\":\"%s\",\"hold\":%u,\"clear\":%u}",
+            i ? "," : "", source->name, source->expression,
+            source->holdMs / 1000, source->clearMs / 1000);
     }
+    response->print("]}");
+
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+void AsyncSoilWebServer::handleRulesBody(AsyncWebServerRequest *request, uint8_t *data, size_t len,
+                                         size_t index, size_t total) {
+    // Corpo grande demais: nada é alocado e o handler responde 413
+    if (total > RULE_UPLOAD_MAX_SIZE) {
+        return;
+    }
+
+    if (index == 0) {
+        request->_tempObject = malloc(total + 1);
+    }
+
+    char *body = static_cast<char *>(request->_tempObject);
+    if (body == nullptr || index + len > total) {
+        return;
+    }
+
+    memcpy(body + index, data, len);
+    if (index + len == total) {
+        body[total] = '\0';
+    }
+}
+
+void AsyncSoilWebServer::handleRulesPost(AsyncWebServerRequest *request) {
+    if (request->contentLength() > RULE_UPLOAD_MAX_SIZE) {
+        request->send(413, "text/plain", "Corpo grande demais");
+        return;
+    }
+
+    char *body = static_cast<char *>(request->_tempObject);
+    if (body == nullptr) {
+        request->send(400, "text/plain", "Corpo ausente");
+        return;
+    }
+
+    // Strings apontam para o corpo, sem cópia
+    StaticJsonDocument<512> doc;
+    DeserializationError parseError = deserializeJson(doc, body);
+    if (parseError) {
+        request->send(400, "text/plain", "JSON inválido");
+        return;
+    }
+
+    RuleUpdateError error;
+    bool ok = applyRules(doc["rules"].as<JsonArrayConst>(), error);
+
+    char payload[160];
+    size_t length = formatRulesResult(ok, error, payload, sizeof(payload));
+    request->send(ok ? 200 : 400, "application/json", length > 0 ? payload : "{}");
+}
+
+bool AsyncSoilWebServer::applyRules(JsonArrayConst list, RuleUpdateError &error) {
+    error.rule = 0;
+    error.position = 0;
+
+    if (list.isNull()) {
+        error.message = "Lista de regras ausente";
+        return false;
+    }
+
+    RuleSource sources[RuleSet::MAX_RULES];
+    uint8_t count = 0;
+
+    for (JsonVariantConst item : list) {
+        JsonObjectConst rule = item.as<JsonObjectConst>();
+        error.rule = count;
+        if (count >= RuleSet::MAX_RULES) {
+            error.message = "Regras demais";
+            return false;
+        }
+
+        const char *name = rule["name"].as<const char *>();
+        const char *expression = rule["expr"].as<const char *>();
+        if (name == nullptr || expression == nullptr) {
+            error.message = "Regra sem name ou expr";
+            return false;
+        }
+
+        RuleSource &source = sources[count];
+        if (strlen(name) >= sizeof(source.name)) {
+            error.message = "Nome longo demais";
+            return false;
+        }
+        if (strlen(expression) >= sizeof(source.expression)) {
+            error.position = sizeof(source.expression) - 1;
+            error.message = "Expressão longa demais";
+            return false;
+        }
+
+        uint32_t hold = rule["hold"] | 0u;
+        uint32_t clear = rule["clear"] | 0u;
+        if (hold > RULE_MAX_DURATION || clear > RULE_MAX_DURATION) {
+            error.message = "hold ou clear fora da faixa";
+            return false;
+        }
+
+        strcpy(source.name, name);
+        strcpy(source.expression, expression);
+        source.holdMs = hold * 1000;
+        source.clearMs = clear * 1000;
+        count++;
+    }
+
+    return RuleStore::getInstance().update(sources, count, error);
+}
+
+size_t AsyncSoilWebServer::formatRulesResult(bool ok, const RuleUpdateError &error, char *out, size_t size) {
+    StaticJsonDocument<128> response;
+    response["type"] = "rules";
+    response["ok"] = ok;
+    if (ok) {
+        response["count"] = RuleStore::getInstance().getCount();
+    } else {
+        response["rule"] = error.rule;
+        response["pos"] = error.position;
+        response["error"] = error.message;
+    }
+
+    size_t length = serializeJson(response, out, size);
+    return length > 0 && length < size - 1 ? length : 0;
 }
 
 void AsyncSoilWebServer::handleNotFound(AsyncWebServerRequest *request) {
@@ -416,11 +603,12 @@ String AsyncSoilWebServer::prepareJsonMessage(bool dataOnly) {
 
     // Dados dos sensores
     JsonObject sensors = doc.createNestedObject("sensors");
-    const SensorData& data = m_sensorManager.getData();
+    SensorSnapshot snapshot;
+    m_sensorManager.getSnapshot(snapshot);
+    const SensorData& data = snapshot.data;
 
-    // Agora a temperatura já vem calibrada diretamente do sensor
-    // A calibração é aplicada em Hardware::readTemperature() através da função
-    // Hardware::getCalibrationTemperature()
+    // A temperatura já vem calibrada pela cadeia de processamento do
+    // SensorManager (SensorManager::TemperaturePipeline)
     sensors["temperature"] = data.temperature;
     sensors["humidity"] = data.humidityPercent;
     sensors["timestamp"] = data.timestamp;
@@ -449,43 +637,71 @@ String AsyncSoilWebServer::prepareJsonMessage(bool dataOnly) {
     return output;
 }
 
-bool AsyncSoilWebServer::update(bool forceUpdate) {
-    uint32_t currentTime = millis();
-
-    // Atualiza apenas a cada 100ms para limitar carga de rede (10Hz)
-    if (forceUpdate || (currentTime - m_lastBroadcastTime >= 100)) {
-        // Limpa clientes inativos a cada 5 segundos
-        if (currentTime % 5000 < 100) {
-            cleanClients();
-        }
-
-        // Apenas solicita atualização se houver clientes conectados
-        if (m_clientCount > 0) {
-            // Atualiza as estatísticas do sistema
-            SystemMonitor::getInstance().update();
-
-            // Solicita que o SensorManager atualize seus dados
-            m_sensorManager.update(forceUpdate);
+void AsyncSoilWebServer::attachScheduler(Scheduler *scheduler, uint32_t alertEvent, uint32_t clientEvent) {
+    m_scheduler = scheduler;
+    m_alertEvent = alertEvent;
+    m_clientEvent = clientEvent;
+}
 
-            {
-                // Escopo local para variável telemetry
-                TelemetryBuffer telemetry = m_sensorManager.prepareTelemetry();
+bool AsyncSoilWebServer::updateAlerts() {
+    if (m_alertBacklog || m_alertHead != m_alertDelivered) {
+        m_alertBacklog = deliverAlerts();
+    }
+    return m_alertBacklog;
+}
 
-                // Envia telemetria diretamente pelo WebSocket (centralizado)
-                TELEMETRY(MODULE_NAME, telemetry);
-            }
+bool AsyncSoilWebServer::broadcastTelemetry() {
+    // Apenas solicita atualização se houver clientes conectados
+    if (m_clientCount > 0) {
+        {
+            // Snapshot publicado pela tarefa de sensores (core 0), lido sem mutex
+            SensorSnapshot snapshot;
+            m_sensorManager.getSnapshot(snapshot);
 
-            // Atualiza timestamp e contador
-            m_lastBroadcastTime = currentTime;
-            m_broadcastCount++;
+            // Envia telemetria diretamente pelo WebSocket (centralizado)
+            TELEMETRY(MODULE_NAME, snapshot.telemetry);
+        }
 
-            if (DEBUG_MODE && m_broadcastCount % 100 == 0) { // Log apenas a cada 100 broadcasts
-                DBG_DEBUG(MODULE_NAME, "Dados enviados para %u clientes (envio #%u)",
-                    m_clientCount, m_broadcastCount);
+        // Atualiza contador
+        m_broadcastCount++;
+        Metrics::wsBroadcasts.inc();
+
+        if (DEBUG_MODE && m_broadcastCount % 100 == 0) { // Log apenas a cada 100 broadcasts
+            DBG_DEBUG(MODULE_NAME, "Dados enviados para %u clientes (envio #%u, releituras de snapshot: %u)",
+                m_clientCount, m_broadcastCount, m_sensorManager.getSnapshotRetryCount());
+
+            // Comparação de custo entre os formatos (médias por quadro)
+            const WireFormatStats &json = OutputManager::getJsonStats();
+            const WireFormatStats &binary = OutputManager::getBinaryStats();
+            DBG_DEBUG(MODULE_NAME, "Telemetria JSON: %u bytes, %u us | binária: %u bytes, %u us",
+                json.frames ? json.totalBytes / json.frames : 0,
+                json.frames ? json.totalUs / json.frames : 0,
+                binary.frames ? binary.totalBytes / binary.frames : 0,
+                binary.frames ? binary.totalUs / binary.frames : 0);
+            DBG_DEBUG(MODULE_NAME, "Pools de broadcast: JSON %u em uso (máx), %u esgotados | binário %u, %u",
+                m_jsonPool.getHighWater(), m_jsonPool.getExhaustedCount(),
+                m_binaryPool.getHighWater(), m_binaryPool.getExhaustedCount());
+
+            // Economia da telemetria incremental (bytes por cliente, CPU total)
+            DBG_DEBUG(MODULE_NAME, "Deltas: JSON %u omitidos, %u bytes/cliente, %u us | binário %u omitidos, %u bytes/cliente, %u us",
+                json.suppressed, json.savedBytes, json.savedUs,
+                binary.suppressed, binary.savedBytes, binary.savedUs);
+
+            DBG_DEBUG(MODULE_NAME, "/data: %u requisições, %u respostas 304, handler máx %u us",
+                m_dataRequests, m_dataNotModified, m_dataMaxUs);
+
+            // Fila de saída de cada cliente
+            ClientFlowStats flows[WS_MAX_SUBSCRIBERS];
+            size_t flowCount = getFlowStats(flows, WS_MAX_SUBSCRIBERS);
+            for (size_t i = 0; i < flowCount; i++) {
+                DBG_DEBUG(MODULE_NAME, "Cliente #%u: fila %u (máx %u), %u bytes em trânsito, %u conflacionados, %u logs descartados, %u alertas (%u perdidos)",
+                    flows[i].clientId, flows[i].queueDepth, flows[i].maxQueueDepth,
+                    flows[i].bytesInFlight, flows[i].conflated, flows[i].logsDropped,
+                    flows[i].alertsSent, flows[i].alertsLost);
             }
-
-            return true;
         }
+
+        return true;
     }
 
     return false;
@@ -495,6 +711,14 @@ uint16_t AsyncSoilWebServer::getClientCount() const {
     return m_clientCount;
 }
 
+uint16_t AsyncSoilWebServer::getJsonClientCount() const {
+    return m_subscriptions.count() - m_subscriptions.binaryCount();
+}
+
+uint16_t AsyncSoilWebServer::getBinaryClientCount() const {
+    return m_subscriptions.binaryCount();
+}
+
 bool AsyncSoilWebServer::broadcastMessage(const String &message) {
     // Envia a mensagem para todos os clientes
     m_websocket.textAll(message);
@@ -503,13 +727,214 @@ bool AsyncSoilWebServer::broadcastMessage(const String &message) {
     return (m_clientCount > 0);
 }
 
+bool AsyncSoilWebServer::broadcastBinary(const uint8_t *data, size_t len) {
+    m_binarySocket.binaryAll(reinterpret_cast<const char *>(data), len);
+
+    return (m_binarySocket.count() > 0);
+}
+
+AsyncWebSocketMessageBuffer *AsyncSoilWebServer::acquireJsonBuffer(size_t length) {
+    return m_jsonPool.acquire(length);
+}
+
+AsyncWebSocketMessageBuffer *AsyncSoilWebServer::acquireBinaryBuffer(size_t length) {
+    return m_binaryPool.acquire(length);
+}
+
+AsyncWebSocketMessageBuffer *AsyncSoilWebServer::acquireLogBuffer(size_t length) {
+    return m_logPool.acquire(length);
+}
+
+size_t AsyncSoilWebServer::getSubscriptions(ClientSubscription *out, size_t maxCount) const {
+    return m_subscriptions.copy(out, maxCount);
+}
+
+AsyncWebSocketClient *AsyncSoilWebServer::findClient(const ClientSubscription &subscription) {
+    AsyncWebSocket &socket = subscription.binaryEndpoint ? m_binarySocket : m_websocket;
+    AsyncWebSocketClient *client = socket.client(subscription.clientId);
+    if (!client || client->status() != WS_CONNECTED) {
+        return nullptr;
+    }
+
+    return client;
+}
+
+void AsyncSoilWebServer::sampleFlow(AsyncWebSocketClient *client, ClientFlowStats &flow) {
+    flow.queueDepth = client->queueLen();
+    if (flow.queueDepth > flow.maxQueueDepth) {
+        flow.maxQueueDepth = flow.queueDepth;
+    }
+
+    // Mensagens na fila da biblioteca (tamanho médio) mais o buffer TCP não confirmado
+    AsyncClient *tcp = client->client();
+    size_t space = tcp ? tcp->space() : WS_TCP_SEND_BUFFER;
+    uint32_t unacked = space < WS_TCP_SEND_BUFFER ? WS_TCP_SEND_BUFFER - space : 0;
+    flow.bytesInFlight = static_cast<uint32_t>(flow.queueDepth) * flow.avgFrameBytes + unacked;
+}
+
+bool AsyncSoilWebServer::sendTelemetry(const ClientSubscription &subscription,
+                                       AsyncWebSocketMessageBuffer *buffer) {
+    AsyncWebSocketClient *client = findClient(subscription);
+    ClientFlowStats flow;
+    if (!client || !m_subscriptions.getFlow(subscription.clientId, subscription.binaryEndpoint, flow)) {
+        return false;
+    }
+
+    sampleFlow(client, flow);
+    bool sent = true;
+
+    if (flow.queueDepth >= WS_CONFLATE_QUEUE_DEPTH) {
+        // Cliente atrasado: o quadro é substituído pelo próximo em vez de se acumular
+        flow.conflated++;
+        flow.resync = true;
+        Metrics::wsFramesConflated.inc();
+        sent = false;
+    } else if (flow.resync) {
+        // Os deltas perdidos são cobertos pelo estado atual completo
+        SensorSnapshot snapshot;
+        m_sensorManager.getSnapshot(snapshot);
+        OutputManager::telemetrySnapshot(client, subscription, snapshot.telemetry);
+        flow.resync = false;
+    } else if (subscription.binary) {
+        // Cada cliente referencia o mesmo buffer; nenhuma cópia do payload
+        client->binary(buffer);
+    } else {
+        client->text(buffer);
+    }
+
+    if (sent) {
+        // Média móvel (1/8) usada na estimativa de bytes em trânsito
+        uint16_t length = static_cast<uint16_t>(buffer->length());
+        flow.avgFrameBytes = flow.avgFrameBytes == 0 ? length : (flow.avgFrameBytes * 7 + length) / 8;
+        flow.framesSent++;
+        Metrics::wsFramesSent.inc();
+    }
+
+    m_subscriptions.setFlow(flow);
+    return sent;
+}
+
+bool AsyncSoilWebServer::sendLog(const ClientSubscription &subscription, AsyncWebSocketMessageBuffer *buffer) {
+    AsyncWebSocketClient *client = findClient(subscription);
+    ClientFlowStats flow;
+    if (!client || !m_subscriptions.getFlow(subscription.clientId, subscription.binaryEndpoint, flow)) {
+        return false;
+    }
+
+    sampleFlow(client, flow);
+    bool sent = flow.queueDepth < WS_CONFLATE_QUEUE_DEPTH;
+
+    if (sent) {
+        client->text(buffer);
+    } else {
+        flow.logsDropped++;
+    }
+
+    m_subscriptions.setFlow(flow);
+    return sent;
+}
+
+void AsyncSoilWebServer::queueAlert(const char *module, LogLevel level, const char *message) {
+    StaticJsonDocument<128> doc;
+    doc["type"] = "alert";
+    doc["t"] = millis();
+    doc["level"] = LogRouter::getInstance().levelToString(level);
+    doc["module"] = module ? module : "SYS";
+    doc["msg"] = message;
+
+    char payload[WS_ALERT_FRAME_SIZE];
+    size_t length = serializeJson(doc, payload, sizeof(payload));
+
+    // Mensagem longa demais: serializeJson truncaria o JSON, então a mensagem é encurtada
+    if (length == 0 || length >= sizeof(payload) - 1) {
+        char shortMessage[WS_ALERT_FRAME_SIZE / 2];
+        StringUtils::safeCopyString(shortMessage, message, sizeof(shortMessage));
+        doc["msg"] = static_cast<const char *>(shortMessage);
+        length = serializeJson(doc, payload, sizeof(payload));
+        if (length == 0 || length >= sizeof(payload) - 1) {
+            return;
+        }
+    }
+
+    portENTER_CRITICAL(&m_alertLock);
+    AlertSlot &slot = m_alerts[m_alertHead % WS_ALERT_QUEUE_SIZE];
+    memcpy(slot.payload, payload, length);
+    slot.length = static_cast<uint16_t>(length);
+    m_alertHead = m_alertHead + 1;
+    portEXIT_CRITICAL(&m_alertLock);
+
+    // Entrega imediata pela tarefa web
+    if (m_scheduler != nullptr) {
+        m_scheduler->notify(m_alertEvent);
+    }
+}
+
+bool AsyncSoilWebServer::deliverAlerts() {
+    uint32_t head = m_alertHead;
+    bool backlog = false;
+
+    ClientSubscription subscriptions[WS_MAX_SUBSCRIBERS];
+    size_t count = m_subscriptions.copy(subscriptions, WS_MAX_SUBSCRIBERS);
+    char payload[WS_ALERT_FRAME_SIZE];
+
+    for (size_t i = 0; i < count; i++) {
+        AsyncWebSocketClient *client = findClient(subscriptions[i]);
+        ClientFlowStats flow;
+        if (!client || !m_subscriptions.getFlow(subscriptions[i].clientId, subscriptions[i].binaryEndpoint, flow)) {
+            continue;
+        }
+
+        while (flow.alertSequence != head) {
+            // Alertas usam a folga da fila acima de WS_CONFLATE_QUEUE_DEPTH; com a
+            // fila cheia ficam pendentes para a próxima passagem
+            if (client->queueIsFull()) {
+                backlog = true;
+                break;
+            }
+
+            uint16_t length = 0;
+            uint32_t oldest;
+
+            portENTER_CRITICAL(&m_alertLock);
+            oldest = m_alertHead > WS_ALERT_QUEUE_SIZE ? m_alertHead - WS_ALERT_QUEUE_SIZE : 0;
+            if (flow.alertSequence >= oldest) {
+                const AlertSlot &slot = m_alerts[flow.alertSequence % WS_ALERT_QUEUE_SIZE];
+                length = slot.length;
+                memcpy(payload, slot.payload, length);
+            }
+            portEXIT_CRITICAL(&m_alertLock);
+
+            if (length == 0) {
+                // Sobrescrito no anel antes que o cliente tivesse espaço na fila
+                flow.alertsLost += oldest - flow.alertSequence;
+                flow.alertSequence = oldest;
+                continue;
+            }
+
+            client->text(payload, length);
+            flow.alertSequence++;
+            flow.alertsSent++;
+        }
+
+        m_subscriptions.setFlow(flow);
+    }
+
+    m_alertDelivered = head;
+    return backlog;
+}
+
+size_t AsyncSoilWebServer::getFlowStats(ClientFlowStats *out, size_t maxCount) const {
+    return m_subscriptions.copyFlow(out, maxCount);
+}
+
 uint16_t AsyncSoilWebServer::cleanClients() {
     // Limpa clientes inativos
     uint16_t initialCount = m_clientCount;
     m_websocket.cleanupClients();
+    m_binarySocket.cleanupClients();
 
     // Atualiza contagem de clientes
-    m_clientCount = m_websocket.count();
+    m_clientCount = m_websocket.count() + m_binarySocket.count();
 
     uint16_t removedCount = initialCount - m_clientCount;
     if (removedCount > 0 && DEBUG_MODE) {
@@ -531,22 +956,33 @@ void AsyncSoilWebServer::handleWebSocketEvent(AsyncWebSocket *server,
                 DBG_DEBUG(MODULE_NAME, "WebSocket: Cliente #%u conectado", client->id());
             }
 
-            // Atualiza estatísticas do sistema antes de enviar
-            SystemMonitor::getInstance().update();
+            {
+                // Escopo local para as variáveis, evitando erro de salto sobre inicialização
+                // Assinatura padrão do endpoint: telemetria completa a 10 Hz
+                ClientSubscription subscription;
+                if (!m_subscriptions.add(client->id(), server == &m_binarySocket, m_alertHead, subscription)) {
+                    LOG_WARN(MODULE_NAME, "WebSocket: limite de %u clientes atingido, cliente #%u recusado",
+                        WS_MAX_SUBSCRIBERS, client->id());
+                    client->close();
+                    break;
+                }
 
-            // Força uma atualização dos sensores para ter valores mais atuais
-            m_sensorManager.update(true);
+                // Os envios são incrementais: o novo cliente recebe um quadro completo
+                SensorSnapshot snapshot;
+                m_sensorManager.getSnapshot(snapshot);
+                OutputManager::telemetrySnapshot(client, subscription, snapshot.telemetry);
+            }
 
-            {
-                // Escopo local para variável telemetry para evitar erro de salto sobre inicialização
-                TelemetryBuffer telemetry = m_sensorManager.prepareTelemetry();
-                TELEMETRY(MODULE_NAME, telemetry);
+            // Retoma o job de broadcast, suspenso enquanto não havia clientes
+            if (m_scheduler != nullptr) {
+                m_scheduler->notify(m_clientEvent);
             }
             break;
 
         case WS_EVT_DISCONNECT:
             // Cliente desconectado
             m_clientCount--;
+            m_subscriptions.remove(client->id(), server == &m_binarySocket);
             if (DEBUG_MODE) {
                 DBG_DEBUG(MODULE_NAME, "WebSocket: Cliente #%u desconectado", client->id());
             }
@@ -589,8 +1025,8 @@ void AsyncSoilWebServer::processWebSocketCommand(AsyncWebSocketClient *client,
     memcpy(commandStr, data, len);
     commandStr[len] = '\0';
 
-    // Analisa o comando JSON
-    StaticJsonDocument<256> doc;
+    // Analisa o comando JSON (o comando rules traz até RuleSet::MAX_RULES objetos)
+    StaticJsonDocument<512> doc;
     DeserializationError error = deserializeJson(doc, commandStr);
 
     if (error) {
@@ -608,6 +1044,19 @@ void AsyncSoilWebServer::processWebSocketCommand(AsyncWebSocketClient *client,
         String responseStr;
         serializeJson(response, responseStr);
         client->text(responseStr);
+        } else if (strcmp(action, "subscribe") == 0) {
+            processSubscription(client, doc, true);
+        } else if (strcmp(action, "unsubscribe") == 0) {
+            processSubscription(client, doc, false);
+        } else if (strcmp(action, "rules") == 0) {
+            RuleUpdateError ruleError;
+            bool ok = applyRules(doc["rules"].as<JsonArrayConst>(), ruleError);
+
+            char payload[160];
+            size_t length = formatRulesResult(ok, ruleError, payload, sizeof(payload));
+            if (length > 0) {
+                client->text(payload, length);
+            }
         } else {
             LOG_WARN(MODULE_NAME, "Ação desconhecida recebida: %s", action);
         }
@@ -616,6 +1065,82 @@ void AsyncSoilWebServer::processWebSocketCommand(AsyncWebSocketClient *client,
     delete[] commandStr;
 }
 
+void AsyncSoilWebServer::processSubscription(AsyncWebSocketClient *client,
+                                            JsonDocument &command, bool subscribe) {
+    ClientSubscription subscription;
+    if (!m_subscriptions.find(client->id(), client->server() == &m_binarySocket, subscription)) {
+        return;
+    }
+
+    // Tópicos listados; ausentes mantêm a assinatura atual (subscribe) ou removem todos (unsubscribe)
+    uint8_t topics = subscribe ? subscription.topics : WS_TOPICS_DEFAULT | WS_TOPIC_LOGS;
+    JsonArray topicList = command["topics"].as<JsonArray>();
+    if (!topicList.isNull()) {
+        topics = 0;
+        for (JsonVariant topic : topicList) {
+            const char *name = topic.as<const char *>();
+            uint8_t bit = SubscriptionTable::parseTopic(name);
+            if (bit == 0) {
+                LOG_WARN(MODULE_NAME, "Tópico desconhecido: %s", name ? name : "?");
+            }
+            topics |= bit;
+        }
+    }
+    subscription.topics = subscribe ? topics : (subscription.topics & ~topics);
+
+    if (subscribe) {
+        // Taxa máxima em Hz, arredondada para baixo até uma classe compartilhada
+        float rate = command["rate"] | 0.0f;
+        if (rate > 0.0f) {
+            subscription.rateClass = SubscriptionTable::rateClassFor(rate);
+        }
+
+        const char *format = command["format"];
+        if (format) {
+            if (strcmp(format, "binary") == 0) {
+                subscription.binary = true;
+            } else if (strcmp(format, "json") == 0) {
+                subscription.binary = false;
+            } else {
+                LOG_WARN(MODULE_NAME, "Formato desconhecido: %s", format);
+            }
+        }
+    }
+
+    if (!m_subscriptions.update(subscription)) {
+        return;
+    }
+
+    // Confirma a assinatura efetiva
+    StaticJsonDocument<192> response;
+    response["type"] = "subscribed";
+    JsonArray active = response.createNestedArray("topics");
+    for (uint8_t bit = WS_TOPIC_SENSORS; bit <= WS_TOPIC_LOGS; bit <<= 1) {
+        if (subscription.topics & bit) {
+            active.add(SubscriptionTable::topicName(bit));
+        }
+    }
+    response["rate"] = 1000.0f / SubscriptionTable::ratePeriod(subscription.rateClass);
+    response["format"] = subscription.binary ? "binary" : "json";
+
+    char payload[192];
+    size_t length = serializeJson(response, payload, sizeof(payload));
+    if (length > 0 && length < sizeof(payload) - 1) {
+        client->text(payload, length);
+    }
+
+    // Estado completo no novo formato e classe; os envios seguintes são incrementais
+    SensorSnapshot snapshot;
+    m_sensorManager.getSnapshot(snapshot);
+    OutputManager::telemetrySnapshot(client, subscription, snapshot.telemetry);
+
+    if (DEBUG_MODE) {
+        DBG_DEBUG(MODULE_NAME, "WebSocket: Cliente #%u assinou tópicos 0x%02X a %u ms (%s)",
+            client->id(), subscription.topics, SubscriptionTable::ratePeriod(subscription.rateClass),
+            subscription.binary ? "binário" : "JSON");
+    }
+}
+
 void AsyncSoilWebServer::onWebSocketEvent(AsyncWebSocket *server,
                                         AsyncWebSocketClient *client,
                                         AwsEventType type, void *arg, uint8_t *data,
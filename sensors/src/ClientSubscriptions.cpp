@@ -0,0 +1,234 @@
+/**
+ * @file ClientSubscriptions.cpp
+ * @brief Implementação da tabela de assinaturas WebSocket.
+ */
+
+#include "ClientSubscriptions.h"
+#include "TelemetryBuffer.h"
+
+const uint32_t SubscriptionTable::s_ratePeriods[WS_RATE_CLASS_COUNT] = WS_RATE_CLASS_PERIODS;
+
+SubscriptionTable::SubscriptionTable()
+    : m_lock(portMUX_INITIALIZER_UNLOCKED) {
+}
+
+bool SubscriptionTable::add(uint32_t clientId, bool binaryEndpoint, uint32_t alertSequence,
+                            ClientSubscription &out) {
+    // Padrão compatível com os endpoints: telemetria completa na taxa máxima
+    out = ClientSubscription();
+    out.clientId = clientId;
+    out.binaryEndpoint = binaryEndpoint;
+    out.binary = binaryEndpoint;
+    out.topics = WS_TOPICS_DEFAULT;
+    out.rateClass = 0;
+
+    bool added = false;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId == 0) {
+            m_entries[i] = out;
+            m_flow[i] = ClientFlowStats();
+            m_flow[i].clientId = clientId;
+            m_flow[i].binaryEndpoint = binaryEndpoint;
+            m_flow[i].alertSequence = alertSequence;
+            added = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return added;
+}
+
+void SubscriptionTable::remove(uint32_t clientId, bool binaryEndpoint) {
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId == clientId && m_entries[i].binaryEndpoint == binaryEndpoint) {
+            m_entries[i] = ClientSubscription();
+            m_flow[i] = ClientFlowStats();
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+}
+
+bool SubscriptionTable::update(const ClientSubscription &subscription) {
+    bool found = false;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId == subscription.clientId &&
+            m_entries[i].binaryEndpoint == subscription.binaryEndpoint) {
+            m_entries[i] = subscription;
+            found = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return found;
+}
+
+bool SubscriptionTable::find(uint32_t clientId, bool binaryEndpoint, ClientSubscription &out) const {
+    bool found = false;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId == clientId && m_entries[i].binaryEndpoint == binaryEndpoint) {
+            out = m_entries[i];
+            found = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return found;
+}
+
+size_t SubscriptionTable::copy(ClientSubscription *out, size_t maxCount) const {
+    size_t count = 0;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS && count < maxCount; i++) {
+        if (m_entries[i].clientId != 0) {
+            out[count++] = m_entries[i];
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return count;
+}
+
+bool SubscriptionTable::getFlow(uint32_t clientId, bool binaryEndpoint, ClientFlowStats &out) const {
+    bool found = false;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId == clientId && m_entries[i].binaryEndpoint == binaryEndpoint) {
+            out = m_flow[i];
+            found = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return found;
+}
+
+void SubscriptionTable::setFlow(const ClientFlowStats &flow) {
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        // O cliente pode ter se desconectado desde getFlow()
+        if (m_entries[i].clientId == flow.clientId && m_entries[i].binaryEndpoint == flow.binaryEndpoint) {
+            m_flow[i] = flow;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+}
+
+size_t SubscriptionTable::copyFlow(ClientFlowStats *out, size_t maxCount) const {
+    size_t count = 0;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS && count < maxCount; i++) {
+        if (m_entries[i].clientId != 0) {
+            out[count++] = m_flow[i];
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return count;
+}
+
+void SubscriptionTable::clear() {
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        m_entries[i] = ClientSubscription();
+        m_flow[i] = ClientFlowStats();
+    }
+    portEXIT_CRITICAL(&m_lock);
+}
+
+uint16_t SubscriptionTable::count() const {
+    uint16_t count = 0;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId != 0) {
+            count++;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return count;
+}
+
+uint16_t SubscriptionTable::binaryCount() const {
+    uint16_t count = 0;
+
+    portENTER_CRITICAL(&m_lock);
+    for (size_t i = 0; i < WS_MAX_SUBSCRIBERS; i++) {
+        if (m_entries[i].clientId != 0 && m_entries[i].binary) {
+            count++;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return count;
+}
+
+uint8_t SubscriptionTable::rateClassFor(float hz) {
+    // Classes ordenadas da mais rápida para a mais lenta
+    for (uint8_t i = 0; i < WS_RATE_CLASS_COUNT; i++) {
+        if (hz * s_ratePeriods[i] >= 1000.0f) {
+            return i;
+        }
+    }
+
+    return WS_RATE_CLASS_COUNT - 1;
+}
+
+uint32_t SubscriptionTable::ratePeriod(uint8_t rateClass) {
+    return s_ratePeriods[rateClass < WS_RATE_CLASS_COUNT ? rateClass : WS_RATE_CLASS_COUNT - 1];
+}
+
+uint16_t SubscriptionTable::topicFields(uint8_t topics) {
+    uint16_t fields = 0;
+
+    if (topics & WS_TOPIC_SENSORS) {
+        fields |= TELEMETRY_FIELD_TIMESTAMP | TELEMETRY_FIELD_READ_COUNT |
+                  TELEMETRY_FIELD_TEMPERATURE | TELEMETRY_FIELD_HUMIDITY |
+                  TELEMETRY_FIELD_TREND;
+    }
+    if (topics & WS_TOPIC_STATS) {
+        fields |= TELEMETRY_FIELD_CLIENTS | TELEMETRY_FIELD_FREE_HEAP |
+                  TELEMETRY_FIELD_UPTIME | TELEMETRY_FIELD_FRAGMENTATION |
+                  TELEMETRY_FIELD_CPU_LOAD;
+    }
+    if (topics & WS_TOPIC_WIFI) {
+        fields |= TELEMETRY_FIELD_IP_ADDRESS | TELEMETRY_FIELD_WIFI_RSSI;
+    }
+
+    return fields;
+}
+
+uint8_t SubscriptionTable::parseTopic(const char *name) {
+    if (!name) return 0;
+    if (strcmp(name, "sensors") == 0) return WS_TOPIC_SENSORS;
+    if (strcmp(name, "stats") == 0) return WS_TOPIC_STATS;
+    if (strcmp(name, "wifi") == 0) return WS_TOPIC_WIFI;
+    if (strcmp(name, "logs") == 0) return WS_TOPIC_LOGS;
+    return 0;
+}
+
+const char *SubscriptionTable::topicName(uint8_t topic) {
+    switch (topic) {
+        case WS_TOPIC_SENSORS: return "sensors";
+        case WS_TOPIC_STATS: return "stats";
+        case WS_TOPIC_WIFI: return "wifi";
+        case WS_TOPIC_LOGS: return "logs";
+        default: return "";
+    }
+}
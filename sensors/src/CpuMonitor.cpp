@@ -0,0 +1,204 @@
+/**
+ * @file CpuMonitor.cpp
+ * @brief Implementação da medição de carga da CPU.
+ */
+
+#include "CpuMonitor.h"
+#include "LogSystem.h"
+#include "StringUtils.h"
+
+// Define o nome do módulo para logging
+#define MODULE_NAME "CpuMonitor"
+
+CpuMonitor *CpuMonitor::s_instance = nullptr;
+
+CpuMonitor::CpuMonitor()
+    : m_lastTotal(0),
+    m_counterCount(0),
+    m_available(configGENERATE_RUN_TIME_STATS == 1 && configUSE_TRACE_FACILITY == 1),
+    m_historyHead(0),
+    m_historyCount(0),
+    m_taskCount(0),
+    m_lock(portMUX_INITIALIZER_UNLOCKED) {
+    memset(m_counters, 0, sizeof(m_counters));
+    memset(m_coreLoad, 0, sizeof(m_coreLoad));
+    memset(m_history, 0, sizeof(m_history));
+
+    if (!m_available) {
+        LOG_WARN(MODULE_NAME, "FreeRTOS sem contadores de tempo de execução; carga da CPU indisponível");
+    }
+}
+
+CpuMonitor &CpuMonitor::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new CpuMonitor();
+    }
+    return *s_instance;
+}
+
+bool CpuMonitor::update() {
+    if (!m_available) {
+        return false;
+    }
+
+    return sample();
+}
+
+bool CpuMonitor::sample() {
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+    // Estáticos: só a tarefa web amostra, e a pilha dela é pequena
+    static TaskStatus_t status[CPU_MAX_TASKS];
+    static CpuTaskLoad tasks[CPU_MAX_TASKS];
+    static TaskCounter counters[CPU_MAX_TASKS];
+
+    // Instantâneo de todas as tarefas (suspende o escalonador brevemente)
+    uint32_t total = 0;
+    UBaseType_t count = uxTaskGetSystemState(status, CPU_MAX_TASKS, &total);
+    if (count == 0) {
+        LOG_WARN(MODULE_NAME, "Mais de %u tarefas; amostra de CPU ignorada", CPU_MAX_TASKS);
+        return false;
+    }
+
+    // Primeira amostra: apenas referência
+    uint32_t elapsed = total - m_lastTotal;
+    bool first = m_lastTotal == 0;
+    m_lastTotal = total;
+
+    uint8_t coreLoad[portNUM_PROCESSORS];
+    memset(coreLoad, 0, sizeof(coreLoad));
+    size_t taskCount = 0;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        // Tempo no intervalo: diferença do contador da mesma tarefa (0 se nova)
+        uint32_t previous = status[i].ulRunTimeCounter;
+        for (size_t j = 0; j < m_counterCount; j++) {
+            if (m_counters[j].handle == status[i].xHandle) {
+                previous = m_counters[j].runTime;
+                break;
+            }
+        }
+        counters[i].handle = status[i].xHandle;
+        counters[i].runTime = status[i].ulRunTimeCounter;
+
+        if (first || elapsed == 0) {
+            continue;
+        }
+
+        uint32_t busy = status[i].ulRunTimeCounter - previous;
+        uint64_t percent = (uint64_t)busy * 100 / elapsed;
+        uint8_t load = static_cast<uint8_t>(percent > 100 ? 100 : percent);
+
+        // Tarefas ociosas determinam a carga do núcleo
+        bool idle = false;
+        for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+            if (status[i].xHandle == xTaskGetIdleTaskHandleForCPU(core)) {
+                coreLoad[core] = 100 - load;
+                idle = true;
+            }
+        }
+        if (idle) {
+            continue;
+        }
+
+        // Inserção ordenada por carga (poucas tarefas)
+        CpuTaskLoad entry;
+        StringUtils::safeCopyString(entry.name, status[i].pcTaskName, sizeof(entry.name));
+        BaseType_t affinity = xTaskGetAffinity(status[i].xHandle);
+        entry.core = affinity == tskNO_AFFINITY ? -1 : static_cast<int8_t>(affinity);
+        entry.load = load;
+
+        size_t position = taskCount;
+        while (position > 0 && tasks[position - 1].load < load) {
+            tasks[position] = tasks[position - 1];
+            position--;
+        }
+        tasks[position] = entry;
+        taskCount++;
+    }
+
+    memcpy(m_counters, counters, sizeof(TaskCounter) * count);
+    m_counterCount = count;
+
+    if (first || elapsed == 0) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&m_lock);
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        m_coreLoad[core] = coreLoad[core];
+        m_history[core][m_historyHead] = coreLoad[core];
+    }
+    m_historyHead = (m_historyHead + 1) % CPU_LOAD_HISTORY;
+    if (m_historyCount < CPU_LOAD_HISTORY) {
+        m_historyCount++;
+    }
+    for (size_t i = 0; i < taskCount; i++) {
+        m_tasks[i] = tasks[i];
+    }
+    m_taskCount = taskCount;
+    portEXIT_CRITICAL(&m_lock);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool CpuMonitor::isAvailable() const {
+    return m_available;
+}
+
+uint8_t CpuMonitor::getCoreLoad(uint8_t core) const {
+    if (core >= portNUM_PROCESSORS) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&m_lock);
+    uint8_t load = m_coreLoad[core];
+    portEXIT_CRITICAL(&m_lock);
+
+    return load;
+}
+
+uint8_t CpuMonitor::getLoad() const {
+    uint32_t sum = 0;
+
+    portENTER_CRITICAL(&m_lock);
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        sum += m_coreLoad[core];
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return static_cast<uint8_t>(sum / portNUM_PROCESSORS);
+}
+
+size_t CpuMonitor::getHistory(uint8_t core, uint8_t *out, size_t maxCount) const {
+    if (!out || core >= portNUM_PROCESSORS) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&m_lock);
+    size_t count = m_historyCount < maxCount ? m_historyCount : maxCount;
+    size_t start = (m_historyHead + CPU_LOAD_HISTORY - count) % CPU_LOAD_HISTORY;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = m_history[core][(start + i) % CPU_LOAD_HISTORY];
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return count;
+}
+
+size_t CpuMonitor::getTasks(CpuTaskLoad *out, size_t maxCount) const {
+    if (!out) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&m_lock);
+    size_t count = m_taskCount < maxCount ? m_taskCount : maxCount;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = m_tasks[i];
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    return count;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file Dht22Decoder.cpp
+ * @brief Implementação da decodificação de quadros do DHT22.
+ */
+
+#include "Dht22Decoder.h"
+
+Dht22Decoder::Status Dht22Decoder::decode(const Pulse *pulses, size_t count,
+                                          float &temperature, float &humidity) {
+    if (!pulses || count == 0) {
+        return Status::NO_RESPONSE;
+    }
+
+    // Localiza a resposta do sensor: ~80 μs em nível baixo seguido de ~80 μs em alto
+    size_t index = 0;
+    bool found = false;
+    for (; index + 1 < count; index++) {
+        const Pulse &low = pulses[index];
+        const Pulse &high = pulses[index + 1];
+        if (low.level == 0 && high.level == 1 &&
+            low.durationUs >= RESPONSE_MIN_US && low.durationUs <= RESPONSE_MAX_US &&
+            high.durationUs >= RESPONSE_MIN_US && high.durationUs <= RESPONSE_MAX_US) {
+            found = true;
+            break;
+        }
+    }
+
+    if (!found) {
+        return Status::NO_RESPONSE;
+    }
+
+    index += 2;
+
+    // 40 bits: cada bit é ~50 μs baixo seguido de 26-28 μs (0) ou 70 μs (1) alto
+    if (count - index < 80) {
+        return Status::FRAME_ERROR;
+    }
+
+    uint8_t bytes[5] = {0};
+    for (uint8_t bit = 0; bit < 40; bit++) {
+        const Pulse &low = pulses[index++];
+        const Pulse &high = pulses[index++];
+
+        if (low.level != 0 || high.level != 1) {
+            return Status::FRAME_ERROR;
+        }
+
+        bytes[bit / 8] <<= 1;
+        if (high.durationUs > low.durationUs) {
+            bytes[bit / 8] |= 1;
+        }
+    }
+
+    uint8_t checksum = static_cast<uint8_t>(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+    if (checksum != bytes[4]) {
+        return Status::CHECKSUM_ERROR;
+    }
+
+    humidity = static_cast<float>((static_cast<uint16_t>(bytes[0]) << 8) | bytes[1]) * 0.1f;
+
+    temperature = static_cast<float>((static_cast<uint16_t>(bytes[2] & 0x7F) << 8) | bytes[3]) * 0.1f;
+    if (bytes[2] & 0x80) {
+        temperature = -temperature;
+    }
+
+    return Status::OK;
+}
+
+const char *Dht22Decoder::statusToString(Status status) {
+    switch (status) {
+        case Status::NONE:           return "sem leitura";
+        case Status::OK:             return "ok";
+        case Status::NO_RESPONSE:    return "sem resposta";
+        case Status::FRAME_ERROR:    return "quadro inválido";
+        case Status::CHECKSUM_ERROR: return "checksum inválido";
+    }
+    return "desconhecido";
+}
@@ -0,0 +1,241 @@
+/**
+ * @file Dht22Reader.cpp
+ * @brief Implementação da aquisição não bloqueante do DHT22.
+ */
+
+#include "Dht22Reader.h"
+#include "LogSystem.h"
+#include "Metrics.h"
+#include <driver/gpio.h>
+
+// Nome do módulo para logs
+#define MODULE_NAME "DHT22"
+
+Dht22Reader::Dht22Reader(uint8_t pin, rmt_channel_t channel)
+    : m_pin(pin),
+    m_channel(channel),
+    m_ringBuffer(nullptr),
+    m_startTimer(nullptr),
+    m_dht(pin, DHT22),
+    m_state(STATE_IDLE),
+    m_transactionStart(0),
+    m_ready(false),
+    m_successCount(0),
+    m_errorCount(0) {
+}
+
+bool Dht22Reader::begin() {
+    if (!DHT22_USE_RMT) {
+        // Modo de compatibilidade: transação única via biblioteca, sem retentativas
+        m_dht.begin(60);
+        m_ready = true;
+        LOG_INFO(MODULE_NAME, "Aquisição via biblioteca DHT (RMT desativado)");
+        return true;
+    }
+
+    // Canal RMT em modo de recepção com resolução de 1 μs (APB 80 MHz / 80)
+    rmt_config_t config = RMT_DEFAULT_CONFIG_RX(static_cast<gpio_num_t>(m_pin), m_channel);
+    config.clk_div = 80;
+    config.mem_block_num = 1;
+    config.rx_config.filter_en = true;
+    config.rx_config.filter_ticks_thresh = 100;   // Ignora glitches < ~1,25 μs
+    config.rx_config.idle_threshold = 1000;       // Fim do quadro após 1 ms ocioso
+
+    if (rmt_config(&config) != ESP_OK ||
+        rmt_driver_install(m_channel, 1024, 0) != ESP_OK) {
+        LOG_ERROR(MODULE_NAME, "Falha ao configurar canal RMT %d", m_channel);
+        return false;
+    }
+
+    if (rmt_get_ringbuf_handle(m_channel, &m_ringBuffer) != ESP_OK || !m_ringBuffer) {
+        LOG_ERROR(MODULE_NAME, "Falha ao obter ring buffer do RMT");
+        return false;
+    }
+
+    // Linha em dreno aberto: o host apenas puxa para nível baixo,
+    // e a entrada continua roteada para o RMT pela matriz de GPIO
+    gpio_set_pull_mode(static_cast<gpio_num_t>(m_pin), GPIO_PULLUP_ONLY);
+    gpio_set_direction(static_cast<gpio_num_t>(m_pin), GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_level(static_cast<gpio_num_t>(m_pin), 1);
+
+    // Temporizador de disparo único que encerra o pulso de início
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &Dht22Reader::onStartSignalDone;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "dht22_start";
+
+    if (esp_timer_create(&timerArgs, &m_startTimer) != ESP_OK) {
+        LOG_ERROR(MODULE_NAME, "Falha ao criar temporizador do pulso de início");
+        return false;
+    }
+
+    m_ready = true;
+    LOG_INFO(MODULE_NAME, "Aquisição via RMT inicializada (canal %d)", m_channel);
+    return true;
+}
+
+bool Dht22Reader::poll() {
+    if (!m_ready) {
+        return false;
+    }
+
+    uint32_t currentTime = millis();
+
+    if (!DHT22_USE_RMT) {
+        // Uma única transação por intervalo, decodificando ambos os valores
+        if (m_result.status != Status::NONE &&
+            currentTime - m_transactionStart < DHT22_READ_INTERVAL) {
+            return false;
+        }
+        m_transactionStart = currentTime;
+
+        uint32_t start = micros();
+        if (m_dht.read(true)) {
+            finishTransaction(Status::OK,
+                m_dht.readTemperature(false, false),
+                m_dht.readHumidity(false),
+                micros() - start);
+        } else {
+            finishTransaction(Status::NO_RESPONSE, NAN, NAN, micros() - start);
+        }
+        return true;
+    }
+
+    switch (m_state) {
+        case STATE_IDLE:
+            if (m_result.status == Status::NONE ||
+                currentTime - m_transactionStart >= DHT22_READ_INTERVAL) {
+                startTransaction();
+            }
+            return false;
+
+        case STATE_START_SIGNAL:
+            // O callback do temporizador avança para STATE_CAPTURING
+            return false;
+
+        case STATE_CAPTURING:
+            return collectFrame();
+    }
+
+    return false;
+}
+
+uint32_t Dht22Reader::getPollDelay() const {
+    if (!m_ready) {
+        return DHT22_READ_INTERVAL;
+    }
+
+    if (m_state != STATE_IDLE) {
+        return DHT22_CAPTURE_POLL;
+    }
+
+    if (m_result.status == Status::NONE) {
+        return 1;
+    }
+
+    uint32_t elapsed = millis() - m_transactionStart;
+    return elapsed >= DHT22_READ_INTERVAL ? 1 : DHT22_READ_INTERVAL - elapsed;
+}
+
+void Dht22Reader::startTransaction() {
+    m_transactionStart = millis();
+    m_state = STATE_START_SIGNAL;
+
+    // Pulso de início: linha em nível baixo até o temporizador expirar
+    gpio_set_level(static_cast<gpio_num_t>(m_pin), 0);
+
+    if (esp_timer_start_once(m_startTimer, START_SIGNAL_US) != ESP_OK) {
+        gpio_set_level(static_cast<gpio_num_t>(m_pin), 1);
+        finishTransaction(Status::NO_RESPONSE, NAN, NAN, 0);
+    }
+}
+
+void Dht22Reader::onStartSignalDone(void *arg) {
+    Dht22Reader *reader = static_cast<Dht22Reader *>(arg);
+
+    // Arma a captura antes de liberar a linha para não perder a resposta
+    rmt_rx_start(reader->m_channel, true);
+    gpio_set_level(static_cast<gpio_num_t>(reader->m_pin), 1);
+
+    reader->m_state = STATE_CAPTURING;
+}
+
+bool Dht22Reader::collectFrame() {
+    size_t itemSize = 0;
+    rmt_item32_t *items = static_cast<rmt_item32_t *>(
+        xRingbufferReceive(m_ringBuffer, &itemSize, 0));
+
+    if (!items) {
+        // Quadro ainda não terminou: verifica o tempo limite da transação
+        if (millis() - m_transactionStart >= DHT22_CAPTURE_TIMEOUT) {
+            rmt_rx_stop(m_channel);
+            finishTransaction(Status::NO_RESPONSE, NAN, NAN, 0);
+            return true;
+        }
+        return false;
+    }
+
+    uint32_t start = micros();
+
+    // Converte os itens RMT em pulsos individuais
+    Pulse pulses[MAX_PULSES];
+    size_t count = 0;
+    size_t itemCount = itemSize / sizeof(rmt_item32_t);
+
+    for (size_t i = 0; i < itemCount && count < MAX_PULSES; i++) {
+        if (items[i].duration0 > 0) {
+            pulses[count++] = { static_cast<uint8_t>(items[i].level0),
+                                static_cast<uint16_t>(items[i].duration0) };
+        }
+        if (items[i].duration1 > 0 && count < MAX_PULSES) {
+            pulses[count++] = { static_cast<uint8_t>(items[i].level1),
+                                static_cast<uint16_t>(items[i].duration1) };
+        }
+    }
+
+    vRingbufferReturnItem(m_ringBuffer, items);
+    rmt_rx_stop(m_channel);
+
+    float temperature = NAN;
+    float humidity = NAN;
+    Status status = Dht22Decoder::decode(pulses, count, temperature, humidity);
+
+    finishTransaction(status, temperature, humidity, micros() - start);
+    return true;
+}
+
+void Dht22Reader::finishTransaction(Status status, float temperature, float humidity,
+                                    uint32_t decodeTimeUs) {
+    m_state = STATE_IDLE;
+
+    m_result.status = status;
+    m_result.timestamp = millis();
+    m_result.decodeTimeUs = decodeTimeUs;
+
+    if (status == Status::OK) {
+        m_result.temperature = temperature;
+        m_result.humidity = humidity;
+        m_successCount++;
+        Metrics::dhtTransactionsOk.inc();
+    } else {
+        m_errorCount++;
+        Metrics::dhtTransactionsFailed.inc();
+        if (DEBUG_MODE) {
+            LOG_DEBUG(MODULE_NAME, "Falha na aquisição: %s (%u erros)",
+                statusToString(status), m_errorCount);
+        }
+    }
+}
+
+const Dht22Reader::Result &Dht22Reader::getLastResult() const {
+    return m_result;
+}
+
+uint32_t Dht22Reader::getSuccessCount() const {
+    return m_successCount;
+}
+
+uint32_t Dht22Reader::getErrorCount() const {
+    return m_errorCount;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file FieldMode.cpp
+ * @brief Implementação do modo de campo com deep sleep.
+ */
+
+#include "FieldMode.h"
+#include "Hardware.h"
+#include "SensorManager.h"
+#include "ApiClient.h"
+#include "LogSystem.h"
+#include "WokwiCompat.h"
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include <sys/time.h>
+#include <type_traits>
+
+// Define o nome do módulo para logging
+#define MODULE_NAME "FieldMode"
+
+namespace FieldMode {
+
+    // Identifica o layout do estado RTC; mudar ao alterar RtcState
+    static constexpr uint32_t RTC_MAGIC = 0x46444D31;   // "FDM1"
+
+    // Peso da medição mais recente nas médias do orçamento
+    static constexpr float BUDGET_WEIGHT = 0.25f;
+
+    // Modelo usado antes das primeiras medições (ms)
+    static constexpr float MODEL_SAMPLE_MS = 100.0f;     // setup() até o deep sleep, sem rádio
+    static constexpr float MODEL_RADIO_MS = 3000.0f;     // Associação, DHCP e envio
+
+    /**
+     * Amostra retida na memória RTC.
+     *
+     * Tipo trivial: variáveis RTC_DATA_ATTR com construtor seriam
+     * reinicializadas a cada despertar.
+     */
+    struct RtcSample {
+        uint32_t timestamp;         // Relógio do sistema (ms), mantido no deep sleep
+        float temperature;
+        float humidity;
+    };
+
+    /**
+     * Estado preservado na memória RTC lenta entre ciclos.
+     */
+    struct RtcState {
+        uint32_t magic;
+        uint32_t cycle;                         // Ciclos desde o boot a frio
+        uint16_t cyclesSinceUpload;
+        uint16_t batchCount;
+        uint32_t samplesDropped;                // Descartadas com o lote cheio ou recusadas pela API
+        uint32_t sampleFailures;                // Ciclos sem leitura válida do DHT22
+        uint32_t uploadFailures;
+        RtcSample batch[FIELD_BATCH_CAPACITY];
+        SensorManager::FilterState filter;     // Zerado no boot a frio: janela vazia
+
+        // Médias móveis do orçamento (ms)
+        float sampleActiveMs;                   // Ciclos sem envio
+        float uploadActiveMs;                   // Ciclos com envio, parte sem rádio
+        float uploadRadioMs;                    // Ciclos com envio, rádio ligado
+    };
+
+    // Sem construtores: senão seriam executados a cada despertar e apagariam o estado
+    static_assert(std::is_trivial<RtcState>::value, "RtcState precisa ser trivial para a memória RTC");
+
+    RTC_DATA_ATTR static RtcState s_state;
+
+    /**
+     * Relógio do sistema em ms; ao contrário de millis(), continua
+     * contando durante o deep sleep.
+     */
+    static uint32_t clockMs() {
+        struct timeval now;
+        gettimeofday(&now, nullptr);
+        return static_cast<uint32_t>((uint64_t)now.tv_sec * 1000 + now.tv_usec / 1000);
+    }
+
+    static void updateAverage(float &average, uint32_t value) {
+        average = average == 0.0f ? value : average + BUDGET_WEIGHT * (value - average);
+    }
+
+    /**
+     * Converte um orçamento em carga, em μA·ms.
+     */
+    static float charge(float activeMs, float radioMs, float sleepMs) {
+        return activeMs * FIELD_CURRENT_ACTIVE_MA * 1000.0f +
+               radioMs * FIELD_CURRENT_RADIO_MA * 1000.0f +
+               sleepMs * FIELD_CURRENT_SLEEP_UA;
+    }
+
+    /**
+     * Acrescenta uma amostra ao lote, descartando a mais antiga se cheio.
+     */
+    static void appendSample(const SensorData &data) {
+        if (s_state.batchCount >= FIELD_BATCH_CAPACITY) {
+            memmove(&s_state.batch[0], &s_state.batch[1], sizeof(RtcSample) * (FIELD_BATCH_CAPACITY - 1));
+            s_state.batchCount = FIELD_BATCH_CAPACITY - 1;
+            s_state.samplesDropped++;
+        }
+
+        RtcSample &sample = s_state.batch[s_state.batchCount++];
+        sample.timestamp = clockMs();
+        sample.temperature = data.temperature;
+        sample.humidity = data.humidityPercent;
+    }
+
+    /**
+     * Lê o DHT22 pelo SensorManager com o filtro restaurado da memória RTC.
+     *
+     * @param coldBoot true se o sensor acabou de ser energizado.
+     * @return true se a amostra foi acrescentada ao lote.
+     */
+    static bool sample(bool coldBoot) {
+        // Ao despertar o sensor continua alimentado: sem a espera de energização
+        if (!Hardware::initDHT(coldBoot)) {
+            s_state.sampleFailures++;
+            LOG_WARN(MODULE_NAME, "Ciclo %u sem leitura do DHT22 (%u falhas)",
+                s_state.cycle, s_state.sampleFailures);
+            return false;
+        }
+
+        // A leitura inicial de init() já passa pelo filtro restaurado; a
+        // tendência mede o intervalo pelo relógio que segue no deep sleep
+        static SensorManager sensorManager;
+        sensorManager.setClock(clockMs);
+        sensorManager.setFilterState(s_state.filter);
+        sensorManager.init();
+        sensorManager.getFilterState(s_state.filter);
+
+        // Leitura descartada pela faixa válida ou pelo filtro de Hampel: o
+        // SensorManager recém-criado só teria os valores padrão do construtor
+        if (!sensorManager.isSampleAccepted()) {
+            s_state.sampleFailures++;
+            LOG_WARN(MODULE_NAME, "Ciclo %u: leitura do DHT22 descartada pelo filtro (%u falhas)",
+                s_state.cycle, s_state.sampleFailures);
+            return false;
+        }
+
+        appendSample(sensorManager.getData());
+        return true;
+    }
+
+    /**
+     * Liga o WiFi, envia o lote em requisições de até API_BATCH_MAX_SAMPLES
+     * amostras e desliga o rádio.
+     *
+     * @return true se todo o lote foi entregue.
+     */
+    static bool upload() {
+        uint32_t start = millis();
+
+        #if defined(WOKWI_ENV) || defined(WOKWI)
+            WokwiCompat::connectWiFi(WIFI_SSID, WIFI_PASSWORD, FIELD_WIFI_TIMEOUT);
+        #else
+            WiFi.persistent(false);
+            WiFi.mode(WIFI_STA);
+            WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+            while (WiFi.status() != WL_CONNECTED && millis() - start < FIELD_WIFI_TIMEOUT) {
+                delay(10);
+            }
+        #endif
+
+        bool delivered = false;
+        if (WiFi.status() != WL_CONNECTED) {
+            LOG_WARN(MODULE_NAME, "WiFi indisponível após %u ms; %u amostras mantidas",
+                millis() - start, s_state.batchCount);
+        } else {
+            LOG_INFO(MODULE_NAME, "WiFi conectado em %u ms", millis() - start);
+
+            static ApiClient client(API_ENDPOINT_URL);
+            SensorData chunk[API_BATCH_MAX_SAMPLES];
+            size_t sent = 0;
+            delivered = true;
+
+            while (sent < s_state.batchCount) {
+                size_t count = s_state.batchCount - sent;
+                if (count > API_BATCH_MAX_SAMPLES) {
+                    count = API_BATCH_MAX_SAMPLES;
+                }
+
+                for (size_t i = 0; i < count; i++) {
+                    const RtcSample &sample = s_state.batch[sent + i];
+                    chunk[i].timestamp = sample.timestamp;
+                    chunk[i].temperature = sample.temperature;
+                    chunk[i].humidityPercent = sample.humidity;
+                }
+
+                int httpCode = client.sendBatch(chunk, count);
+                if (!ApiClient::isSuccess(httpCode)) {
+                    if (ApiClient::isRetryable(httpCode)) {
+                        delivered = false;
+                        break;
+                    }
+
+                    // Recusado pela API: mantê-lo travaria o lote na memória RTC
+                    s_state.samplesDropped += count;
+                    LOG_WARN(MODULE_NAME, "Lote de %u amostras recusado (%d), descartado",
+                        static_cast<unsigned>(count), httpCode);
+                }
+                sent += count;
+            }
+
+            // Mantém apenas as amostras não entregues
+            if (sent > 0) {
+                memmove(&s_state.batch[0], &s_state.batch[sent], sizeof(RtcSample) * (s_state.batchCount - sent));
+                s_state.batchCount -= sent;
+            }
+        }
+
+        WiFi.disconnect(true);
+        WiFi.mode(WIFI_OFF);
+        return delivered;
+    }
+
+    /**
+     * Registra a previsão de autonomia para planos usuais.
+     */
+    static void logForecast() {
+        static const uint32_t intervals[] = { 60, 300, 900, 3600 };
+        static const uint16_t uploads[] = { 1, 6, 12, 24 };
+
+        for (size_t i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++) {
+            char line[160];
+            int length = snprintf(line, sizeof(line), "Amostra a cada %4u s, envio a cada 1/6/12/24 ciclos:",
+                intervals[i]);
+            for (size_t j = 0; j < sizeof(uploads) / sizeof(uploads[0]) && length > 0 && length < (int)sizeof(line); j++) {
+                Estimate forecast = estimate(intervals[i], uploads[j]);
+                length += snprintf(line + length, sizeof(line) - length, " %.0f μA (%.0f d)",
+                    forecast.averageUa, forecast.lifeDays);
+            }
+            LOG_INFO(MODULE_NAME, "%s", line);
+        }
+    }
+
+    Estimate estimate(uint32_t intervalS, uint16_t uploadEvery) {
+        if (uploadEvery == 0) {
+            uploadEvery = 1;
+        }
+
+        float sampleActive = s_state.sampleActiveMs > 0.0f ? s_state.sampleActiveMs : FIELD_BOOT_TIME + MODEL_SAMPLE_MS;
+        float uploadActive = s_state.uploadActiveMs > 0.0f ? s_state.uploadActiveMs : sampleActive;
+        float uploadRadio = s_state.uploadRadioMs > 0.0f ? s_state.uploadRadioMs : MODEL_RADIO_MS;
+
+        // Uma janela de envio: uploadEvery ciclos, um deles com rádio
+        float activeMs = sampleActive * (uploadEvery - 1) + uploadActive;
+        float windowMs = intervalS * 1000.0f * uploadEvery;
+        float awakeMs = activeMs + uploadRadio;
+        float sleepMs = windowMs > awakeMs ? windowMs - awakeMs : 0.0f;
+
+        Estimate result;
+        result.averageUa = charge(activeMs, uploadRadio, sleepMs) / (sleepMs + awakeMs);
+        result.lifeDays = FIELD_BATTERY_MAH * 1000.0f / result.averageUa / 24.0f;
+        return result;
+    }
+
+    void run() {
+        setCpuFrequencyMhz(FIELD_CPU_FREQ);
+
+        // O estado RTC só é válido ao despertar pelo temporizador
+        bool coldBoot = esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER || s_state.magic != RTC_MAGIC;
+        if (coldBoot) {
+            memset(&s_state, 0, sizeof(s_state));
+            s_state.magic = RTC_MAGIC;
+
+            LOG_INFO(MODULE_NAME, "Modo de campo: amostra a cada %u s, envio a cada %u ciclos, lote de até %u amostras",
+                FIELD_SAMPLE_INTERVAL, FIELD_UPLOAD_EVERY, FIELD_BATCH_CAPACITY);
+            logForecast();
+        }
+
+        s_state.cycle++;
+        s_state.cyclesSinceUpload++;
+
+        sample(coldBoot);
+
+        // Após uma falha, a nova tentativa fica para o próximo envio programado
+        uint32_t radioMs = 0;
+        if (s_state.batchCount > 0 && s_state.cyclesSinceUpload >= FIELD_UPLOAD_EVERY) {
+            uint32_t radioStart = millis();
+            if (!upload()) {
+                s_state.uploadFailures++;
+            }
+            s_state.cyclesSinceUpload = 0;
+            radioMs = millis() - radioStart;
+
+            LOG_INFO(MODULE_NAME, "Envio: %u amostras pendentes, %u envios com falha, %u descartadas, %u ciclos sem leitura",
+                s_state.batchCount, s_state.uploadFailures, s_state.samplesDropped, s_state.sampleFailures);
+        }
+
+        // Orçamento do ciclo; o próximo despertar mantém a cadência
+        CycleBudget budget;
+        budget.cycle = s_state.cycle;
+        budget.radioMs = radioMs;
+        budget.activeMs = FIELD_BOOT_TIME + millis() - radioMs;
+        uint32_t awakeMs = budget.activeMs + radioMs;
+        uint32_t intervalMs = FIELD_SAMPLE_INTERVAL * 1000;
+        budget.sleepMs = awakeMs + FIELD_MIN_SLEEP < intervalMs ? intervalMs - awakeMs : FIELD_MIN_SLEEP;
+        budget.chargeUah = charge(budget.activeMs, budget.radioMs, budget.sleepMs) / 3600000.0f;
+
+        if (radioMs > 0) {
+            updateAverage(s_state.uploadActiveMs, budget.activeMs);
+            updateAverage(s_state.uploadRadioMs, budget.radioMs);
+        } else {
+            updateAverage(s_state.sampleActiveMs, budget.activeMs);
+        }
+
+        Estimate forecast = estimate(FIELD_SAMPLE_INTERVAL, FIELD_UPLOAD_EVERY);
+        LOG_INFO(MODULE_NAME, "Ciclo %u: ativo %u ms, rádio %u ms, sono %u ms, %.2f μAh | lote %u, média %.0f μA, autonomia %.0f dias",
+            budget.cycle, budget.activeMs, budget.radioMs, budget.sleepMs, budget.chargeUah,
+            s_state.batchCount, forecast.averageUa, forecast.lifeDays);
+
+        Serial.flush();
+        esp_sleep_enable_timer_wakeup((uint64_t)budget.sleepMs * 1000);
+        esp_deep_sleep_start();
+    }
+}
@@ -11,19 +11,8 @@
 
 namespace Hardware {
 
-    // Instância do sensor DHT
-    DHT dht(PIN_DHT22_SENSOR, DHT_TYPE);
-
-    // Estrutura para armazenar os valores mais recentes dos sensores
-    struct SensorValues {
-        float temperature;    // Temperatura bruta
-        float correctedTemp;  // Temperatura corrigida
-        float humidity;       // Umidade
-        bool needsUpdate;     // Flag para atualização do display
-    };
-
-    // Valores atuais dos sensores (globais ao namespace)
-    SensorValues g_currentValues = {25.0f, 25.0f, 50.0f, false};
+    // Leitor não bloqueante do sensor DHT
+    Dht22Reader g_dhtReader(PIN_DHT22_SENSOR, DHT22_RMT_CHANNEL);
 
     void setupPins() {
         LOG_INFO(MODULE_NAME, "Configurando hardware");
@@ -36,7 +25,7 @@ namespace Hardware {
 
         // Inicializa o sensor DHT22
         if (initDHT()) {
-            LOG_INFO(MODULE_NAME, "Sensor DHT22 inicializado com sucesso (%.1f°C)", g_currentValues.temperature);
+            LOG_INFO(MODULE_NAME, "Sensor DHT22 inicializado com sucesso (%.1f°C)", g_dhtReader.getLastResult().temperature);
         } else {
             LOG_ERROR(MODULE_NAME, "Falha ao inicializar o sensor DHT22");
         }
@@ -102,163 +91,55 @@ namespace Hardware {
         return (stableButtonState[pinIndex] == activeState);
     }
 
-    bool initDHT() {
+    bool initDHT(bool powerUpDelay) {
         // Configura o pino para garantir que esteja no modo correto
         pinMode(PIN_DHT22_SENSOR, INPUT_PULLUP);
         delay(10); // Pequeno delay para estabilização
 
-        // Inicializa o sensor DHT com tempo de pull-up maior para maior estabilidade
-        dht.begin(60); // 60μs de tempo de pull-up (valor padrão é 55)
-
-        // Aguarda um tempo maior para o sensor estabilizar após inicialização
-        delay(1000);
-
-        // Tenta realizar uma leitura de teste
-        float testReading = dht.readTemperature();
-
-        // Verifica se a leitura foi bem-sucedida
-        if (isnan(testReading)) {
-            if (DEBUG_MODE) {
-                LOG_DEBUG(MODULE_NAME, "Falha ao inicializar o sensor DHT22");
-            }
-
-            // Segunda tentativa após um delay maior
-            delay(2000);
-            testReading = dht.readTemperature();
-
-            if (isnan(testReading)) {
-                if (DEBUG_MODE) {
-                    LOG_DEBUG(MODULE_NAME, "Falha persistente no sensor DHT22");
-                }
-                return false;
-            }
+        if (!g_dhtReader.begin()) {
+            return false;
         }
 
-        // Armazena a primeira leitura válida
-        g_currentValues.temperature = testReading;
-        g_currentValues.correctedTemp = testReading;
-        g_currentValues.needsUpdate = true;
-
-        return true;
-    }
-
-    float readTemperature() {
-        // Lê a temperatura do sensor DHT22 em graus Celsius com tentativa de recuperação
-        static float lastValidTemperature = 25.0f; // Valor padrão razoável
-
-        // Os parâmetros são:
-        // 1º: S (Scale) - false para Celsius, true para Fahrenheit
-        // 2º: force - true para forçar nova leitura (ignorando o cache da biblioteca)
-        float temperature = dht.readTemperature(false, true);
-
-        if (isnan(temperature)) {
-            if (DEBUG_MODE) {
-                LOG_DEBUG(MODULE_NAME, "Erro na leitura de temperatura do DHT22, tentando novamente");
-            }
-
-            // Tenta novamente após um curto delay
-            delay(500);
-            temperature = dht.readTemperature(false, true);
+        // Aguarda o sensor estabilizar após energização
+        if (powerUpDelay) {
+            delay(1000);
+        }
 
-            if (isnan(temperature)) {
-                if (DEBUG_MODE) {
-                    LOG_DEBUG(MODULE_NAME, "Falha persistente, usando último valor válido");
+        // Aguarda a primeira aquisição (apenas durante o setup é aceitável bloquear)
+        uint32_t start = millis();
+        while (millis() - start < DHT22_READ_INTERVAL + 500) {
+            if (g_dhtReader.poll()) {
+                const Dht22Reader::Result &result = g_dhtReader.getLastResult();
+                if (result.status != Dht22Reader::Status::OK) {
+                    if (DEBUG_MODE) {
+                        LOG_DEBUG(MODULE_NAME, "Falha na leitura inicial do DHT22: %s",
+                            Dht22Reader::statusToString(result.status));
+                    }
+                    return false;
                 }
-                // Usa último valor válido, mas não marca como needsUpdate
-                g_currentValues.needsUpdate = false;
-                return getCalibrationTemperature(lastValidTemperature);
-            }
-        }
 
-        // Verificação de valores absurdos (fora da faixa esperada)
-        if (temperature < -40.0f || temperature > 80.0f) {
-            if (DEBUG_MODE) {
-                LOG_DEBUG(MODULE_NAME, "Temperatura fora da faixa válida: %.1f°C, usando último valor", temperature);
+                return true;
             }
-            g_currentValues.needsUpdate = false;
-            return getCalibrationTemperature(lastValidTemperature);
+            delay(10);
         }
 
-        // Atualiza o último valor válido
-        lastValidTemperature = temperature;
-
-        // Atualiza os valores atuais
-        g_currentValues.temperature = temperature;
-        g_currentValues.needsUpdate = true;
-
-        // Exibe a leitura apenas se estiver no modo de debug e numa periodicidade específica
-        // Aumentamos para 10s para evitar poluir demais o console, já que exibimos
-        // informações contínuas com updateLine
-        static uint32_t lastTempDebugTime = 0;
-        if (DEBUG_MODE && (millis() - lastTempDebugTime > 10000)) {
-            LOG_INFO(MODULE_NAME, "Resumo Periódico de Sensores");
-            LOG_INFO(MODULE_NAME, "Temperatura: %.1f°C    Umidade: %.1f%%",
-                g_currentValues.correctedTemp, g_currentValues.humidity);
-            LOG_INFO(MODULE_NAME, "Estado: Atualizado recentemente");
-            lastTempDebugTime = millis();
+        if (DEBUG_MODE) {
+            LOG_DEBUG(MODULE_NAME, "Tempo esgotado aguardando o DHT22");
         }
-
-        // Retorna a temperatura calibrada para sincronização com interface web
-        return getCalibrationTemperature(temperature);
+        return false;
     }
 
-    float getCalibrationTemperature(float rawTemp) {
-        // Aplica uma correção de calibração para compensar erros
-        // sistemáticos do sensor com base em medições de referência
-
-        // Aplica a correção para temperatura mais precisa (valor direto do sensor)
-        // Para usar fatores de calibração, descomente e ajuste as linhas abaixo:
-        // float correctedTemp = rawTemp * 1.0f + 0.0f;  // Ajuste com fator e offset
-        float correctedTemp = rawTemp;  // Por enquanto, sem correção aplicada
-
-        // Limita a faixa de temperatura para evitar valores absurdos
-        correctedTemp = constrain(correctedTemp, -40.0f, 80.0f);
-
-        // Atualiza o valor armazenado
-        g_currentValues.correctedTemp = correctedTemp;
-
-        return correctedTemp;
+    bool pollDHT() {
+        // Avança a máquina de estados sem bloquear; a nova leitura (se houver)
+        // é consumida pela tarefa de sensores em SensorManager::readSensors()
+        return g_dhtReader.poll();
     }
 
-    float readHumidity() {
-        // Lê a umidade relativa do sensor DHT22 (0-100%) com tentativa de recuperação
-        static float lastValidHumidity = 50.0f;  // Valor padrão razoável
-        float humidity = dht.readHumidity(true); // Force = true para forçar nova leitura
-
-        if (isnan(humidity)) {
-            if (DEBUG_MODE) {
-                LOG_DEBUG(MODULE_NAME, "Erro na leitura de umidade do DHT22, tentando novamente");
-            }
-
-            // Tenta novamente após um curto delay
-            delay(500);
-            humidity = dht.readHumidity(true);
-
-            if (isnan(humidity)) {
-                if (DEBUG_MODE) {
-                    LOG_DEBUG(MODULE_NAME, "Falha persistente, usando último valor válido");
-                }
-                g_currentValues.needsUpdate = false;
-                return lastValidHumidity; // Retorna último valor válido
-            }
-        }
-
-        // Filtra valores absurdos
-        if (humidity < 0.0f || humidity > 100.0f) {
-            if (DEBUG_MODE) {
-                LOG_DEBUG(MODULE_NAME, "Valor de umidade fora da faixa (%.1f%%), usando último valor válido", humidity);
-            }
-            g_currentValues.needsUpdate = false;
-            return lastValidHumidity;
-        }
-
-        // Atualiza o último valor válido
-        lastValidHumidity = humidity;
-
-        // Atualiza valores atuais
-        g_currentValues.humidity = humidity;
-        g_currentValues.needsUpdate = true;
+    uint32_t getDHTPollDelay() {
+        return g_dhtReader.getPollDelay();
+    }
 
-        return humidity;
+    const Dht22Reader &getDHTReader() {
+        return g_dhtReader;
     }
 } // namespace Hardware
@@ -23,7 +23,8 @@ CircularLogBuffer& CircularLogBuffer::getInstance() {
 }
 
 CircularLogBuffer::CircularLogBuffer()
-    : m_head(0) {
+    : m_head(0),
+    m_sequence(0) {
     // Cria mutex para proteção de acesso
     m_mutex = xSemaphoreCreateMutex();
 
@@ -45,11 +46,41 @@ void CircularLogBuffer::addEntry(const LogEntry& entry) {
 
         // Avança o ponteiro de forma circular
         m_head = (m_head + 1) % LOG_BUFFER_SIZE;
+        m_sequence++;
 
         xSemaphoreGive(m_mutex);
     }
 }
 
+size_t CircularLogBuffer::readSince(uint32_t& sequence, LogEntry* out, size_t maxCount) {
+    if (!out || maxCount == 0) {
+        return 0;
+    }
+
+    size_t count = 0;
+
+    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        // Entradas mais antigas que o tamanho do buffer já foram sobrescritas
+        uint32_t oldest = m_sequence > LOG_BUFFER_SIZE ? m_sequence - LOG_BUFFER_SIZE : 0;
+        if (sequence < oldest || sequence > m_sequence) {
+            sequence = oldest;
+        }
+
+        // A entrada de sequência s fica na posição s % LOG_BUFFER_SIZE
+        for (uint32_t s = sequence; s < m_sequence && count < maxCount; s++) {
+            out[count++] = m_entries[s % LOG_BUFFER_SIZE];
+        }
+
+        xSemaphoreGive(m_mutex);
+    }
+
+    return count;
+}
+
+uint32_t CircularLogBuffer::getSequence() const {
+    return m_sequence;
+}
+
 size_t CircularLogBuffer::getEntries(char* buffer, size_t maxSize) {
     if (!buffer || maxSize == 0) {
         return 0;
@@ -447,6 +478,21 @@ const char* LogRouter::levelToString(LogLevel level) {
     }
 }
 
+bool LogRouter::stringToLevel(const char* name, LogLevel& level) {
+    if (!name) {
+        return false;
+    }
+
+    for (int i = static_cast<int>(LogLevel::TRACE); i <= static_cast<int>(LogLevel::FATAL); i++) {
+        if (strcasecmp(name, levelToString(static_cast<LogLevel>(i))) == 0) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 MessagePriority LogRouter::levelToPriority(LogLevel level) {
     switch (level) {
         case LogLevel::TRACE:   return MessagePriority::MSG_LOW;
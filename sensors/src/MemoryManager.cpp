@@ -5,6 +5,7 @@
 
 #include "MemoryManager.h"
 #include "LogSystem.h"
+#include "CpuMonitor.h"
 #include <esp_heap_caps.h>
 
 // Nome do módulo para logs
@@ -148,9 +149,8 @@ const SystemStats &MemoryManager::updateStats() {
     // Atualiza tempo de atividade (converte de ms para s)
     m_stats.uptime = currentTime / 1000;
 
-    // Carga da CPU não é facilmente obtida no ESP32 sem uso de FreeRTOS
-    // avançado, então deixamos em 0 por enquanto
-    m_stats.cpuLoad = 0;
+    // Média dos núcleos, amostrada pelo CpuMonitor na tarefa web
+    m_stats.cpuLoad = CpuMonitor::getInstance().getLoad();
 
     return m_stats;
 }
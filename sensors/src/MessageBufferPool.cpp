@@ -0,0 +1,96 @@
+/**
+ * @file MessageBufferPool.cpp
+ * @brief Implementação do pool de buffers de broadcast.
+ */
+
+#include "MessageBufferPool.h"
+#include "LogSystem.h"
+
+// Nome do módulo para logs
+#define MODULE_NAME "BufferPool"
+
+MessageBufferPool::MessageBufferPool(size_t bufferSize)
+    : m_bufferSize(bufferSize),
+    m_next(0),
+    m_acquired(0),
+    m_exhausted(0),
+    m_resized(0),
+    m_highWater(0),
+    m_lock(portMUX_INITIALIZER_UNLOCKED) {
+    for (uint8_t i = 0; i < WS_BUFFER_POOL_SIZE; i++) {
+        m_buffers[i] = nullptr;
+    }
+}
+
+MessageBufferPool::~MessageBufferPool() {
+    for (uint8_t i = 0; i < WS_BUFFER_POOL_SIZE; i++) {
+        delete m_buffers[i];
+    }
+}
+
+bool MessageBufferPool::begin() {
+    for (uint8_t i = 0; i < WS_BUFFER_POOL_SIZE; i++) {
+        if (m_buffers[i] == nullptr) {
+            m_buffers[i] = new AsyncWebSocketMessageBuffer(m_bufferSize);
+        }
+
+        if (m_buffers[i] == nullptr || m_buffers[i]->get() == nullptr) {
+            LOG_ERROR(MODULE_NAME, "Falha ao alocar buffer de %u bytes",
+                static_cast<unsigned>(m_bufferSize));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+AsyncWebSocketMessageBuffer *MessageBufferPool::acquire(size_t length) {
+    AsyncWebSocketMessageBuffer *found = nullptr;
+    uint8_t foundIndex = 0;
+    uint8_t inUse = 0;
+
+    // A telemetria pode ser gerada pela tarefa web e pela tarefa do AsyncTCP
+    portENTER_CRITICAL(&m_lock);
+
+    // Rodízio: o buffer liberado há mais tempo é verificado primeiro
+    for (uint8_t i = 0; i < WS_BUFFER_POOL_SIZE; i++) {
+        uint8_t index = (m_next + i) % WS_BUFFER_POOL_SIZE;
+        AsyncWebSocketMessageBuffer *buffer = m_buffers[index];
+        if (buffer == nullptr) {
+            continue;
+        }
+
+        if (!buffer->canDelete()) {
+            inUse++;
+        } else if (found == nullptr || (found->length() != length && buffer->length() == length)) {
+            // Primeiro livre, substituído por um livre do tamanho exato
+            found = buffer;
+            foundIndex = index;
+        }
+    }
+
+    if (found == nullptr) {
+        m_exhausted++;
+    } else {
+        // Travado até o envio: o chamador destrava após entregar aos clientes
+        found->lock();
+        m_next = (foundIndex + 1) % WS_BUFFER_POOL_SIZE;
+        m_acquired++;
+        if (inUse + 1 > m_highWater) {
+            m_highWater = inUse + 1;
+        }
+    }
+
+    portEXIT_CRITICAL(&m_lock);
+
+    // Realoca fora da seção crítica; o buffer já está travado
+    if (found != nullptr && found->length() != length) {
+        m_resized++;
+        if (!found->reserve(length)) {
+            found->unlock();
+            return nullptr;
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementação do registro de métricas e das métricas do firmware.
+ */
+
+#include "Metrics.h"
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace Metrics {
+
+    // Lista preenchida na inicialização estática (zero antes dos construtores)
+    Metric *Metric::s_head = nullptr;
+    Metric *Metric::s_tail = nullptr;
+
+    static const char *typeName(MetricType type) {
+        switch (type) {
+            case MetricType::COUNTER:   return "counter";
+            case MetricType::GAUGE:     return "gauge";
+            case MetricType::HISTOGRAM: return "histogram";
+            default:                    return "untyped";
+        }
+    }
+
+    static size_t clampWritten(int written, size_t size) {
+        if (written < 0) {
+            return 0;
+        }
+        return (size_t)written < size ? written : size - 1;
+    }
+
+    Metric::Metric(const char *name, const char *help, MetricType type, const char *labels)
+        : m_name(name),
+        m_help(help),
+        m_labels(labels),
+        m_type(type),
+        m_header(true),
+        m_next(nullptr) {
+        // Séries do mesmo nome compartilham o cabeçalho da primeira
+        if (s_tail && strcmp(s_tail->m_name, name) == 0) {
+            m_header = false;
+        }
+
+        if (s_tail) {
+            s_tail->m_next = this;
+        } else {
+            s_head = this;
+        }
+        s_tail = this;
+    }
+
+    size_t Metric::formatLine(size_t line, char *out, size_t size) const {
+        if (m_header) {
+            if (line == 0) {
+                return clampWritten(snprintf(out, size, "# HELP %s %s\n", m_name, m_help), size);
+            }
+            if (line == 1) {
+                return clampWritten(snprintf(out, size, "# TYPE %s %s\n", m_name, typeName(m_type)), size);
+            }
+            line -= 2;
+        }
+
+        return formatSample(line, out, size);
+    }
+
+    size_t Metric::formatValue(char *out, size_t size, const char *suffix, const char *extraLabel,
+                               const char *value) const {
+        bool labels = m_labels && m_labels[0];
+        bool extra = extraLabel && extraLabel[0];
+
+        int written = snprintf(out, size, "%s%s%s%s%s%s%s %s\n",
+            m_name, suffix ? suffix : "",
+            (labels || extra) ? "{" : "",
+            labels ? m_labels : "",
+            (labels && extra) ? "," : "",
+            extra ? extraLabel : "",
+            (labels || extra) ? "}" : "",
+            value);
+
+        return clampWritten(written, size);
+    }
+
+    Counter::Counter(const char *name, const char *help, const char *labels)
+        : Metric(name, help, MetricType::COUNTER, labels),
+        m_value(0) {
+    }
+
+    size_t Counter::formatSample(size_t sample, char *out, size_t size) const {
+        if (sample > 0) {
+            return 0;
+        }
+
+        char value[12];
+        snprintf(value, sizeof(value), "%u", this->value());
+        return formatValue(out, size, nullptr, nullptr, value);
+    }
+
+    Gauge::Gauge(const char *name, const char *help, const char *labels)
+        : Metric(name, help, MetricType::GAUGE, labels),
+        m_value(0) {
+    }
+
+    size_t Gauge::formatSample(size_t sample, char *out, size_t size) const {
+        if (sample > 0) {
+            return 0;
+        }
+
+        char value[12];
+        snprintf(value, sizeof(value), "%d", this->value());
+        return formatValue(out, size, nullptr, nullptr, value);
+    }
+
+    Histogram::Histogram(const char *name, const char *help, const uint32_t *bounds, uint8_t count,
+                         float scale, const char *labels)
+        : Metric(name, help, MetricType::HISTOGRAM, labels),
+        m_bounds(bounds),
+        m_count(count < METRICS_HISTOGRAM_BUCKETS ? count : METRICS_HISTOGRAM_BUCKETS),
+        m_scale(scale),
+        m_sum(0) {
+        for (size_t i = 0; i <= METRICS_HISTOGRAM_BUCKETS; i++) {
+            m_buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Histogram::observe(uint32_t value) {
+        // Poucas faixas: busca linear é mais barata que binária
+        uint8_t bucket = 0;
+        while (bucket < m_count && value > m_bounds[bucket]) {
+            bucket++;
+        }
+
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    size_t Histogram::formatSample(size_t sample, char *out, size_t size) const {
+        char value[32];
+        char le[24];
+
+        // Faixas cumulativas, +Inf, _sum e _count
+        if (sample <= m_count) {
+            uint32_t cumulative = 0;
+            for (size_t i = 0; i <= sample; i++) {
+                cumulative += m_buckets[i].load(std::memory_order_relaxed);
+            }
+
+            if (sample < m_count) {
+                snprintf(le, sizeof(le), "le=\"%g\"", m_bounds[sample] * m_scale);
+            } else {
+                snprintf(le, sizeof(le), "le=\"+Inf\"");
+            }
+            snprintf(value, sizeof(value), "%u", cumulative);
+            return formatValue(out, size, "_bucket", le, value);
+        }
+
+        if (sample == (size_t)m_count + 1) {
+            // double: float perderia a precisão da soma já com poucos milhões
+            snprintf(value, sizeof(value), "%.15g",
+                static_cast<double>(m_sum.load(std::memory_order_relaxed)) * m_scale);
+            return formatValue(out, size, "_sum", nullptr, value);
+        }
+
+        if (sample == (size_t)m_count + 2) {
+            uint32_t total = 0;
+            for (size_t i = 0; i <= m_count; i++) {
+                total += m_buckets[i].load(std::memory_order_relaxed);
+            }
+            snprintf(value, sizeof(value), "%u", total);
+            return formatValue(out, size, "_count", nullptr, value);
+        }
+
+        return 0;
+    }
+
+    // ====================================================================
+    // Métricas do firmware (ordem de definição = ordem de exportação)
+    // ====================================================================
+
+    Counter sensorReads("soil_sensor_reads_total", "Ciclos de leitura dos sensores");
+    Counter dhtTransactionsOk("soil_dht22_transactions_total", "Transações do DHT22 por resultado", "result=\"ok\"");
+    Counter dhtTransactionsFailed("soil_dht22_transactions_total", "Transações do DHT22 por resultado", "result=\"error\"");
+    Counter temperatureOutliers("soil_sensor_outliers_total", "Picos descartados pelo filtro de Hampel", "channel=\"temperature\"");
+    Counter humidityOutliers("soil_sensor_outliers_total", "Picos descartados pelo filtro de Hampel", "channel=\"humidity\"");
+
+    Counter alertsRaised("soil_alert_transitions_total", "Transições das regras de alerta", "state=\"raised\"");
+    Counter alertsCleared("soil_alert_transitions_total", "Transições das regras de alerta", "state=\"cleared\"");
+    Gauge alertsActive("soil_alerts_active", "Regras de alerta disparadas");
+    Counter ruleErrors("soil_rule_errors_total", "Execuções de regras configuradas interrompidas pelo interpretador");
+
+    // Faixas em μs: tabela padrão e regras configuradas cabem nas primeiras
+    static const uint32_t s_alertBounds[] = { 10, 25, 50, 100, 250, 500, 1000 };
+    Histogram alertEvaluation("soil_alert_evaluation_seconds", "Duração da avaliação das regras por amostra",
+                              s_alertBounds, sizeof(s_alertBounds) / sizeof(s_alertBounds[0]), 0.000001f);
+
+    Counter wsBroadcasts("soil_ws_broadcasts_total", "Ciclos de broadcast de telemetria WebSocket");
+    Counter wsFramesSent("soil_ws_frames_sent_total", "Quadros de telemetria enfileirados para clientes");
+    Counter wsFramesConflated("soil_ws_frames_conflated_total", "Quadros de telemetria descartados por conflação");
+
+    Counter uplinkRequestsOk("soil_uplink_requests_total", "Envios para a API por resultado", "result=\"ok\"");
+    Counter uplinkRequestsFailed("soil_uplink_requests_total", "Envios para a API por resultado", "result=\"error\"");
+    Counter uplinkSamplesSent("soil_uplink_samples_sent_total", "Amostras entregues à API");
+    Counter uplinkSamplesDropped("soil_uplink_samples_dropped_total", "Amostras descartadas com a fila de envio cheia");
+    Counter uplinkAlertsDropped("soil_uplink_alerts_dropped_total", "Alertas descartados (fila cheia ou recusados pela API)");
+
+    static const uint32_t s_uplinkBounds[] = { 50, 100, 250, 500, 1000, 2500, 5000 };
+    Histogram uplinkRequestDuration("soil_uplink_request_duration_seconds", "Duração dos envios para a API",
+                                    s_uplinkBounds, sizeof(s_uplinkBounds) / sizeof(s_uplinkBounds[0]), 0.001f);
+
+    static Counter s_sensorWakeups("soil_task_wakeups_total", "Despertares da tarefa", "task=\"SensorTask\"");
+    static Counter s_webWakeups("soil_task_wakeups_total", "Despertares da tarefa", "task=\"WebTask\"");
+    static Counter s_sensorDeadlineMisses("soil_task_deadline_misses_total", "Jobs iniciados mais de um período após o prazo", "task=\"SensorTask\"");
+    static Counter s_webDeadlineMisses("soil_task_deadline_misses_total", "Jobs iniciados mais de um período após o prazo", "task=\"WebTask\"");
+
+    // Faixas em μs: da granularidade do tick até um período de broadcast perdido
+    static const uint32_t s_latencyBounds[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 100000 };
+    static const uint32_t s_busyBounds[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 20000 };
+    static const uint32_t s_mutexBounds[] = { 10, 50, 100, 500, 1000, 5000, 10000, 50000 };
+
+    static Histogram s_sensorWakeLatency("soil_task_wake_latency_seconds", "Atraso do despertar em relação ao prazo do job",
+                                         s_latencyBounds, sizeof(s_latencyBounds) / sizeof(s_latencyBounds[0]), 0.000001f, "task=\"SensorTask\"");
+    static Histogram s_webWakeLatency("soil_task_wake_latency_seconds", "Atraso do despertar em relação ao prazo do job",
+                                      s_latencyBounds, sizeof(s_latencyBounds) / sizeof(s_latencyBounds[0]), 0.000001f, "task=\"WebTask\"");
+    static Histogram s_sensorBusy("soil_task_busy_seconds", "Tempo de execução dos jobs em um despertar",
+                                  s_busyBounds, sizeof(s_busyBounds) / sizeof(s_busyBounds[0]), 0.000001f, "task=\"SensorTask\"");
+    static Histogram s_webBusy("soil_task_busy_seconds", "Tempo de execução dos jobs em um despertar",
+                               s_busyBounds, sizeof(s_busyBounds) / sizeof(s_busyBounds[0]), 0.000001f, "task=\"WebTask\"");
+
+    const TaskMetrics sensorTask = { s_sensorWakeups, s_sensorDeadlineMisses, s_sensorWakeLatency, s_sensorBusy };
+    const TaskMetrics webTask = { s_webWakeups, s_webDeadlineMisses, s_webWakeLatency, s_webBusy };
+
+    Histogram sensorMutexWait("soil_task_mutex_wait_seconds", "Espera por g_sensorMutex",
+                              s_mutexBounds, sizeof(s_mutexBounds) / sizeof(s_mutexBounds[0]), 0.000001f, "task=\"SensorTask\"");
+    Counter sensorMutexTimeouts("soil_task_mutex_timeouts_total", "Esperas por g_sensorMutex que expiraram", "task=\"SensorTask\"");
+
+    static Gauge s_heapFree("soil_heap_free_bytes", "Heap livre");
+    static Gauge s_heapMinFree("soil_heap_min_free_bytes", "Menor heap livre desde o boot");
+    static Gauge s_heapLargestBlock("soil_heap_largest_free_block_bytes", "Maior bloco livre do heap");
+    static Gauge s_uptime("soil_uptime_seconds", "Tempo desde o boot");
+
+    // Tarefas acompanhadas: as do firmware, a do AsyncTCP e a do Arduino
+    static const char *const s_taskNames[] = { "SensorTask", "WebTask", "UplinkTask", "async_tcp", "loopTask" };
+    static Gauge s_taskStack[] = {
+        { "soil_task_stack_free_bytes", "Menor folga de pilha da tarefa", "task=\"SensorTask\"" },
+        { "soil_task_stack_free_bytes", "Menor folga de pilha da tarefa", "task=\"WebTask\"" },
+        { "soil_task_stack_free_bytes", "Menor folga de pilha da tarefa", "task=\"UplinkTask\"" },
+        { "soil_task_stack_free_bytes", "Menor folga de pilha da tarefa", "task=\"async_tcp\"" },
+        { "soil_task_stack_free_bytes", "Menor folga de pilha da tarefa", "task=\"loopTask\"" }
+    };
+
+    void sampleSystem() {
+        s_heapFree.set(esp_get_free_heap_size());
+        s_heapMinFree.set(esp_get_minimum_free_heap_size());
+        s_heapLargestBlock.set(heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+        s_uptime.set(millis() / 1000);
+
+        // No ESP-IDF a marca d'água da pilha já vem em bytes
+        for (size_t i = 0; i < sizeof(s_taskNames) / sizeof(s_taskNames[0]); i++) {
+            TaskHandle_t task = xTaskGetHandle(s_taskNames[i]);
+            s_taskStack[i].set(task ? (int32_t)uxTaskGetStackHighWaterMark(task) : -1);
+        }
+    }
+}
@@ -11,6 +11,12 @@ AsyncSoilWebServer* OutputManager::s_webSocketServer = nullptr;
 ConsoleManager* OutputManager::s_consoleManager = nullptr;
 uint32_t OutputManager::s_lastUpdateTime[4][3] = {{0}};
 bool OutputManager::s_initialized = false;
+WireFormatStats OutputManager::s_jsonStats;
+WireFormatStats OutputManager::s_binaryStats;
+TelemetryDelta OutputManager::s_telemetryDelta[WS_RATE_CLASS_COUNT];
+uint32_t OutputManager::s_lastClassSend[WS_RATE_CLASS_COUNT] = {0};
+uint32_t OutputManager::s_logSequence[WS_RATE_CLASS_COUNT] = {0};
+char OutputManager::s_logFrame[WS_LOG_FRAME_SIZE + 1];
 
 void OutputManager::initialize() {
     if (s_initialized) {
@@ -54,6 +60,12 @@ void OutputManager::log(const char* module, LogLevel level,
     if (dest == OutputDestination::MEMORY_ONLY || dest == OutputDestination::BOTH) {
         routeToMemory(module, level, buffer);
     }
+
+    // Alertas seguem para todos os clientes WebSocket, sem conflação
+    if (type == MessageType::ALERT && s_webSocketServer &&
+        (dest == OutputDestination::WEBSOCKET_ONLY || dest == OutputDestination::BOTH)) {
+        s_webSocketServer->queueAlert(module, level, buffer);
+    }
 }
 
 void OutputManager::telemetry(const char* sensor, TelemetryBuffer& data) {
@@ -144,49 +156,322 @@ void OutputManager::routeToWebSocket(const char* sensor, TelemetryBuffer& data)
         return;
     }
 
-    // Cria documento JSON para a telemetria
-    StaticJsonDocument<512> doc;
+    uint32_t now = millis();
+    uint16_t clients = s_webSocketServer->getClientCount();
 
-    // Criamos os objetos principais que a página web espera
-    JsonObject root = doc.to<JsonObject>();
+    // Cópia local: a tabela é alterada pelos eventos da tarefa do AsyncTCP
+    ClientSubscription subscriptions[WS_MAX_SUBSCRIBERS];
+    size_t count = s_webSocketServer->getSubscriptions(subscriptions, WS_MAX_SUBSCRIBERS);
+
+    for (uint8_t rateClass = 0; rateClass < WS_RATE_CLASS_COUNT; rateClass++) {
+        // Tópicos assinados por algum cliente desta classe
+        uint8_t topics = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (subscriptions[i].rateClass == rateClass) {
+                topics |= subscriptions[i].topics;
+            }
+        }
+
+        if (topics == 0 || now - s_lastClassSend[rateClass] < SubscriptionTable::ratePeriod(rateClass)) {
+            continue;
+        }
+        s_lastClassSend[rateClass] = now;
+
+        if (topics & WS_TOPICS_TELEMETRY) {
+            routeTelemetryClass(sensor, data, rateClass, subscriptions, count, clients, now);
+        }
+        if (topics & WS_TOPIC_LOGS) {
+            routeLogClass(rateClass, subscriptions, count);
+        }
+    }
+}
 
-    // Criamos objetos para sensores e estatísticas
-    JsonObject sensors = root.createNestedObject("sensors");
-    JsonObject stats = root.createNestedObject("stats");
+void OutputManager::routeTelemetryClass(const char* sensor, const TelemetryBuffer& data, uint8_t rateClass,
+                                        const ClientSubscription* subscriptions, size_t count,
+                                        uint16_t clients, uint32_t now) {
+    // Campos alterados desde o último envio desta classe; quadro completo periódico
+    uint16_t fields = s_telemetryDelta[rateClass].compute(data, clients, now);
+    bool keyframe = fields == TELEMETRY_FIELDS_ALL;
+
+    // Um quadro por combinação (tópicos, formato), compartilhado pelos clientes
+    struct SharedFrame {
+        uint8_t topics;
+        bool binary;
+        AsyncWebSocketMessageBuffer* buffer;
+    };
+    SharedFrame frames[WS_MAX_SUBSCRIBERS];
+    size_t frameCount = 0;
+    bool dropped = false;
+
+    for (size_t i = 0; i < count; i++) {
+        const ClientSubscription& subscription = subscriptions[i];
+        uint8_t topics = subscription.topics & WS_TOPICS_TELEMETRY;
+        if (subscription.rateClass != rateClass || topics == 0) {
+            continue;
+        }
 
-    // Garantir que todos os campos necessários para a UI existam,
-    // mesmo que sejam zerados - isto evita o efeito de "zeragem"
+        SharedFrame* frame = nullptr;
+        for (size_t j = 0; j < frameCount; j++) {
+            if (frames[j].topics == topics && frames[j].binary == subscription.binary) {
+                frame = &frames[j];
+                break;
+            }
+        }
 
-    // Alimentamos os dados de sensores
-    sensors["temperature"] = data.temperature;
-    sensors["humidity"] = data.humidity;
-    sensors["timestamp"] = data.timestamp;
-    sensors["readCount"] = data.readCount;
+        if (frame == nullptr) {
+            frame = &frames[frameCount++];
+            frame->topics = topics;
+            frame->binary = subscription.binary;
+            frame->buffer = nullptr;
+
+            // Timestamp e contador acompanham os deltas, mas sozinhos não justificam um quadro
+            uint16_t mask = fields & SubscriptionTable::topicFields(topics);
+            if (!keyframe && (mask & ~(TELEMETRY_FIELD_TIMESTAMP | TELEMETRY_FIELD_READ_COUNT)) == 0) {
+                (subscription.binary ? s_binaryStats : s_jsonStats).suppress();
+            } else {
+                frame->buffer = subscription.binary
+                    ? buildBinaryFrame(data, mask, clients)
+                    : buildJsonFrame(sensor, data, mask, clients, keyframe);
+                dropped = dropped || frame->buffer == nullptr;
+            }
+        }
 
-    // Alimentamos as estatísticas do sistema
-    stats["freeHeap"] = data.freeHeap;
-    stats["fragmentation"] = data.heapFragmentation;
-    stats["uptime"] = data.uptime;
-    stats["wifiRssi"] = data.wifiRssi;
+        // Pool esgotado (clientes lentos): este quadro é descartado em vez de alocar
+        if (frame->buffer) {
+            s_webSocketServer->sendTelemetry(subscription, frame->buffer);
+        }
+    }
 
-    // Adicionar mais informações para a interface web
-    stats["wifi"] = String(data.wifiRssi) + " dBm";
-    stats["ipAddress"] = data.ipAddress;
+    // Cada mensagem enfileirada mantém sua própria referência ao buffer
+    for (size_t j = 0; j < frameCount; j++) {
+        if (frames[j].buffer) {
+            frames[j].buffer->unlock();
+        }
+    }
 
-    // A página web está buscando 'clients' - uma contagem de clientes
-    stats["clients"] = s_webSocketServer->getClientCount();
+    // Quadro descartado: a referência fica como está e os mesmos campos
+    // (ou o quadro completo) seguem no próximo período desta classe
+    if (!dropped) {
+        s_telemetryDelta[rateClass].commit(data, clients, fields, now);
+    }
+}
 
-    // Adiciona metadados
-    root["source"] = sensor;
-    root["timestamp"] = data.timestamp;
+void OutputManager::routeLogClass(uint8_t rateClass, const ClientSubscription* subscriptions, size_t count) {
+    CircularLogBuffer& logBuffer = CircularLogBuffer::getInstance();
+    uint32_t& sequence = s_logSequence[rateClass];
+    uint32_t firstSequence = sequence;
+
+    // {"type":"log","logs":[...]} montado entrada a entrada, sem documento grande na pilha
+    size_t length = snprintf(s_logFrame, sizeof(s_logFrame), "{\"type\":\"log\",\"logs\":[");
+    size_t entries = 0;
+    LogEntry entry;
+
+    while (logBuffer.readSince(sequence, &entry, 1) == 1) {
+        if (entries == 0) {
+            firstSequence = sequence;
+        }
+
+        StaticJsonDocument<128> doc;
+        doc["t"] = entry.timestamp;
+        doc["level"] = LogRouter::getInstance().levelToString(entry.level);
+        doc["module"] = static_cast<const char*>(entry.module);
+        doc["msg"] = static_cast<const char*>(entry.message);
+
+        // Separador, entrada e fechamento "]}" precisam caber no quadro
+        size_t entryLength = measureJson(doc);
+        if (length + (entries > 0 ? 1 : 0) + entryLength + 2 > WS_LOG_FRAME_SIZE) {
+            if (entries == 0) {
+                // Entrada maior que um quadro: descartada
+                sequence++;
+                continue;
+            }
+            break;
+        }
+
+        if (entries > 0) {
+            s_logFrame[length++] = ',';
+        }
+        length += serializeJson(doc, s_logFrame + length, sizeof(s_logFrame) - length);
+        entries++;
+        sequence++;
+    }
+
+    if (entries == 0) {
+        return;
+    }
+
+    s_logFrame[length++] = ']';
+    s_logFrame[length++] = '}';
+
+    // Tamanho arredondado para poucas classes, evitando realocar buffers do pool
+    size_t capacity = (length + WS_LOG_SIZE_CLASS - 1) / WS_LOG_SIZE_CLASS * WS_LOG_SIZE_CLASS;
+    if (capacity > WS_LOG_FRAME_SIZE) {
+        capacity = WS_LOG_FRAME_SIZE;
+    }
+
+    AsyncWebSocketMessageBuffer* buffer = s_webSocketServer->acquireLogBuffer(capacity);
+    if (!buffer) {
+        // Pool esgotado: as entradas seguem no próximo envio da classe
+        sequence = firstSequence;
+        return;
+    }
+
+    char* payload = reinterpret_cast<char*>(buffer->get());
+    memcpy(payload, s_logFrame, length);
+    memset(payload + length, ' ', capacity - length);
+
+    for (size_t i = 0; i < count; i++) {
+        if (subscriptions[i].rateClass == rateClass && (subscriptions[i].topics & WS_TOPIC_LOGS)) {
+            s_webSocketServer->sendLog(subscriptions[i], buffer);
+        }
+    }
+
+    buffer->unlock();
+}
 
-    // Serializa para string
-    String jsonString;
-    serializeJson(doc, jsonString);
+AsyncWebSocketMessageBuffer* OutputManager::buildBinaryFrame(const TelemetryBuffer& data, uint16_t fields,
+                                                             uint16_t clients) {
+    bool full = fields == TELEMETRY_FIELDS_ALL;
+    size_t length = full ? sizeof(TelemetryFrame) : TelemetryBuffer::binaryDeltaSize(fields);
 
-    // Agora que temos um único ponto de envio,
-    // todas as mensagens terão o mesmo formato completo
-    s_webSocketServer->broadcastMessage(jsonString);
+    // Serializado diretamente no buffer compartilhado
+    AsyncWebSocketMessageBuffer* buffer = s_webSocketServer->acquireBinaryBuffer(length);
+    if (!buffer) {
+        return nullptr;
+    }
+
+    uint32_t start = micros();
+    if (full) {
+        data.toBinary(*reinterpret_cast<TelemetryFrame*>(buffer->get()), clients);
+    } else {
+        data.toBinaryDelta(buffer->get(), fields, clients);
+    }
+    s_binaryStats.record(length, micros() - start, full);
+
+    return buffer;
+}
+
+AsyncWebSocketMessageBuffer* OutputManager::buildJsonFrame(const char* sensor, const TelemetryBuffer& data,
+                                                           uint16_t fields, uint16_t clients, bool full) {
+    uint32_t start = micros();
+
+    StaticJsonDocument<640> doc;
+    buildJson(doc, sensor, data, fields, clients, full);
+
+    // Tamanho arredondado para poucas classes, evitando realocar buffers do pool
+    size_t length = measureJson(doc);
+    size_t capacity = (length + WS_JSON_SIZE_CLASS - 1) / WS_JSON_SIZE_CLASS * WS_JSON_SIZE_CLASS;
+    if (capacity > WS_JSON_FRAME_SIZE) {
+        return nullptr;
+    }
+
+    AsyncWebSocketMessageBuffer* buffer = s_webSocketServer->acquireJsonBuffer(capacity);
+    if (!buffer) {
+        return nullptr;
+    }
+
+    // Serializa uma única vez, direto no buffer compartilhado pelos clientes
+    char* payload = reinterpret_cast<char*>(buffer->get());
+    serializeJson(doc, payload, capacity + 1);
+
+    // Completa com espaços (whitespace válido em JSON)
+    memset(payload + length, ' ', capacity - length);
+    s_jsonStats.record(capacity, micros() - start, fields == TELEMETRY_FIELDS_ALL);
+
+    return buffer;
+}
+
+void OutputManager::telemetrySnapshot(AsyncWebSocketClient* client, const ClientSubscription& subscription,
+                                      const TelemetryBuffer& data) {
+    if (!s_webSocketServer || !client) {
+        return;
+    }
+
+    // Assinatura apenas de logs: nada a enviar
+    uint16_t fields = SubscriptionTable::topicFields(subscription.topics);
+    if (fields == 0) {
+        return;
+    }
+
+    uint16_t clients = s_webSocketServer->getClientCount();
+
+    if (subscription.binary) {
+        if (fields == TELEMETRY_FIELDS_ALL) {
+            TelemetryFrame frame;
+            data.toBinary(frame, clients);
+            client->binary(reinterpret_cast<const char*>(&frame), sizeof(frame));
+        } else {
+            uint8_t frame[TELEMETRY_DELTA_MAX_SIZE];
+            size_t length = data.toBinaryDelta(frame, fields, clients);
+            client->binary(reinterpret_cast<const char*>(frame), length);
+        }
+        return;
+    }
+
+    StaticJsonDocument<640> doc;
+    buildJson(doc, "snapshot", data, fields, clients, true);
+
+    char payload[WS_JSON_FRAME_SIZE + 1];
+    size_t length = serializeJson(doc, payload, sizeof(payload));
+    if (length > 0 && length < sizeof(payload) - 1) {
+        client->text(payload, length);
+    }
+}
+
+void OutputManager::buildJson(JsonDocument& doc, const char* sensor, const TelemetryBuffer& data,
+                              uint16_t fields, uint16_t clients, bool full) {
+    // Criamos os objetos principais que a página web espera
+    JsonObject root = doc.to<JsonObject>();
+    root["type"] = full ? "full" : "delta";
+
+    // Quadros delta trazem apenas os campos alterados; a página mantém os demais
+    if (fields & (TELEMETRY_FIELD_TEMPERATURE | TELEMETRY_FIELD_HUMIDITY |
+                  TELEMETRY_FIELD_TIMESTAMP | TELEMETRY_FIELD_READ_COUNT |
+                  TELEMETRY_FIELD_TREND)) {
+        JsonObject sensors = root.createNestedObject("sensors");
+        if (fields & TELEMETRY_FIELD_TEMPERATURE) sensors["temperature"] = data.temperature;
+        if (fields & TELEMETRY_FIELD_HUMIDITY) sensors["humidity"] = data.humidity;
+        if (fields & TELEMETRY_FIELD_TIMESTAMP) sensors["timestamp"] = data.timestamp;
+        if (fields & TELEMETRY_FIELD_READ_COUNT) sensors["readCount"] = data.readCount;
+        if (fields & TELEMETRY_FIELD_TREND) data.trendToJson(sensors);
+    }
+
+    if (fields & (TELEMETRY_FIELD_FREE_HEAP | TELEMETRY_FIELD_FRAGMENTATION | TELEMETRY_FIELD_UPTIME |
+                  TELEMETRY_FIELD_WIFI_RSSI | TELEMETRY_FIELD_IP_ADDRESS | TELEMETRY_FIELD_CLIENTS |
+                  TELEMETRY_FIELD_CPU_LOAD)) {
+        JsonObject stats = root.createNestedObject("stats");
+        if (fields & TELEMETRY_FIELD_FREE_HEAP) stats["freeHeap"] = data.freeHeap;
+        if (fields & TELEMETRY_FIELD_FRAGMENTATION) stats["fragmentation"] = data.heapFragmentation;
+        if (fields & TELEMETRY_FIELD_UPTIME) stats["uptime"] = data.uptime;
+
+        if (fields & TELEMETRY_FIELD_WIFI_RSSI) {
+            // Texto para a interface web sem String temporária
+            int32_t rssi = static_cast<int32_t>(data.wifiRssi);
+            char wifi[16];
+            snprintf(wifi, sizeof(wifi), "%d dBm", static_cast<int>(rssi));
+            stats["wifiRssi"] = rssi;
+            stats["wifi"] = wifi;
+        }
+
+        if (fields & TELEMETRY_FIELD_IP_ADDRESS) stats["ipAddress"] = data.ipAddress;
+
+        // A página web está buscando 'clients' - uma contagem de clientes
+        if (fields & TELEMETRY_FIELD_CLIENTS) stats["clients"] = clients;
+
+        if (fields & TELEMETRY_FIELD_CPU_LOAD) {
+            JsonArray cpu = stats.createNestedArray("cpu");
+            cpu.add(data.cpuLoad[0]);
+            cpu.add(data.cpuLoad[1]);
+        }
+    }
+
+    // Adiciona metadados
+    if (full) {
+        root["source"] = sensor;
+    }
+    if (fields & TELEMETRY_FIELD_TIMESTAMP) {
+        root["timestamp"] = data.timestamp;
+    }
 }
 
 void OutputManager::routeToMemory(const char* module, LogLevel level, const char* message) {
@@ -200,4 +485,12 @@ void OutputManager::attachWebSocketServer(AsyncSoilWebServer* server) {
 
 void OutputManager::attachConsoleManager(ConsoleManager* console) {
     s_consoleManager = console;
+}
+
+const WireFormatStats& OutputManager::getJsonStats() {
+    return s_jsonStats;
+}
+
+const WireFormatStats& OutputManager::getBinaryStats() {
+    return s_binaryStats;
 }
\ No newline at end of file
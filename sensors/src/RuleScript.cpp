@@ -0,0 +1,548 @@
+/**
+ * @file RuleScript.cpp
+ * @brief Implementação do compilador e do interpretador de regras.
+ */
+
+#include "RuleScript.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Nomes das variáveis, na ordem de RuleInput
+static const char *const s_inputNames[] = {
+    "temperatura",
+    "umidade",
+    "taxa_temperatura",
+    "taxa_umidade",
+    "sigma_temperatura",
+    "sigma_umidade",
+    "ativo",
+};
+
+static_assert(sizeof(s_inputNames) / sizeof(s_inputNames[0]) == static_cast<size_t>(RuleInput::COUNT),
+              "Cada RuleInput precisa de um nome");
+
+// Aninhamento máximo de parênteses e operadores unários (limita a recursão)
+static const uint8_t MAX_NESTING = 16;
+
+/**
+ * Analisador descendente recursivo que emite o código durante a análise.
+ *
+ * Acompanha a profundidade da pilha a cada instrução emitida para
+ * rejeitar, ainda na compilação, programas que estourariam a pilha.
+ */
+class RuleParser {
+public:
+    RuleParser(const char *source, RuleProgram &program, RuleCompileError &error)
+        : m_source(source), m_pos(0), m_program(program), m_error(error),
+          m_depth(0), m_nesting(0), m_failed(false) {}
+
+    bool parse() {
+        m_program.length = 0;
+        m_program.constantCount = 0;
+        m_program.maxStack = 0;
+
+        skipSpaces();
+        if (m_source[m_pos] == '\0') {
+            return fail("Expressão vazia");
+        }
+
+        expression();
+        if (m_failed) {
+            return false;
+        }
+
+        skipSpaces();
+        if (m_source[m_pos] != '\0') {
+            return fail("Caractere inesperado");
+        }
+
+        return true;
+    }
+
+private:
+    const char *m_source;
+    size_t m_pos;
+    RuleProgram &m_program;
+    RuleCompileError &m_error;
+    uint8_t m_depth;            // Profundidade da pilha após o código emitido
+    uint8_t m_nesting;
+    bool m_failed;
+
+    bool fail(const char *message) {
+        if (!m_failed) {
+            m_failed = true;
+            m_error.position = static_cast<uint8_t>(m_pos < 255 ? m_pos : 255);
+            m_error.message = message;
+        }
+        return false;
+    }
+
+    void skipSpaces() {
+        while (m_source[m_pos] == ' ' || m_source[m_pos] == '\t') {
+            m_pos++;
+        }
+    }
+
+    /**
+     * Consome um operador se ele é o próximo símbolo.
+     */
+    bool accept(const char *symbol) {
+        skipSpaces();
+        size_t length = strlen(symbol);
+        if (strncmp(m_source + m_pos, symbol, length) != 0) {
+            return false;
+        }
+
+        // "<" não pode consumir o início de "<=", nem "!" o de "!="
+        if (length == 1 && m_source[m_pos + 1] == '=' &&
+            (symbol[0] == '<' || symbol[0] == '>' || symbol[0] == '!')) {
+            return false;
+        }
+
+        m_pos += length;
+        return true;
+    }
+
+    void expect(const char *symbol, const char *message) {
+        if (!m_failed && !accept(symbol)) {
+            fail(message);
+        }
+    }
+
+    void emitByte(uint8_t value) {
+        if (m_failed) {
+            return;
+        }
+        if (m_program.length >= RuleProgram::MAX_CODE) {
+            fail("Expressão longa demais");
+            return;
+        }
+        m_program.code[m_program.length++] = value;
+    }
+
+    /**
+     * Emite uma instrução e ajusta a profundidade da pilha.
+     *
+     * @param op Instrução.
+     * @param pops Valores desempilhados.
+     * @param pushes Valores empilhados.
+     */
+    void emit(RuleOp op, uint8_t pops, uint8_t pushes) {
+        emitByte(static_cast<uint8_t>(op));
+        m_depth = static_cast<uint8_t>(m_depth - pops + pushes);
+        if (m_depth > m_program.maxStack) {
+            m_program.maxStack = m_depth;
+            if (m_depth > RuleProgram::STACK_SIZE) {
+                fail("Expressão aninhada demais para a pilha");
+            }
+        }
+    }
+
+    /**
+     * Emite um salto e devolve a posição do deslocamento a corrigir.
+     */
+    size_t emitJump(RuleOp op, uint8_t pops) {
+        emit(op, pops, 0);
+        size_t operand = m_program.length;
+        emitByte(0);
+        return operand;
+    }
+
+    /**
+     * Aponta o salto emitido em operand para o código atual.
+     */
+    void patchJump(size_t operand) {
+        if (!m_failed) {
+            m_program.code[operand] = static_cast<uint8_t>(m_program.length - operand - 1);
+        }
+    }
+
+    void emitConstant(float value) {
+        uint8_t index = 0;
+        while (index < m_program.constantCount && m_program.constants[index] != value) {
+            index++;
+        }
+
+        if (index == m_program.constantCount) {
+            if (index >= RuleProgram::MAX_CONSTANTS) {
+                fail("Constantes demais");
+                return;
+            }
+            m_program.constants[m_program.constantCount++] = value;
+        }
+
+        emit(RuleOp::CONST, 0, 1);
+        emitByte(index);
+    }
+
+    void expression() {
+        if (++m_nesting > MAX_NESTING) {
+            fail("Expressão aninhada demais");
+            return;
+        }
+
+        logicalOr();
+
+        // Condicional: cond ? a : b (associativo à direita)
+        if (!m_failed && accept("?")) {
+            size_t elseJump = emitJump(RuleOp::JZ, 1);
+            uint8_t depth = m_depth;
+            expression();
+            size_t endJump = emitJump(RuleOp::JMP, 0);
+            expect(":", "Esperado ':'");
+            patchJump(elseJump);
+            m_depth = depth;
+            expression();
+            patchJump(endJump);
+        }
+
+        m_nesting--;
+    }
+
+    void logicalOr() {
+        logicalAnd();
+        while (!m_failed && accept("||")) {
+            // Verdadeiro à esquerda decide sem avaliar a direita
+            size_t jump = emitJump(RuleOp::OR, 0);
+            m_depth--;
+            logicalAnd();
+            patchJump(jump);
+            emit(RuleOp::BOOL, 1, 1);
+        }
+    }
+
+    void logicalAnd() {
+        equality();
+        while (!m_failed && accept("&&")) {
+            // Falso à esquerda decide sem avaliar a direita
+            size_t jump = emitJump(RuleOp::AND, 0);
+            m_depth--;
+            equality();
+            patchJump(jump);
+            emit(RuleOp::BOOL, 1, 1);
+        }
+    }
+
+    void equality() {
+        comparison();
+        while (!m_failed) {
+            RuleOp op;
+            if (accept("==")) {
+                op = RuleOp::EQ;
+            } else if (accept("!=")) {
+                op = RuleOp::NE;
+            } else {
+                break;
+            }
+            comparison();
+            emit(op, 2, 1);
+        }
+    }
+
+    void comparison() {
+        sum();
+        while (!m_failed) {
+            RuleOp op;
+            if (accept("<=")) {
+                op = RuleOp::LE;
+            } else if (accept(">=")) {
+                op = RuleOp::GE;
+            } else if (accept("<")) {
+                op = RuleOp::LT;
+            } else if (accept(">")) {
+                op = RuleOp::GT;
+            } else {
+                break;
+            }
+            sum();
+            emit(op, 2, 1);
+        }
+    }
+
+    void sum() {
+        product();
+        while (!m_failed) {
+            RuleOp op;
+            if (accept("+")) {
+                op = RuleOp::ADD;
+            } else if (accept("-")) {
+                op = RuleOp::SUB;
+            } else {
+                break;
+            }
+            product();
+            emit(op, 2, 1);
+        }
+    }
+
+    void product() {
+        unary();
+        while (!m_failed) {
+            RuleOp op;
+            if (accept("*")) {
+                op = RuleOp::MUL;
+            } else if (accept("/")) {
+                op = RuleOp::DIV;
+            } else {
+                break;
+            }
+            unary();
+            emit(op, 2, 1);
+        }
+    }
+
+    void unary() {
+        if (++m_nesting > MAX_NESTING) {
+            fail("Expressão aninhada demais");
+            return;
+        }
+
+        if (accept("-")) {
+            unary();
+            emit(RuleOp::NEG, 1, 1);
+        } else if (accept("!")) {
+            unary();
+            emit(RuleOp::NOT, 1, 1);
+        } else {
+            primary();
+        }
+
+        m_nesting--;
+    }
+
+    void primary() {
+        skipSpaces();
+        char c = m_source[m_pos];
+
+        if (c == '(') {
+            m_pos++;
+            expression();
+            expect(")", "Esperado ')'");
+            return;
+        }
+
+        if ((c >= '0' && c <= '9') || c == '.') {
+            number();
+            return;
+        }
+
+        if ((c >= 'a' && c <= 'z') || c == '_') {
+            identifier();
+            return;
+        }
+
+        fail(c == '\0' ? "Fim inesperado da expressão" : "Caractere inesperado");
+    }
+
+    void number() {
+        const char *start = m_source + m_pos;
+        char *end = nullptr;
+        float value = strtof(start, &end);
+
+        if (end == start || !isfinite(value)) {
+            fail("Número inválido");
+            return;
+        }
+
+        m_pos += end - start;
+        emitConstant(value);
+    }
+
+    void identifier() {
+        size_t start = m_pos;
+        while ((m_source[m_pos] >= 'a' && m_source[m_pos] <= 'z') ||
+               (m_source[m_pos] >= '0' && m_source[m_pos] <= '9') || m_source[m_pos] == '_') {
+            m_pos++;
+        }
+        size_t length = m_pos - start;
+        const char *name = m_source + start;
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(RuleInput::COUNT); i++) {
+            if (strlen(s_inputNames[i]) == length && strncmp(s_inputNames[i], name, length) == 0) {
+                emit(RuleOp::LOAD, 0, 1);
+                emitByte(i);
+                return;
+            }
+        }
+
+        if (length == 3 && strncmp(name, "abs", 3) == 0) {
+            expect("(", "Esperado '('");
+            expression();
+            expect(")", "Esperado ')'");
+            emit(RuleOp::ABS, 1, 1);
+            return;
+        }
+
+        if (length == 3 && (strncmp(name, "min", 3) == 0 || strncmp(name, "max", 3) == 0)) {
+            RuleOp op = name[1] == 'i' ? RuleOp::MIN : RuleOp::MAX;
+            expect("(", "Esperado '('");
+            expression();
+            expect(",", "Esperado ','");
+            expression();
+            expect(")", "Esperado ')'");
+            emit(op, 2, 1);
+            return;
+        }
+
+        m_pos = start;
+        fail("Variável ou função desconhecida");
+    }
+};
+
+bool RuleCompiler::compile(const char *source, RuleProgram &program, RuleCompileError &error) {
+    error.position = 0;
+    error.message = nullptr;
+
+    if (source == nullptr) {
+        error.message = "Expressão vazia";
+        return false;
+    }
+
+    RuleParser parser(source, program, error);
+    return parser.parse();
+}
+
+const char *RuleCompiler::inputName(RuleInput input) {
+    uint8_t index = static_cast<uint8_t>(input);
+    return index < static_cast<uint8_t>(RuleInput::COUNT) ? s_inputNames[index] : "?";
+}
+
+RuleInterpreter::Status RuleInterpreter::run(const RuleProgram &program, const float *inputs, float &result) {
+    float stack[RuleProgram::STACK_SIZE];
+    uint8_t sp = 0;
+    uint16_t pc = 0;
+    uint16_t length = program.length <= RuleProgram::MAX_CODE ? program.length : RuleProgram::MAX_CODE;
+    uint16_t budget = RuleProgram::MAX_CODE;
+
+    while (pc < length) {
+        // Com saltos só para a frente o orçamento nunca se esgota em código
+        // do compilador; a verificação protege contra código corrompido
+        if (budget-- == 0) {
+            return Status::BUDGET;
+        }
+
+        RuleOp op = static_cast<RuleOp>(program.code[pc++]);
+        switch (op) {
+            case RuleOp::CONST:
+            case RuleOp::LOAD: {
+                if (pc >= length || sp >= RuleProgram::STACK_SIZE) {
+                    return pc >= length ? Status::INVALID : Status::STACK;
+                }
+                uint8_t operand = program.code[pc++];
+                if (op == RuleOp::CONST) {
+                    if (operand >= program.constantCount || operand >= RuleProgram::MAX_CONSTANTS) {
+                        return Status::INVALID;
+                    }
+                    stack[sp++] = program.constants[operand];
+                } else {
+                    if (operand >= static_cast<uint8_t>(RuleInput::COUNT)) {
+                        return Status::INVALID;
+                    }
+                    stack[sp++] = inputs[operand];
+                }
+                break;
+            }
+
+            case RuleOp::NEG:
+            case RuleOp::NOT:
+            case RuleOp::ABS:
+            case RuleOp::BOOL: {
+                if (sp < 1) {
+                    return Status::STACK;
+                }
+                float &a = stack[sp - 1];
+                if (op == RuleOp::NEG) {
+                    a = -a;
+                } else if (op == RuleOp::ABS) {
+                    a = fabsf(a);
+                } else if (op == RuleOp::NOT) {
+                    a = a == 0.0f ? 1.0f : 0.0f;
+                } else {
+                    a = a != 0.0f ? 1.0f : 0.0f;
+                }
+                break;
+            }
+
+            case RuleOp::ADD:
+            case RuleOp::SUB:
+            case RuleOp::MUL:
+            case RuleOp::DIV:
+            case RuleOp::MIN:
+            case RuleOp::MAX:
+            case RuleOp::LT:
+            case RuleOp::LE:
+            case RuleOp::GT:
+            case RuleOp::GE:
+            case RuleOp::EQ:
+            case RuleOp::NE: {
+                if (sp < 2) {
+                    return Status::STACK;
+                }
+                float b = stack[--sp];
+                float &a = stack[sp - 1];
+                switch (op) {
+                    case RuleOp::ADD: a = a + b; break;
+                    case RuleOp::SUB: a = a - b; break;
+                    case RuleOp::MUL: a = a * b; break;
+                    case RuleOp::DIV: a = a / b; break;
+                    case RuleOp::MIN: a = b < a ? b : a; break;
+                    case RuleOp::MAX: a = b > a ? b : a; break;
+                    case RuleOp::LT: a = a < b ? 1.0f : 0.0f; break;
+                    case RuleOp::LE: a = a <= b ? 1.0f : 0.0f; break;
+                    case RuleOp::GT: a = a > b ? 1.0f : 0.0f; break;
+                    case RuleOp::GE: a = a >= b ? 1.0f : 0.0f; break;
+                    case RuleOp::EQ: a = a == b ? 1.0f : 0.0f; break;
+                    default:         a = a != b ? 1.0f : 0.0f; break;
+                }
+                break;
+            }
+
+            case RuleOp::AND:
+            case RuleOp::OR:
+            case RuleOp::JZ:
+            case RuleOp::JMP: {
+                if (pc >= length) {
+                    return Status::INVALID;
+                }
+                uint8_t offset = program.code[pc++];
+                if (offset > length - pc) {
+                    return Status::INVALID;
+                }
+
+                bool jump = true;
+                if (op != RuleOp::JMP) {
+                    if (sp < 1) {
+                        return Status::STACK;
+                    }
+                    bool truthy = stack[sp - 1] != 0.0f;
+                    if (op == RuleOp::JZ) {
+                        sp--;
+                        jump = !truthy;
+                    } else {
+                        // Decidido pela esquerda: mantém o valor; senão a direita o substitui
+                        jump = (op == RuleOp::AND) ? !truthy : truthy;
+                        if (!jump) {
+                            sp--;
+                        }
+                    }
+                }
+
+                if (jump) {
+                    pc += offset;
+                }
+                break;
+            }
+
+            default:
+                return Status::INVALID;
+        }
+    }
+
+    if (sp != 1) {
+        return Status::STACK;
+    }
+
+    result = stack[0];
+    return Status::OK;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file RuleStore.cpp
+ * @brief Implementação do repositório de regras configuradas.
+ */
+
+#include "RuleStore.h"
+#include "LogSystem.h"
+#include <Preferences.h>
+
+// Nome do módulo para logs
+#define MODULE_NAME "Rules"
+
+// Chaves na NVS
+static const char *KEY_COUNT = "count";
+static const char *KEY_SOURCES = "sources";
+
+RuleStore *RuleStore::s_instance = nullptr;
+
+RuleStore::RuleStore() : m_count(0) {
+    memset(m_sources, 0, sizeof(m_sources));
+    memset(&m_staging, 0, sizeof(m_staging));
+}
+
+RuleStore &RuleStore::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new RuleStore();
+    }
+    return *s_instance;
+}
+
+uint8_t RuleStore::begin() {
+    Preferences prefs;
+    if (!prefs.begin(RULE_NVS_NAMESPACE, true)) {
+        LOG_INFO(MODULE_NAME, "Nenhuma regra configurada");
+        return 0;
+    }
+
+    uint8_t count = prefs.getUChar(KEY_COUNT, 0);
+    size_t expected = count * sizeof(RuleSource);
+    bool valid = count <= RuleSet::MAX_RULES && prefs.getBytesLength(KEY_SOURCES) == expected;
+
+    RuleSource sources[RuleSet::MAX_RULES];
+    if (valid && count > 0) {
+        valid = prefs.getBytes(KEY_SOURCES, sources, expected) == expected;
+    }
+    prefs.end();
+
+    if (!valid) {
+        LOG_WARN(MODULE_NAME, "Regras salvas com formato inválido, descartadas");
+        return 0;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    // Os nomes e expressões vieram da NVS: garante os terminadores
+    for (uint8_t i = 0; i < count; i++) {
+        sources[i].name[sizeof(sources[i].name) - 1] = '\0';
+        sources[i].expression[sizeof(sources[i].expression) - 1] = '\0';
+    }
+
+    RuleUpdateError error;
+    if (!compile(sources, count, error)) {
+        LOG_WARN(MODULE_NAME, "Regra salva %u não compila (%s), regras descartadas",
+            static_cast<unsigned>(error.rule), error.message);
+        return 0;
+    }
+
+    memcpy(m_sources, sources, count * sizeof(RuleSource));
+    m_count = count;
+    m_published.write(m_staging);
+
+    LOG_INFO(MODULE_NAME, "%u regras configuradas carregadas", static_cast<unsigned>(count));
+    return count;
+}
+
+bool RuleStore::update(const RuleSource *sources, uint8_t count, RuleUpdateError &error) {
+    if (!compile(sources, count, error)) {
+        LOG_WARN(MODULE_NAME, "Regra %u rejeitada na posição %u: %s",
+            static_cast<unsigned>(error.rule), static_cast<unsigned>(error.position), error.message);
+        return false;
+    }
+
+    // Publica antes de gravar: a NVS é lenta e a regra já vale se a gravação falhar
+    if (count > 0) {
+        memcpy(m_sources, sources, count * sizeof(RuleSource));
+    }
+    m_count = count;
+    m_published.write(m_staging);
+
+    if (!persist()) {
+        LOG_WARN(MODULE_NAME, "Falha ao gravar as regras; valem até o próximo boot");
+    }
+
+    LOG_INFO(MODULE_NAME, "%u regras configuradas publicadas", static_cast<unsigned>(count));
+    return true;
+}
+
+const RuleSource *RuleStore::getSource(uint8_t index) const {
+    return index < m_count ? &m_sources[index] : nullptr;
+}
+
+bool RuleStore::compile(const RuleSource *sources, uint8_t count, RuleUpdateError &error) {
+    error.rule = 0;
+    error.position = 0;
+    error.message = nullptr;
+
+    if (count > RuleSet::MAX_RULES) {
+        error.rule = RuleSet::MAX_RULES;
+        error.message = "Regras demais";
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        const RuleSource &source = sources[i];
+        RuleProgram &program = m_staging.rules[i];
+        error.rule = i;
+
+        // O nome vai para a API e para os logs: só letras, dígitos e '_'
+        if (source.name[0] == '\0') {
+            error.message = "Nome vazio";
+            return false;
+        }
+        for (const char *c = source.name; *c != '\0'; c++) {
+            if (!isalnum(static_cast<unsigned char>(*c)) && *c != '_') {
+                error.position = static_cast<uint8_t>(c - source.name);
+                error.message = "Nome inválido";
+                return false;
+            }
+        }
+        for (uint8_t j = 0; j < i; j++) {
+            if (strcmp(sources[j].name, source.name) == 0) {
+                error.message = "Nome repetido";
+                return false;
+            }
+        }
+
+        // A expressão volta em GET /rules sem escape: o compilador aceita
+        // tabulação como espaço, mas nenhum caractere de controle é guardado
+        for (const char *c = source.expression; *c != '\0'; c++) {
+            if (static_cast<unsigned char>(*c) < 0x20) {
+                error.position = static_cast<uint8_t>(c - source.expression);
+                error.message = "Caractere de controle";
+                return false;
+            }
+        }
+
+        RuleCompileError compileError;
+        if (!RuleCompiler::compile(source.expression, program, compileError)) {
+            error.position = compileError.position;
+            error.message = compileError.message;
+            return false;
+        }
+
+        memcpy(program.name, source.name, sizeof(program.name));
+        program.holdMs = source.holdMs;
+        program.clearMs = source.clearMs;
+    }
+
+    m_staging.count = count;
+    error.rule = 0;
+    return true;
+}
+
+bool RuleStore::persist() {
+    Preferences prefs;
+    if (!prefs.begin(RULE_NVS_NAMESPACE, false)) {
+        return false;
+    }
+
+    // Fontes antes da contagem: um boot no meio da gravação descarta tudo
+    // em vez de ler regras misturadas
+    bool ok = true;
+    if (m_count > 0) {
+        size_t length = m_count * sizeof(RuleSource);
+        ok = prefs.putBytes(KEY_SOURCES, m_sources, length) == length;
+    } else {
+        prefs.remove(KEY_SOURCES);
+    }
+    ok = ok && prefs.putUChar(KEY_COUNT, m_count) == 1;
+
+    prefs.end();
+    return ok;
+}
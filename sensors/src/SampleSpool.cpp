@@ -0,0 +1,464 @@
+/**
+ * @file SampleSpool.cpp
+ * @brief Implementação do spool de amostras em RAM e flash.
+ */
+
+#include "SampleSpool.h"
+#include "LogSystem.h"
+#include <Preferences.h>
+
+// Nome do módulo para logs
+#define MODULE_NAME "Spool"
+
+SampleSpool::SampleSpool()
+    : m_ramHead(0),
+    m_ramCount(0),
+    m_partition(nullptr),
+    m_totalSlots(0),
+    m_readPos(0),
+    m_writePos(0),
+    m_flashPending(0),
+    m_nextSerial(1),
+    m_ackedSerial(0),
+    m_flashOldestTimestamp(0),
+    m_flashOldestBoot(0),
+    m_bootId(0),
+    m_peekFromFlash(false),
+    m_peekCount(0),
+    m_peekEndPos(0),
+    m_peekLastSerial(0),
+    m_peekBoot(0),
+    m_lastAckMs(0),
+    m_spilled(0),
+    m_drained(0),
+    m_lost(0),
+    m_segmentErases(0),
+    m_drainRate(0.0f),
+    m_oldestTimestamp(0),
+    m_oldestPreviousBoot(false),
+    m_statsLock(portMUX_INITIALIZER_UNLOCKED) {
+}
+
+bool SampleSpool::begin() {
+    loadBootId();
+    m_peekBoot = m_bootId;
+
+    m_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                           ESP_PARTITION_SUBTYPE_ANY,
+                                           SPOOL_PARTITION_LABEL);
+
+    size_t segments = m_partition ? m_partition->size / SEGMENT_SIZE : 0;
+    if (segments > SPOOL_FLASH_SEGMENTS) {
+        segments = SPOOL_FLASH_SEGMENTS;
+    }
+
+    if (segments < 2) {
+        m_partition = nullptr;
+        LOG_WARN(MODULE_NAME, "Partição '%s' indisponível, spool apenas em RAM (%u amostras)",
+            SPOOL_PARTITION_LABEL, SPOOL_RAM_CAPACITY);
+        updateStats();
+        return false;
+    }
+
+    m_totalSlots = segments * SLOTS_PER_SEGMENT;
+
+    // 1ª passada: último registro gravado e último serial confirmado
+    SpoolRecord record;
+    uint32_t maxSerial = 0;
+    size_t maxPos = 0;
+    bool found = false;
+
+    for (size_t pos = 0; pos < m_totalSlots; pos++) {
+        if (!readRecord(pos, record)) {
+            continue;
+        }
+        if (!found || record.serial > maxSerial) {
+            maxSerial = record.serial;
+            maxPos = pos;
+            found = true;
+        }
+        if (record.type == RECORD_ACK && record.value > m_ackedSerial) {
+            m_ackedSerial = record.value;
+        }
+    }
+
+    if (found) {
+        m_writePos = (maxPos + 1) % m_totalSlots;
+        m_nextSerial = maxSerial + 1;
+
+        // 2ª passada, em ordem de gravação: amostras ainda não confirmadas
+        for (size_t i = 0; i < m_totalSlots; i++) {
+            size_t pos = (m_writePos + i) % m_totalSlots;
+            if (readRecord(pos, record) && record.type == RECORD_DATA &&
+                record.serial > m_ackedSerial) {
+                if (m_flashPending == 0) {
+                    m_readPos = pos;
+                    m_flashOldestTimestamp = record.value;
+                    m_flashOldestBoot = record.boot;
+                }
+                m_flashPending++;
+            }
+        }
+
+        if (m_flashPending == 0) {
+            m_readPos = m_writePos;
+        }
+    }
+
+    LOG_INFO(MODULE_NAME, "Spool na flash: %u setores, %u amostras pendentes (boot %u)",
+        static_cast<unsigned>(segments), static_cast<unsigned>(m_flashPending),
+        static_cast<unsigned>(m_bootId));
+
+    updateStats();
+    return true;
+}
+
+void SampleSpool::push(const SensorData &data) {
+    if (m_ramCount == SPOOL_RAM_CAPACITY) {
+        if (m_partition) {
+            spill(SPOOL_SPILL_CHUNK);
+        } else {
+            // Sem flash: descarta a amostra mais antiga
+            m_ramHead = (m_ramHead + 1) % SPOOL_RAM_CAPACITY;
+            m_ramCount--;
+            m_lost++;
+        }
+    }
+
+    m_ram[(m_ramHead + m_ramCount) % SPOOL_RAM_CAPACITY] = data;
+    m_ramCount++;
+
+    updateStats();
+}
+
+size_t SampleSpool::peek(SensorData *out, size_t maxCount) {
+    m_peekCount = 0;
+    m_peekFromFlash = m_flashPending > 0;
+
+    if (m_peekFromFlash) {
+        // Amostras da flash são sempre mais antigas que as da RAM
+        size_t pos = m_readPos;
+        size_t remaining = occupiedSlots();
+        SpoolRecord record;
+
+        while (m_peekCount < maxCount && remaining > 0) {
+            if (readRecord(pos, record) && record.type == RECORD_DATA &&
+                record.serial > m_ackedSerial) {
+                // O lote termina na primeira amostra de outro boot: os
+                // timestamps de boots diferentes não são comparáveis
+                uint32_t boot = expandBoot(record.boot);
+                if (m_peekCount == 0) {
+                    m_peekBoot = boot;
+                } else if (boot != m_peekBoot) {
+                    break;
+                }
+
+                SensorData &data = out[m_peekCount++];
+                data.timestamp = record.value;
+                data.temperature = record.temperature / 100.0f;
+                data.humidityPercent = record.humidity / 100.0f;
+                m_peekLastSerial = record.serial;
+            }
+            pos = (pos + 1) % m_totalSlots;
+            remaining--;
+        }
+
+        m_peekEndPos = pos;
+        if (m_peekCount > 0) {
+            return m_peekCount;
+        }
+
+        // Contagem divergente do log (registros corrompidos): ressincroniza
+        LOG_WARN(MODULE_NAME, "Nenhum registro válido na flash, %u pendentes descartados",
+            static_cast<unsigned>(m_flashPending));
+        m_lost += m_flashPending;
+        m_flashPending = 0;
+        m_readPos = m_writePos;
+        m_peekFromFlash = false;
+    }
+
+    // A RAM só contém amostras deste boot
+    m_peekBoot = m_bootId;
+    size_t count = m_ramCount < maxCount ? m_ramCount : maxCount;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = m_ram[(m_ramHead + i) % SPOOL_RAM_CAPACITY];
+    }
+    m_peekCount = count;
+
+    return count;
+}
+
+void SampleSpool::ack() {
+    release(true);
+}
+
+void SampleSpool::discard() {
+    release(false);
+}
+
+void SampleSpool::release(bool delivered) {
+    if (m_peekCount == 0) {
+        return;
+    }
+
+    if (m_peekFromFlash) {
+        m_readPos = m_peekEndPos;
+        m_ackedSerial = m_peekLastSerial;
+        m_flashPending -= m_peekCount <= m_flashPending ? m_peekCount : m_flashPending;
+
+        // Persiste a confirmação para não reenviar após um reinício
+        SpoolRecord record = {};
+        record.serial = m_nextSerial++;
+        record.value = m_ackedSerial;
+        record.type = RECORD_ACK;
+        fillCrc(record);
+        appendRecords(&record, 1);
+
+        refreshFlashOldest();
+    } else {
+        m_ramHead = (m_ramHead + m_peekCount) % SPOOL_RAM_CAPACITY;
+        m_ramCount -= m_peekCount;
+    }
+
+    if (delivered) {
+        // Vazão medida entre confirmações consecutivas
+        uint32_t now = millis();
+        if (m_lastAckMs != 0 && now > m_lastAckMs) {
+            m_drainRate = m_peekCount * 1000.0f / (now - m_lastAckMs);
+        }
+        m_lastAckMs = now;
+
+        m_drained += m_peekCount;
+    } else {
+        m_lost += m_peekCount;
+    }
+    m_peekCount = 0;
+
+    updateStats();
+}
+
+size_t SampleSpool::pending() const {
+    return m_flashPending + m_ramCount;
+}
+
+uint32_t SampleSpool::oldestTimestamp() const {
+    if (m_flashPending > 0) {
+        return m_flashOldestTimestamp;
+    }
+    return m_ramCount > 0 ? m_ram[m_ramHead].timestamp : 0;
+}
+
+SpoolStats SampleSpool::getStats() const {
+    portENTER_CRITICAL(&m_statsLock);
+    SpoolStats stats = m_stats;
+    uint32_t oldest = m_oldestTimestamp;
+    bool previousBoot = m_oldestPreviousBoot;
+    portEXIT_CRITICAL(&m_statsLock);
+
+    // A idade é calculada na leitura para refletir o tempo atual
+    uint32_t now = millis();
+    // Amostra de um boot anterior: no mínimo tão antiga quanto este boot
+    if (previousBoot) {
+        stats.oldestAgeMs = now;
+    } else {
+        stats.oldestAgeMs = (oldest != 0 && now > oldest) ? now - oldest : 0;
+    }
+    return stats;
+}
+
+void SampleSpool::loadBootId() {
+    Preferences prefs;
+    if (!prefs.begin(SPOOL_NVS_NAMESPACE, false)) {
+        LOG_WARN(MODULE_NAME, "NVS indisponível, boot das amostras desconhecido");
+        return;
+    }
+
+    m_bootId = prefs.getUInt("boot", 0) + 1;
+    prefs.putUInt("boot", m_bootId);
+    prefs.end();
+}
+
+uint32_t SampleSpool::expandBoot(uint8_t boot) const {
+    return m_bootId - static_cast<uint8_t>(static_cast<uint8_t>(m_bootId) - boot);
+}
+
+void SampleSpool::spill(size_t count) {
+    SpoolRecord records[SPOOL_SPILL_CHUNK];
+
+    if (count > m_ramCount) {
+        count = m_ramCount;
+    }
+    if (count > SPOOL_SPILL_CHUNK) {
+        count = SPOOL_SPILL_CHUNK;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const SensorData &data = m_ram[(m_ramHead + i) % SPOOL_RAM_CAPACITY];
+        SpoolRecord &record = records[i];
+        record.serial = m_nextSerial++;
+        record.value = data.timestamp;
+        record.temperature = static_cast<int16_t>(lroundf(data.temperature * 100.0f));
+        record.humidity = static_cast<uint16_t>(lroundf(data.humidityPercent * 100.0f));
+        record.type = RECORD_DATA;
+        record.boot = static_cast<uint8_t>(m_bootId);
+        fillCrc(record);
+    }
+
+    if (m_flashPending == 0) {
+        m_readPos = m_writePos;
+        m_flashOldestTimestamp = records[0].value;
+        m_flashOldestBoot = records[0].boot;
+    }
+
+    // Uma única sequência de escritas por bloco reduz operações na flash
+    if (appendRecords(records, count)) {
+        m_flashPending += count;
+        m_spilled += count;
+    } else {
+        LOG_ERROR(MODULE_NAME, "Falha ao gravar %u amostras na flash", static_cast<unsigned>(count));
+        m_lost += count;
+    }
+
+    m_ramHead = (m_ramHead + count) % SPOOL_RAM_CAPACITY;
+    m_ramCount -= count;
+}
+
+bool SampleSpool::appendRecords(const SpoolRecord *records, size_t count) {
+    size_t written = 0;
+
+    while (written < count) {
+        size_t slot = m_writePos % SLOTS_PER_SEGMENT;
+        if (slot == 0 && !prepareSegment(m_writePos / SLOTS_PER_SEGMENT)) {
+            return false;
+        }
+
+        // Grava o maior trecho contíguo dentro do setor atual
+        size_t run = count - written;
+        if (run > SLOTS_PER_SEGMENT - slot) {
+            run = SLOTS_PER_SEGMENT - slot;
+        }
+
+        if (esp_partition_write(m_partition, m_writePos * sizeof(SpoolRecord),
+                                records + written, run * sizeof(SpoolRecord)) != ESP_OK) {
+            return false;
+        }
+
+        written += run;
+        m_writePos = (m_writePos + run) % m_totalSlots;
+    }
+
+    return true;
+}
+
+bool SampleSpool::prepareSegment(size_t segment) {
+    // Log cheio: o setor a reutilizar contém as amostras mais antigas
+    if (m_flashPending > 0 && m_readPos / SLOTS_PER_SEGMENT == segment) {
+        size_t segmentEnd = (segment + 1) * SLOTS_PER_SEGMENT;
+        size_t dropped = 0;
+        SpoolRecord record;
+
+        for (size_t pos = m_readPos; pos < segmentEnd; pos++) {
+            if (readRecord(pos, record) && record.type == RECORD_DATA &&
+                record.serial > m_ackedSerial) {
+                dropped++;
+            }
+        }
+
+        m_flashPending -= dropped <= m_flashPending ? dropped : m_flashPending;
+        m_lost += dropped;
+        m_readPos = segmentEnd % m_totalSlots;
+        refreshFlashOldest();
+
+        LOG_WARN(MODULE_NAME, "Spool cheio, %u amostras antigas descartadas",
+            static_cast<unsigned>(dropped));
+    }
+
+    if (esp_partition_erase_range(m_partition, segment * SEGMENT_SIZE, SEGMENT_SIZE) != ESP_OK) {
+        LOG_ERROR(MODULE_NAME, "Falha ao apagar setor %u", static_cast<unsigned>(segment));
+        return false;
+    }
+
+    m_segmentErases++;
+    return true;
+}
+
+bool SampleSpool::readRecord(size_t pos, SpoolRecord &record) const {
+    if (esp_partition_read(m_partition, pos * sizeof(SpoolRecord), &record, sizeof(record)) != ESP_OK) {
+        return false;
+    }
+
+    if (record.type != RECORD_DATA && record.type != RECORD_ACK) {
+        return false;
+    }
+
+    // Escritas interrompidas por queda de energia falham no CRC
+    return record.crc == crc16(reinterpret_cast<const uint8_t *>(&record),
+                               offsetof(SpoolRecord, crc));
+}
+
+size_t SampleSpool::occupiedSlots() const {
+    if (m_totalSlots == 0) {
+        return 0;
+    }
+
+    size_t used = (m_writePos + m_totalSlots - m_readPos) % m_totalSlots;
+
+    // Leitura e escrita coincidem com dados pendentes: log inteiro ocupado
+    return (used == 0 && m_flashPending > 0) ? m_totalSlots : used;
+}
+
+void SampleSpool::refreshFlashOldest() {
+    size_t remaining = occupiedSlots();
+    SpoolRecord record;
+
+    while (m_flashPending > 0 && remaining > 0) {
+        if (readRecord(m_readPos, record) && record.type == RECORD_DATA &&
+            record.serial > m_ackedSerial) {
+            m_flashOldestTimestamp = record.value;
+            m_flashOldestBoot = record.boot;
+            return;
+        }
+        m_readPos = (m_readPos + 1) % m_totalSlots;
+        remaining--;
+    }
+
+    m_flashPending = 0;
+    m_readPos = m_writePos;
+}
+
+void SampleSpool::updateStats() {
+    SpoolStats stats;
+    stats.ramDepth = static_cast<uint16_t>(m_ramCount);
+    stats.flashRecords = m_flashPending;
+    stats.flashBytes = occupiedSlots() * sizeof(SpoolRecord);
+    stats.spilled = m_spilled;
+    stats.drained = m_drained;
+    stats.lost = m_lost;
+    stats.segmentErases = m_segmentErases;
+    stats.drainRate = m_drainRate;
+    stats.flashAvailable = m_partition != nullptr;
+    uint32_t oldest = oldestTimestamp();
+    bool previousBoot = m_flashPending > 0 && m_flashOldestBoot != static_cast<uint8_t>(m_bootId);
+
+    portENTER_CRITICAL(&m_statsLock);
+    m_stats = stats;
+    m_oldestTimestamp = oldest;
+    m_oldestPreviousBoot = previousBoot;
+    portEXIT_CRITICAL(&m_statsLock);
+}
+
+void SampleSpool::fillCrc(SpoolRecord &record) {
+    record.crc = crc16(reinterpret_cast<const uint8_t *>(&record), offsetof(SpoolRecord, crc));
+}
+
+uint16_t SampleSpool::crc16(const uint8_t *data, size_t length) {
+    // CRC-16/CCITT-FALSE
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
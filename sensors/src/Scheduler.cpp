@@ -0,0 +1,128 @@
+/**
+ * @file Scheduler.cpp
+ * @brief Implementação do escalonador de prazos por tarefa.
+ */
+
+#include "Scheduler.h"
+#include "LogSystem.h"
+#include <esp_timer.h>
+
+// Define o nome do módulo para logging
+#define MODULE_NAME "Scheduler"
+
+Scheduler::Scheduler(const char *name, const Metrics::TaskMetrics &metrics)
+    : m_name(name),
+    m_metrics(metrics),
+    m_task(xTaskGetCurrentTaskHandle()),
+    m_jobCount(0) {
+}
+
+int Scheduler::addJob(const char *name, uint32_t period, JobFunction function, void *context,
+                      uint32_t events, uint32_t initialDelay) {
+    if (!function || m_jobCount >= SCHEDULER_MAX_JOBS) {
+        LOG_ERROR(MODULE_NAME, "%s: job %s não registrado (máximo de %u)", m_name, name, SCHEDULER_MAX_JOBS);
+        return INVALID_JOB;
+    }
+
+    Job &job = m_jobs[m_jobCount];
+    job.name = name;
+    job.function = function;
+    job.context = context;
+    job.events = events;
+    job.periodUs = (int64_t)period * 1000;
+
+    // Jobs apenas de eventos começam dormindo, salvo atraso explícito
+    if (period == 0 && initialDelay == 0) {
+        job.deadline = NEVER;
+    } else {
+        job.deadline = esp_timer_get_time() + (int64_t)initialDelay * 1000;
+    }
+
+    LOG_DEBUG(MODULE_NAME, "%s: job %s a cada %u ms (eventos 0x%08x)", m_name, name, period, events);
+    return static_cast<int>(m_jobCount++);
+}
+
+void Scheduler::notify(uint32_t events) {
+    if (m_task != nullptr && events != 0) {
+        xTaskNotify(m_task, events, eSetBits);
+    }
+}
+
+void Scheduler::run() {
+    const int64_t tickUs = (int64_t)portTICK_PERIOD_MS * 1000;
+    int64_t next = dispatch(0);
+
+    while (true) {
+        // Arredonda para cima: acordar um tick antes do prazo desperdiça um despertar
+        TickType_t wait = portMAX_DELAY;
+        if (next != NEVER) {
+            int64_t remaining = next - esp_timer_get_time();
+            wait = remaining > 0 ? static_cast<TickType_t>((remaining + tickUs - 1) / tickUs) : 0;
+        }
+
+        uint32_t events = 0;
+        if (xTaskNotifyWait(0, 0xFFFFFFFF, &events, wait) != pdTRUE) {
+            events = 0;
+        }
+
+        next = dispatch(events);
+    }
+}
+
+int64_t Scheduler::dispatch(uint32_t events) {
+    int64_t wake = esp_timer_get_time();
+    int64_t earliest = NEVER;
+    int64_t firstDue = NEVER;
+
+    for (size_t i = 0; i < m_jobCount; i++) {
+        Job &job = m_jobs[i];
+        int64_t now = esp_timer_get_time();
+        bool due = job.deadline <= now;
+
+        if (!due && (job.events & events) == 0) {
+            if (job.deadline < earliest) {
+                earliest = job.deadline;
+            }
+            continue;
+        }
+
+        if (due && job.deadline < firstDue) {
+            firstDue = job.deadline;
+        }
+
+        uint32_t delay = job.function(job.context);
+        now = esp_timer_get_time();
+
+        if (delay == SUSPEND) {
+            job.deadline = NEVER;
+        } else if (delay != 0) {
+            job.deadline = now + (int64_t)delay * 1000;
+        } else if (job.periodUs == 0) {
+            job.deadline = NEVER;
+        } else if (due) {
+            // Sem deriva: o próximo prazo parte do anterior, não do despertar
+            job.deadline += job.periodUs;
+            if (job.deadline <= now) {
+                m_metrics.deadlineMisses.inc();
+                job.deadline = now + job.periodUs;
+            }
+        } else if (job.deadline == NEVER) {
+            // Job periódico retomado por evento
+            job.deadline = now + job.periodUs;
+        }
+
+        if (job.deadline < earliest) {
+            earliest = job.deadline;
+        }
+    }
+
+    // Atraso do despertar em relação ao prazo mais antigo que o motivou
+    if (firstDue != NEVER) {
+        m_metrics.wakeLatency.observe(wake > firstDue ? static_cast<uint32_t>(wake - firstDue) : 0);
+    }
+
+    m_metrics.wakeups.inc();
+    m_metrics.busy.observe(static_cast<uint32_t>(esp_timer_get_time() - wake));
+
+    return earliest;
+}
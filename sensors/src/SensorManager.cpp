@@ -10,20 +10,31 @@
 #include "SystemMonitor.h"
 #include "WiFiManager.h"
 #include "StringUtils.h"
+#include "Metrics.h"
+#include "CpuMonitor.h"
 
 // Define o nome do módulo para logging
 #define MODULE_NAME "SensorManager"
 
+/**
+ * Relógio padrão do estimador de tendência.
+ */
+static uint32_t uptimeMs() {
+    return millis();
+}
+
 SensorManager::SensorManager()
     : m_lastReadTime(0),
     m_lastStateCheckTime(0),
     m_readCount(0),
-    m_filterIndex(0) {
+    m_lastDhtSample(0),
+    m_lastSampleTime(0),
+    m_sampleAccepted(false),
+    m_clock(uptimeMs) {
 
-    // Inicializa arrays de filtro
-    for (uint8_t i = 0; i < FILTER_SIZE; i++) {
-        m_moistureReadings[i] = 0;
-    }
+    // Cadeias vazias: a média cobre só as leituras recebidas até encher a janela
+    m_filter.temperature.reset();
+    m_filter.humidity.reset();
 
     // Inicializa o estado dos dados processados
     m_processedData.temperature = 25.0f; // Valor padrão razoável para temperatura
@@ -42,6 +53,7 @@ bool SensorManager::init() {
     // Mas realizamos uma leitura inicial para popular os buffers
     readSensors();
     processSensorData();
+    publishSnapshot();
 
     LOG_INFO(MODULE_NAME, "Gerenciador de sensores inicializado com sucesso");
     LOG_DEBUG(MODULE_NAME, "Buffer de filtro: %u amostras", FILTER_SIZE);
@@ -49,77 +61,85 @@ bool SensorManager::init() {
     return true;
 }
 
-uint16_t SensorManager::applyFilter(uint16_t readings[], uint16_t newValue) {
-    // Atualiza o buffer circular
-    readings[m_filterIndex] = newValue;
-
-    // Calcula a média
-    uint32_t sum = 0;
-    for (uint8_t i = 0; i < FILTER_SIZE; i++) {
-        sum += readings[i];
-    }
-
-    return static_cast<uint16_t>(sum / FILTER_SIZE);
-}
-
-float SensorManager::applyFilter(float readings[], float newValue) {
-    // Implementação para valores de ponto flutuante (DHT22)
-
-    // Atualiza o buffer circular com o novo valor
-    readings[m_filterIndex] = newValue;
-
-    // Calcula a média dos valores no buffer
-    float sum = 0.0f;
-    for (uint8_t i = 0; i < FILTER_SIZE; i++) {
-        sum += readings[i];
-    }
-
-    return sum / FILTER_SIZE;
-}
-
-void SensorManager::readSensors() {
+bool SensorManager::readSensors() {
     // Atualiza contador
     m_readCount++;
+    Metrics::sensorReads.inc();
 
     // Obtém timestamp atual
     m_rawData.timestamp = millis();
 
-    // Lê o sensor DHT22 para temperatura e umidade
-    float temperature = Hardware::readTemperature();
-    float humidity = Hardware::readHumidity();
-    
-    // Aplica filtro de média móvel à temperatura e umidade do DHT22
-    // para suavizar flutuações em leituras consecutivas
-    static float tempBuffer[FILTER_SIZE] = {0.0f};
-    static float humidityBuffer[FILTER_SIZE] = {0.0f};
-
-    // Somente aplica o filtro se as leituras forem válidas
-    if (temperature > -50.0f && temperature < 100.0f) {
-        m_rawData.temperatureRaw = applyFilter(tempBuffer, temperature);
-    } else {
-        m_rawData.temperatureRaw = temperature; // Mantém o valor mesmo sendo inválido
-    }
+    // Cada aquisição do DHT22 passa uma única vez pelas cadeias; entre
+    // aquisições (DHT22_READ_INTERVAL) os canais mantêm a última saída
+    const Dht22Reader &reader = Hardware::getDHTReader();
+    const Dht22Reader::Result &result = reader.getLastResult();
+    bool accepted = false;
+
+    if (result.status == Dht22Reader::Status::OK && reader.getSuccessCount() != m_lastDhtSample) {
+        m_lastDhtSample = reader.getSuccessCount();
+        m_lastSampleTime = m_rawData.timestamp;
+
+        uint32_t now = m_clock();
+        m_filter.temperature.stage<TEMPERATURE_TREND_STAGE>().setTime(now);
+        m_filter.humidity.stage<HUMIDITY_TREND_STAGE>().setTime(now);
+
+        // Amostras descartadas por um estágio não alteram o canal
+        uint32_t temperatureOutliers = getOutlierCount(false);
+        float temperature = result.temperature;
+        bool temperatureAccepted = m_filter.temperature.process(temperature);
+        if (temperatureAccepted) {
+            m_rawData.temperatureRaw = temperature;
+        } else if (getOutlierCount(false) != temperatureOutliers) {
+            Metrics::temperatureOutliers.inc();
+            LOG_DEBUG(MODULE_NAME, "Pico de temperatura descartado: %.1f°C", result.temperature);
+        }
+
+        uint32_t humidityOutliers = getOutlierCount(true);
+        float humidity = result.humidity;
+        bool humidityAccepted = m_filter.humidity.process(humidity);
+        if (humidityAccepted) {
+            m_rawData.humidityRaw = humidity;
+        } else if (getOutlierCount(true) != humidityOutliers) {
+            Metrics::humidityOutliers.inc();
+            LOG_DEBUG(MODULE_NAME, "Pico de umidade descartado: %.1f%%", result.humidity);
+        }
 
-    if (humidity >= 0.0f && humidity <= 100.0f) {
-        m_rawData.humidityRaw = applyFilter(humidityBuffer, humidity);
-    } else {
-        m_rawData.humidityRaw = humidity; // Mantém o valor mesmo sendo inválido
+        m_sampleAccepted = temperatureAccepted && humidityAccepted;
+        accepted = m_sampleAccepted;
     }
 
-    // Avança o índice do filtro
-    m_filterIndex = (m_filterIndex + 1) % FILTER_SIZE;
+    // Resumo periódico no modo de debug; as leituras contínuas são exibidas
+    // de forma centralizada, então 10s evita poluir o console
+    static uint32_t lastSummaryTime = 0;
+    if (DEBUG_MODE && (millis() - lastSummaryTime > 10000)) {
+        LOG_INFO(MODULE_NAME, "Resumo Periódico de Sensores");
+        LOG_INFO(MODULE_NAME, "Temperatura: %.1f°C    Umidade: %.1f%%",
+            m_rawData.temperatureRaw, m_rawData.humidityRaw);
+        LOG_INFO(MODULE_NAME, "Aquisições: %u ok, %u falhas (decodificação: %u us)",
+            reader.getSuccessCount(), reader.getErrorCount(), result.decodeTimeUs);
+        lastSummaryTime = millis();
+    }
 
     // Atualiza timestamp da última leitura
     m_lastReadTime = m_rawData.timestamp;
 
     // Leituras serão exibidas de forma centralizada no método update()
     // com técnica de atualização da mesma linha
+    return accepted;
 }
 
 void SensorManager::processSensorData() {
     // Converte dados brutos para unidades físicas
     m_processedData.fromRaw(m_rawData);
 
+    // Tendência de cada canal, do estimador nas cadeias
+    const KalmanTrend<TemperatureTrendModel> &temperatureTrend = m_filter.temperature.stage<TEMPERATURE_TREND_STAGE>();
+    const KalmanTrend<HumidityTrendModel> &humidityTrend = m_filter.humidity.stage<HUMIDITY_TREND_STAGE>();
+    m_processedData.temperatureRate = temperatureTrend.rate();
+    m_processedData.temperatureRateSigma = temperatureTrend.rateSigma();
+    m_processedData.humidityRate = humidityTrend.rate();
+    m_processedData.humidityRateSigma = humidityTrend.rateSigma();
+
     // Leituras processadas serão exibidas de forma centralizada em update()
     // usando técnica de atualização na mesma linha
 }
@@ -131,6 +151,10 @@ TelemetryBuffer SensorManager::prepareTelemetry() {
     // Preenche com dados dos sensores
     telemetry.temperature = m_processedData.temperature;
     telemetry.humidity = m_processedData.humidityPercent;
+    telemetry.temperatureRate = m_processedData.temperatureRate;
+    telemetry.temperatureRateSigma = m_processedData.temperatureRateSigma;
+    telemetry.humidityRate = m_processedData.humidityRate;
+    telemetry.humidityRateSigma = m_processedData.humidityRateSigma;
 
     // Preenche estatísticas do sistema
     SystemStats stats = SystemMonitor::getInstance().getStats();
@@ -138,6 +162,11 @@ TelemetryBuffer SensorManager::prepareTelemetry() {
     telemetry.heapFragmentation = stats.heapFragmentation;
     telemetry.uptime = stats.uptime;
 
+    // Carga por núcleo do último intervalo de amostragem
+    CpuMonitor& cpuMonitor = CpuMonitor::getInstance();
+    telemetry.cpuLoad[0] = cpuMonitor.getCoreLoad(0);
+    telemetry.cpuLoad[1] = cpuMonitor.getCoreLoad(1);
+
     // Preenche dados de WiFi
     WiFiManager& wifiManager = WiFiManager::getInstance();
     telemetry.wifiRssi = wifiManager.getRSSI();
@@ -159,6 +188,24 @@ TelemetryBuffer SensorManager::prepareTelemetry() {
     return telemetry;
 }
 
+void SensorManager::publishSnapshot() {
+    SensorSnapshot snapshot;
+    snapshot.data = m_processedData;
+    snapshot.telemetry = prepareTelemetry();
+    snapshot.sampleSequence = m_lastDhtSample;
+    snapshot.sampleTime = m_lastSampleTime;
+
+    m_snapshot.write(snapshot);
+}
+
+uint32_t SensorManager::getSnapshot(SensorSnapshot &snapshot) const {
+    return m_snapshot.read(snapshot);
+}
+
+uint32_t SensorManager::getSnapshotRetryCount() const {
+    return m_snapshot.getRetryCount();
+}
+
 bool SensorManager::update(bool forceUpdate) {
     uint32_t currentTime = millis();
     static uint32_t lastDisplayUpdate = 0;
@@ -174,9 +221,10 @@ bool SensorManager::update(bool forceUpdate) {
         // Processa os dados
         processSensorData();
 
-        
-        // Não fazemos mais preparação de telemetria aqui
-        // A telemetria será solicitada pelo AsyncSoilWebServer quando necessário
+        // Publica o snapshot para os leitores do núcleo web, handlers HTTP
+        // e cliente de API, que não precisam mais do mutex de sensores
+        publishSnapshot();
+
         if (currentTime - lastDisplayUpdate >= 500) { // 2Hz é suficiente para visualização
             lastDisplayUpdate = currentTime;
         }
@@ -202,26 +250,48 @@ bool SensorManager::getDataJson(char *buffer, size_t size) const {
 }
 
 bool SensorManager::sensorChanged(uint8_t sensorType, float threshold) const {
-    static SensorData lastData;
-    static uint32_t lastCheck = 0;
+    float rate;
+    float sigma;
 
-    uint32_t currentTime = millis();
-
-    // Atualiza a referência a cada 5 segundos
-    if (currentTime - lastCheck > 5000) {
-        lastData = m_processedData;
-        lastCheck = currentTime;
-        return false;
-    }
-
-    // Verifica mudança com base no tipo de sensor
     switch (sensorType) {
-
         case 0: // Umidade
-            return fabs(m_processedData.humidityPercent - lastData.humidityPercent) >
-                threshold;
+            rate = m_processedData.humidityRate;
+            sigma = m_processedData.humidityRateSigma;
+            break;
+
+        case 1: // Temperatura
+            rate = m_processedData.temperatureRate;
+            sigma = m_processedData.temperatureRateSigma;
+            break;
 
         default:
             return false;
     }
-}
\ No newline at end of file
+
+    return fabsf(rate) > threshold && fabsf(rate) > TREND_SIGNIFICANCE * sigma;
+}
+
+uint32_t SensorManager::getOutlierCount(bool humidity) const {
+    return humidity ? m_filter.humidity.stage<OUTLIER_STAGE>().rejected()
+                    : m_filter.temperature.stage<OUTLIER_STAGE>().rejected();
+}
+
+uint32_t SensorManager::getSampleSequence() const {
+    return m_lastDhtSample;
+}
+
+bool SensorManager::isSampleAccepted() const {
+    return m_sampleAccepted;
+}
+
+void SensorManager::setClock(Clock clock) {
+    m_clock = clock;
+}
+
+void SensorManager::getFilterState(FilterState &state) const {
+    state = m_filter;
+}
+
+void SensorManager::setFilterState(const FilterState &state) {
+    m_filter = state;
+}
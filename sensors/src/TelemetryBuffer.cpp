@@ -5,15 +5,45 @@
 
 #include "TelemetryBuffer.h"
 
+// Offset e tamanho de cada campo no TelemetryFrame, na ordem dos bits da máscara
+static const struct {
+    uint8_t offset;
+    uint8_t size;
+} s_frameFields[TELEMETRY_FIELD_COUNT] = {
+    { offsetof(TelemetryFrame, clients),           2 },
+    { offsetof(TelemetryFrame, timestamp),         4 },
+    { offsetof(TelemetryFrame, readCount),         4 },
+    { offsetof(TelemetryFrame, temperature),       2 },
+    { offsetof(TelemetryFrame, humidity),          2 },
+    { offsetof(TelemetryFrame, freeHeap),          4 },
+    { offsetof(TelemetryFrame, uptime),            4 },
+    { offsetof(TelemetryFrame, ipAddress),         4 },
+    { offsetof(TelemetryFrame, heapFragmentation), 1 },
+    { offsetof(TelemetryFrame, wifiRssi),          1 },
+    { offsetof(TelemetryFrame, cpuLoad),           2 },
+    { offsetof(TelemetryFrame, temperatureRate),   8 }
+};
+
+// Converte para centésimos, saturando na faixa do campo do quadro
+static int32_t toHundredths(float value, int32_t low, int32_t high) {
+    long hundredths = lroundf(value * 100.0f);
+    return hundredths < low ? low : (hundredths > high ? high : static_cast<int32_t>(hundredths));
+}
+
 TelemetryBuffer::TelemetryBuffer()
     : temperature(0.0f),
       humidity(0.0f),
+      temperatureRate(0.0f),
+      temperatureRateSigma(0.0f),
+      humidityRate(0.0f),
+      humidityRateSigma(0.0f),
       freeHeap(0),
       heapFragmentation(0),
       uptime(0),
       wifiRssi(0),
       timestamp(0),
       readCount(0) {
+    memset(cpuLoad, 0, sizeof(cpuLoad));
     memset(ipAddress, 0, sizeof(ipAddress));
 }
 
@@ -26,6 +56,7 @@ void TelemetryBuffer::toJson(JsonObject& json) const {
     sensors["humidity"] = humidity;
     sensors["timestamp"] = timestamp;
     sensors["readCount"] = readCount;
+    trendToJson(sensors);
 
     // Adicionar estatísticas do sistema
     JsonObject stats = json.createNestedObject("stats");
@@ -34,6 +65,87 @@ void TelemetryBuffer::toJson(JsonObject& json) const {
     stats["uptime"] = uptime;
     stats["wifiRssi"] = wifiRssi;
     stats["ipAddress"] = ipAddress;
+
+    JsonArray cpu = stats.createNestedArray("cpu");
+    cpu.add(cpuLoad[0]);
+    cpu.add(cpuLoad[1]);
+}
+
+void TelemetryBuffer::trendToJson(JsonObject& sensors) const {
+    // Centésimos por minuto, como no quadro binário, para encurtar o texto
+    JsonObject trend = sensors.createNestedObject("trend");
+
+    JsonArray temperatureTrend = trend.createNestedArray("temperature");
+    temperatureTrend.add(roundf(temperatureRate * 100.0f) / 100.0f);
+    temperatureTrend.add(roundf(temperatureRateSigma * 100.0f) / 100.0f);
+
+    JsonArray humidityTrend = trend.createNestedArray("humidity");
+    humidityTrend.add(roundf(humidityRate * 100.0f) / 100.0f);
+    humidityTrend.add(roundf(humidityRateSigma * 100.0f) / 100.0f);
+}
+
+void TelemetryBuffer::toBinary(TelemetryFrame& frame, uint16_t clients) const {
+    frame.version = TELEMETRY_FRAME_VERSION;
+    frame.type = TELEMETRY_FRAME_FULL;
+    frame.clients = clients;
+    frame.timestamp = timestamp;
+    frame.readCount = readCount;
+
+    // Valores em ponto fixo (centésimos) preservam a resolução do DHT22
+    frame.temperature = static_cast<int16_t>(lroundf(temperature * 100.0f));
+    frame.humidity = static_cast<uint16_t>(lroundf(humidity * 100.0f));
+
+    // Tendências em centésimos por minuto, saturadas na faixa do campo
+    frame.temperatureRate = static_cast<int16_t>(toHundredths(temperatureRate, INT16_MIN, INT16_MAX));
+    frame.humidityRate = static_cast<int16_t>(toHundredths(humidityRate, INT16_MIN, INT16_MAX));
+    frame.temperatureRateSigma = static_cast<uint16_t>(toHundredths(temperatureRateSigma, 0, UINT16_MAX));
+    frame.humidityRateSigma = static_cast<uint16_t>(toHundredths(humidityRateSigma, 0, UINT16_MAX));
+
+    frame.freeHeap = freeHeap;
+    frame.uptime = uptime;
+    frame.heapFragmentation = static_cast<uint8_t>(heapFragmentation);
+    frame.wifiRssi = static_cast<int8_t>(static_cast<int32_t>(wifiRssi));
+    frame.cpuLoad[0] = cpuLoad[0];
+    frame.cpuLoad[1] = cpuLoad[1];
+
+    // Converte o IP em texto para 4 octetos
+    unsigned int octets[4] = {0, 0, 0, 0};
+    sscanf(ipAddress, "%u.%u.%u.%u", &octets[0], &octets[1], &octets[2], &octets[3]);
+    for (int i = 0; i < 4; i++) {
+        frame.ipAddress[i] = static_cast<uint8_t>(octets[i]);
+    }
+}
+
+size_t TelemetryBuffer::toBinaryDelta(uint8_t* buffer, uint16_t fields, uint16_t clients) const {
+    TelemetryFrame frame;
+    toBinary(frame, clients);
+    const uint8_t* source = reinterpret_cast<const uint8_t*>(&frame);
+
+    // Cabeçalho: versão, tipo e máscara (little-endian)
+    buffer[0] = TELEMETRY_FRAME_VERSION;
+    buffer[1] = TELEMETRY_FRAME_DELTA;
+    buffer[2] = static_cast<uint8_t>(fields & 0xFF);
+    buffer[3] = static_cast<uint8_t>(fields >> 8);
+
+    size_t length = 4;
+    for (uint8_t i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        if (fields & (1u << i)) {
+            memcpy(buffer + length, source + s_frameFields[i].offset, s_frameFields[i].size);
+            length += s_frameFields[i].size;
+        }
+    }
+
+    return length;
+}
+
+size_t TelemetryBuffer::binaryDeltaSize(uint16_t fields) {
+    size_t length = 4;
+    for (uint8_t i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        if (fields & (1u << i)) {
+            length += s_frameFields[i].size;
+        }
+    }
+    return length;
 }
 
 char* TelemetryBuffer::toConsoleString(char* buffer, size_t bufferSize, TelemetryType type) const {
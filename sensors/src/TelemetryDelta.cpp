@@ -0,0 +1,98 @@
+/**
+ * @file TelemetryDelta.cpp
+ * @brief Implementação do rastreamento de campos alterados.
+ */
+
+#include "TelemetryDelta.h"
+
+TelemetryDelta::TelemetryDelta()
+    : m_clients(0),
+    m_lastKeyframe(0),
+    m_valid(false) {
+}
+
+uint16_t TelemetryDelta::compute(const TelemetryBuffer &data, uint16_t clients, uint32_t now) const {
+    if (!m_valid || now - m_lastKeyframe >= TELEMETRY_KEYFRAME_INTERVAL) {
+        return TELEMETRY_FIELDS_ALL;
+    }
+
+    uint16_t fields = 0;
+
+    if (fabsf(data.temperature - m_reference.temperature) >= TELEMETRY_DEADBAND_TEMPERATURE) {
+        fields |= TELEMETRY_FIELD_TEMPERATURE;
+    }
+    if (fabsf(data.humidity - m_reference.humidity) >= TELEMETRY_DEADBAND_HUMIDITY) {
+        fields |= TELEMETRY_FIELD_HUMIDITY;
+    }
+
+    if (fabsf(data.temperatureRate - m_reference.temperatureRate) >= TELEMETRY_DEADBAND_RATE ||
+        fabsf(data.humidityRate - m_reference.humidityRate) >= TELEMETRY_DEADBAND_RATE) {
+        fields |= TELEMETRY_FIELD_TREND;
+    }
+
+    uint32_t heapDelta = data.freeHeap > m_reference.freeHeap
+        ? data.freeHeap - m_reference.freeHeap
+        : m_reference.freeHeap - data.freeHeap;
+    if (heapDelta >= TELEMETRY_DEADBAND_HEAP) {
+        fields |= TELEMETRY_FIELD_FREE_HEAP;
+    }
+
+    if (abs(static_cast<int>(data.heapFragmentation) - m_reference.heapFragmentation) >= TELEMETRY_DEADBAND_FRAGMENTATION) {
+        fields |= TELEMETRY_FIELD_FRAGMENTATION;
+    }
+
+    // RSSI é armazenado como uint32_t, mas representa um valor negativo em dBm
+    int32_t rssiDelta = static_cast<int32_t>(data.wifiRssi) - static_cast<int32_t>(m_reference.wifiRssi);
+    if (abs(rssiDelta) >= TELEMETRY_DEADBAND_RSSI) {
+        fields |= TELEMETRY_FIELD_WIFI_RSSI;
+    }
+
+    if (abs(static_cast<int>(data.cpuLoad[0]) - m_reference.cpuLoad[0]) >= TELEMETRY_DEADBAND_CPU ||
+        abs(static_cast<int>(data.cpuLoad[1]) - m_reference.cpuLoad[1]) >= TELEMETRY_DEADBAND_CPU) {
+        fields |= TELEMETRY_FIELD_CPU_LOAD;
+    }
+
+    if (clients != m_clients) {
+        fields |= TELEMETRY_FIELD_CLIENTS;
+    }
+    if (strcmp(data.ipAddress, m_reference.ipAddress) != 0) {
+        fields |= TELEMETRY_FIELD_IP_ADDRESS;
+    }
+
+    // Carimbo de tempo e contador acompanham qualquer delta
+    if (fields != 0) {
+        fields |= TELEMETRY_FIELD_TIMESTAMP | TELEMETRY_FIELD_READ_COUNT;
+    }
+
+    return fields;
+}
+
+void TelemetryDelta::commit(const TelemetryBuffer &data, uint16_t clients, uint16_t fields, uint32_t now) {
+    if (fields == TELEMETRY_FIELDS_ALL) {
+        m_reference = data;
+        m_clients = clients;
+        m_lastKeyframe = now;
+        m_valid = true;
+        return;
+    }
+
+    if (fields & TELEMETRY_FIELD_CLIENTS) m_clients = clients;
+    if (fields & TELEMETRY_FIELD_TIMESTAMP) m_reference.timestamp = data.timestamp;
+    if (fields & TELEMETRY_FIELD_READ_COUNT) m_reference.readCount = data.readCount;
+    if (fields & TELEMETRY_FIELD_TEMPERATURE) m_reference.temperature = data.temperature;
+    if (fields & TELEMETRY_FIELD_HUMIDITY) m_reference.humidity = data.humidity;
+    if (fields & TELEMETRY_FIELD_TREND) {
+        m_reference.temperatureRate = data.temperatureRate;
+        m_reference.temperatureRateSigma = data.temperatureRateSigma;
+        m_reference.humidityRate = data.humidityRate;
+        m_reference.humidityRateSigma = data.humidityRateSigma;
+    }
+    if (fields & TELEMETRY_FIELD_FREE_HEAP) m_reference.freeHeap = data.freeHeap;
+    if (fields & TELEMETRY_FIELD_UPTIME) m_reference.uptime = data.uptime;
+    if (fields & TELEMETRY_FIELD_FRAGMENTATION) m_reference.heapFragmentation = data.heapFragmentation;
+    if (fields & TELEMETRY_FIELD_WIFI_RSSI) m_reference.wifiRssi = data.wifiRssi;
+    if (fields & TELEMETRY_FIELD_CPU_LOAD) memcpy(m_reference.cpuLoad, data.cpuLoad, sizeof(data.cpuLoad));
+    if (fields & TELEMETRY_FIELD_IP_ADDRESS) {
+        StringUtils::safeCopyString(m_reference.ipAddress, data.ipAddress, sizeof(m_reference.ipAddress));
+    }
+}
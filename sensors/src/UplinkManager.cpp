@@ -0,0 +1,371 @@
+/**
+ * @file UplinkManager.cpp
+ * @brief Implementação da tarefa de envio para a API.
+ */
+
+#include "UplinkManager.h"
+#include "LogSystem.h"
+#include "Metrics.h"
+
+// Nome do módulo para logs
+#define MODULE_NAME "Uplink"
+
+UplinkManager::UplinkManager(ApiClient &apiClient, OverflowPolicy policy)
+    : m_apiClient(apiClient),
+    m_policy(policy),
+    m_queue(nullptr),
+    m_alertQueue(nullptr),
+    m_task(nullptr),
+    m_statsLock(portMUX_INITIALIZER_UNLOCKED),
+    m_nextAttempt(0),
+    m_alertHead(0),
+    m_alertCount(0),
+    m_nextAlertAttempt(0) {
+}
+
+bool UplinkManager::begin() {
+    // Recupera amostras não confirmadas antes do último reinício
+    m_spool.begin();
+
+    m_queue = xQueueCreate(UPLINK_QUEUE_LENGTH, sizeof(SensorData));
+    if (m_queue == nullptr) {
+        LOG_ERROR(MODULE_NAME, "Falha ao criar fila de envio");
+        return false;
+    }
+
+    m_alertQueue = xQueueCreate(UPLINK_ALERT_QUEUE_LENGTH, sizeof(AlertEvent));
+    if (m_alertQueue == nullptr) {
+        LOG_ERROR(MODULE_NAME, "Falha ao criar fila de alertas");
+        return false;
+    }
+
+    // Tarefa fixada no núcleo web, longe da aquisição (core 0)
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunc,
+        "UplinkTask",
+        TASK_STACK_SIZE_UPLINK,
+        this,
+        TASK_PRIORITY_UPLINK,
+        &m_task,
+        TASK_UPLINK_CORE
+    );
+
+    if (result != pdPASS) {
+        LOG_ERROR(MODULE_NAME, "Falha ao criar tarefa de envio");
+        return false;
+    }
+
+    LOG_INFO(MODULE_NAME, "Fila de envio: %u amostras, política %s",
+        UPLINK_QUEUE_LENGTH,
+        m_policy == OverflowPolicy::DROP_OLDEST ? "descartar mais antiga" : "descartar mais nova");
+
+    if (API_BATCH_MODE) {
+        LOG_INFO(MODULE_NAME, "Envio em lote: até %u amostras ou %u ms",
+            API_BATCH_MAX_SAMPLES, API_BATCH_MAX_AGE);
+    }
+
+    return true;
+}
+
+bool UplinkManager::enqueue(const SensorData &data) {
+    if (m_queue == nullptr) {
+        return false;
+    }
+
+    uint32_t start = micros();
+    bool accepted = xQueueSend(m_queue, &data, 0) == pdTRUE;
+    bool dropped = false;
+
+    if (!accepted) {
+        dropped = true;
+        if (m_policy == OverflowPolicy::DROP_OLDEST) {
+            // Remove a amostra mais antiga e tenta novamente
+            SensorData oldest;
+            xQueueReceive(m_queue, &oldest, 0);
+            accepted = xQueueSend(m_queue, &data, 0) == pdTRUE;
+        }
+    }
+
+    uint32_t elapsed = micros() - start;
+    uint16_t depth = static_cast<uint16_t>(uxQueueMessagesWaiting(m_queue));
+
+    portENTER_CRITICAL(&m_statsLock);
+    if (accepted) {
+        m_stats.enqueued++;
+    }
+    if (dropped) {
+        m_stats.dropped++;
+    }
+    m_stats.queueDepth = depth;
+    if (depth > m_stats.queueHighWater) {
+        m_stats.queueHighWater = depth;
+    }
+    m_stats.lastEnqueueUs = elapsed;
+    if (elapsed > m_stats.maxEnqueueUs) {
+        m_stats.maxEnqueueUs = elapsed;
+    }
+    portEXIT_CRITICAL(&m_statsLock);
+
+    if (dropped) {
+        Metrics::uplinkSamplesDropped.inc();
+    }
+
+    // Acorda a tarefa de envio
+    if (accepted && m_task != nullptr) {
+        xTaskNotifyGive(m_task);
+    }
+
+    if (dropped && DEBUG_MODE) {
+        LOG_DEBUG(MODULE_NAME, "Fila cheia, amostra descartada (%u descartes)", m_stats.dropped);
+    }
+
+    return accepted;
+}
+
+bool UplinkManager::enqueueAlert(const AlertEvent &event) {
+    if (m_alertQueue == nullptr) {
+        return false;
+    }
+
+    // Fila cheia só com a tarefa presa em um envio: descarta o alerta novo
+    bool accepted = xQueueSend(m_alertQueue, &event, 0) == pdTRUE;
+    if (!accepted) {
+        portENTER_CRITICAL(&m_statsLock);
+        m_stats.alertsDropped++;
+        portEXIT_CRITICAL(&m_statsLock);
+        Metrics::uplinkAlertsDropped.inc();
+        LOG_WARN(MODULE_NAME, "Fila de alertas cheia, alerta %s descartado", event.name);
+    }
+
+    if (m_task != nullptr) {
+        xTaskNotifyGive(m_task);
+    }
+
+    return accepted;
+}
+
+UplinkStats UplinkManager::getStats() const {
+    portENTER_CRITICAL(&m_statsLock);
+    UplinkStats stats = m_stats;
+    portEXIT_CRITICAL(&m_statsLock);
+    return stats;
+}
+
+SpoolStats UplinkManager::getSpoolStats() const {
+    return m_spool.getStats();
+}
+
+void UplinkManager::taskFunc(void *pvParameters) {
+    static_cast<UplinkManager *>(pvParameters)->run();
+}
+
+void UplinkManager::run() {
+    LOG_DEBUG(MODULE_NAME, "Tarefa de envio iniciada (Core %d)", xPortGetCoreID());
+
+    while (true) {
+        // Aguarda uma amostra ou alerta sem consumir CPU (ou até o próximo envio)
+        ulTaskNotifyTake(pdTRUE, waitTicks(millis()));
+        receive();
+
+        // Alertas primeiro: não esperam o lote nem o intervalo de envio
+        uint32_t now = millis();
+        if (m_alertCount > 0 && static_cast<int32_t>(now - m_nextAlertAttempt) >= 0) {
+            sendAlerts(now);
+        }
+
+        now = millis();
+        if (drainDue(now)) {
+            drain(now);
+        }
+    }
+}
+
+void UplinkManager::receive() {
+    AlertEvent event;
+    while (xQueueReceive(m_alertQueue, &event, 0) == pdTRUE) {
+        if (m_alertCount == UPLINK_ALERT_QUEUE_LENGTH) {
+            // Sem conexão por muito tempo: descarta o alerta mais antigo
+            m_alertHead = (m_alertHead + 1) % UPLINK_ALERT_QUEUE_LENGTH;
+            m_alertCount--;
+
+            portENTER_CRITICAL(&m_statsLock);
+            m_stats.alertsDropped++;
+            portEXIT_CRITICAL(&m_statsLock);
+            Metrics::uplinkAlertsDropped.inc();
+        }
+
+        m_alerts[(m_alertHead + m_alertCount) % UPLINK_ALERT_QUEUE_LENGTH] = event;
+        m_alertCount++;
+    }
+
+    SensorData data;
+    while (xQueueReceive(m_queue, &data, 0) == pdTRUE) {
+        m_spool.push(data);
+    }
+}
+
+void UplinkManager::sendAlerts(uint32_t now) {
+    // Sem conexão os alertas permanecem pendentes
+    if (WiFi.status() != WL_CONNECTED) {
+        m_nextAlertAttempt = now + SPOOL_OFFLINE_POLL;
+        return;
+    }
+
+    while (m_alertCount > 0) {
+        uint32_t start = millis();
+        int httpCode = m_apiClient.sendAlert(m_alerts[m_alertHead]);
+        uint32_t elapsed = millis() - start;
+        bool success = ApiClient::isSuccess(httpCode);
+
+        // Um alerta recusado pela API (4xx) ou impossível de montar seria
+        // reenviado para sempre
+        bool retry = !success && ApiClient::isRetryable(httpCode);
+
+        portENTER_CRITICAL(&m_statsLock);
+        if (success) {
+            m_stats.sent++;
+            m_stats.alertsSent++;
+        } else {
+            m_stats.failed++;
+            if (!retry) {
+                m_stats.alertsDropped++;
+            }
+        }
+        m_stats.lastSendMs = elapsed;
+        portEXIT_CRITICAL(&m_statsLock);
+
+        if (success) {
+            Metrics::uplinkRequestsOk.inc();
+        } else {
+            Metrics::uplinkRequestsFailed.inc();
+        }
+        Metrics::uplinkRequestDuration.observe(elapsed);
+
+        if (retry) {
+            // Mantém o alerta e tenta novamente mais tarde
+            m_nextAlertAttempt = millis() + SPOOL_RETRY_INTERVAL;
+            return;
+        }
+
+        if (!success) {
+            Metrics::uplinkAlertsDropped.inc();
+            LOG_WARN(MODULE_NAME, "Alerta %s recusado (%d), descartado",
+                m_alerts[m_alertHead].name, httpCode);
+        }
+
+        m_alertHead = (m_alertHead + 1) % UPLINK_ALERT_QUEUE_LENGTH;
+        m_alertCount--;
+    }
+}
+
+bool UplinkManager::drainDue(uint32_t now) const {
+    if (m_spool.pending() == 0 || static_cast<int32_t>(now - m_nextAttempt) < 0) {
+        return false;
+    }
+
+    if (!API_BATCH_MODE || m_spool.flashPending() > 0 ||
+        m_spool.pending() >= API_BATCH_MAX_SAMPLES) {
+        return true;
+    }
+
+    // Lote parcial: envia quando a amostra mais antiga expira
+    return now - m_spool.oldestTimestamp() >= API_BATCH_MAX_AGE;
+}
+
+TickType_t UplinkManager::waitTicks(uint32_t now) const {
+    if (m_spool.pending() == 0 && m_alertCount == 0) {
+        return portMAX_DELAY;
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        return pdMS_TO_TICKS(SPOOL_OFFLINE_POLL);
+    }
+
+    uint32_t due = m_nextAlertAttempt;
+    if (m_spool.pending() > 0) {
+        uint32_t drainAt = m_nextAttempt;
+        if (API_BATCH_MODE && m_spool.flashPending() == 0 &&
+            m_spool.pending() < API_BATCH_MAX_SAMPLES) {
+            uint32_t expiry = m_spool.oldestTimestamp() + API_BATCH_MAX_AGE;
+            if (static_cast<int32_t>(expiry - drainAt) > 0) {
+                drainAt = expiry;
+            }
+        }
+
+        // O prazo mais próximo entre o próximo lote e o próximo alerta
+        if (m_alertCount == 0 || static_cast<int32_t>(drainAt - due) < 0) {
+            due = drainAt;
+        }
+    }
+
+    int32_t remaining = static_cast<int32_t>(due - now);
+    return remaining > 0 ? pdMS_TO_TICKS(remaining) : 0;
+}
+
+void UplinkManager::drain(uint32_t now) {
+    // Sem conexão as amostras permanecem no spool
+    if (WiFi.status() != WL_CONNECTED) {
+        m_nextAttempt = now + SPOOL_OFFLINE_POLL;
+        return;
+    }
+
+    size_t count = m_spool.peek(m_batch, API_BATCH_MODE ? API_BATCH_MAX_SAMPLES : 1);
+    if (count == 0) {
+        return;
+    }
+
+    uint32_t start = millis();
+    int httpCode = API_BATCH_MODE
+        ? m_apiClient.sendBatch(m_batch, count, m_spool.peekBoot())
+        : m_apiClient.sendData(m_batch[0], m_spool.peekBoot());
+    bool success = ApiClient::isSuccess(httpCode);
+    recordSend(success, count, millis() - start);
+
+    if (success) {
+        m_spool.ack();
+    } else if (ApiClient::isRetryable(httpCode)) {
+        // Mantém o lote no spool e tenta novamente mais tarde
+        m_nextAttempt = millis() + SPOOL_RETRY_INTERVAL;
+        return;
+    } else {
+        // Lote recusado pela API (4xx) ou impossível de montar: reenviá-lo
+        // bloquearia todas as amostras seguintes
+        m_spool.discard();
+        LOG_WARN(MODULE_NAME, "Lote de %u amostras recusado (%d), descartado",
+            static_cast<unsigned>(count), httpCode);
+    }
+
+    // Com acúmulo pendente, limita a taxa de drenagem
+    bool backlog = m_spool.flashPending() > 0 || m_spool.pending() >= API_BATCH_MAX_SAMPLES;
+    m_nextAttempt = backlog ? millis() + SPOOL_DRAIN_INTERVAL : millis();
+
+    if (backlog) {
+        SpoolStats spool = m_spool.getStats();
+        LOG_DEBUG(MODULE_NAME, "Drenando spool: %u na RAM, %u na flash (%u bytes), %.1f amostras/s",
+            spool.ramDepth, spool.flashRecords, spool.flashBytes, spool.drainRate);
+    }
+}
+
+void UplinkManager::recordSend(bool success, size_t samples, uint32_t elapsed) {
+    uint16_t depth = static_cast<uint16_t>(uxQueueMessagesWaiting(m_queue));
+
+    portENTER_CRITICAL(&m_statsLock);
+    if (success) {
+        m_stats.sent++;
+        m_stats.samplesSent += samples;
+    } else {
+        m_stats.failed++;
+    }
+    m_stats.lastBatchSize = static_cast<uint16_t>(samples);
+    m_stats.lastSendMs = elapsed;
+    m_stats.queueDepth = depth;
+    portEXIT_CRITICAL(&m_statsLock);
+
+    if (success) {
+        Metrics::uplinkRequestsOk.inc();
+        Metrics::uplinkSamplesSent.inc(samples);
+    } else {
+        Metrics::uplinkRequestsFailed.inc();
+    }
+    Metrics::uplinkRequestDuration.observe(elapsed);
+}
@@ -134,8 +134,9 @@ bool WiFiManager::connect(const char *ssid, const char *password) {
     // Configura o modo de operação
     WiFi.mode(WIFI_STA);
 
-    // Desativa o modo de economia de energia para menor latência
-    WiFi.setSleep(false);
+    // Economia de energia do modem apenas com light sleep automático;
+    // caso contrário, menor latência
+    WiFi.setSleep(POWER_LIGHT_SLEEP);
 
     // Registra handlers de eventos WiFi
     WiFi.onEvent(WiFiEventHandler);
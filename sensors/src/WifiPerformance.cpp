@@ -78,7 +78,7 @@ bool WifiPerformanceInitializer::begin() {
     // Configuração básica, evita operações potencialmente instáveis
     WiFi.persistent(false);
     WiFi.mode(WIFI_STA);
-    WiFi.setSleep(false);
+    WiFi.setSleep(POWER_LIGHT_SLEEP);   // O light sleep automático exige o modem sleep
 
     // Registra o handler de eventos APÓS a configuração básica
     // e antes de iniciar a conexão
@@ -17,6 +17,17 @@
 #include "LogSystem.h"
 #include "OutputManager.h"
 #include "ApiClient.h"
+#include "UplinkManager.h"
+#include "Metrics.h"
+#include "CpuMonitor.h"
+#include "Scheduler.h"
+#include "FieldMode.h"
+#include "AlertEngine.h"
+#include "RuleStore.h"
+
+#ifdef CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
 
 // Define o nome do módulo para logging
 #define MODULE_NAME "Main"
@@ -25,6 +36,7 @@
 SensorManager *g_sensorManager = nullptr;
 AsyncSoilWebServer *g_webServer = nullptr;
 ApiClient *g_apiClient = nullptr;
+UplinkManager *g_uplinkManager = nullptr;
 
 // Tarefas FreeRTOS
 TaskHandle_t g_sensorTask = nullptr;
@@ -89,113 +101,289 @@ void wifiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info) {
     }
 }
 
+// Eventos da tarefa web (bits da notificação)
+static const uint32_t WEB_EVENT_ALERT = 1u << 0;    // Alerta registrado por queueAlert()
+static const uint32_t WEB_EVENT_CLIENT = 1u << 1;   // Novo cliente WebSocket
+
+/**
+ * Cadência de envio das leituras para a UplinkTask.
+ */
+struct UplinkCadence {
+    uint32_t lastApiSendTime;       // Último enfileiramento fora do modo lote (ms)
+    uint32_t batchSampleCounter;    // Leituras desde o último enfileiramento em lote
+};
+
+/**
+ * Estado do job de amostragem.
+ */
+struct SampleContext {
+    UplinkCadence cadence;
+    AlertEngine *alerts;            // Avaliado a cada amostra nova do DHT22
+    uint32_t lastSample;            // Sequência da última amostra avaliada
+    uint32_t rulesSequence;         // Publicação do RuleStore carregada no motor
+};
+
+// Módulo dos alertas no log e no painel
+static const char *ALERT_MODULE = "Alertas";
+
+/**
+ * Publica uma transição de alerta no painel, no log e na API.
+ *
+ * Chamado pela tarefa de sensores dentro de AlertEngine::evaluate():
+ * queueAlert() e enqueueAlert() não bloqueiam e acordam as tarefas web
+ * e de envio, então o alerta sai sem esperar o broadcast nem o
+ * API_SEND_INTERVAL.
+ */
+static void onAlert(const AlertEvent &event, void *context) {
+    char message[128];
+    AlertEngine::describe(event, message, sizeof(message));
+
+    if (event.active) {
+        Metrics::alertsRaised.inc();
+        Metrics::alertsActive.add(1);
+        ALERT(ALERT_MODULE, "%s", message);
+    } else {
+        Metrics::alertsCleared.inc();
+        Metrics::alertsActive.add(-1);
+        LOG_INFO(ALERT_MODULE, "%s", message);
+        if (g_webServer != nullptr) {
+            g_webServer->queueAlert(ALERT_MODULE, LogLevel::INFO, message);
+        }
+    }
+
+    if (g_uplinkManager != nullptr) {
+        g_uplinkManager->enqueueAlert(event);
+    }
+}
+
+/**
+ * Job do DHT22: avança a transação e volta quando houver trabalho.
+ *
+ * O leitor só é acessado por esta tarefa e pelo callback do seu
+ * esp_timer, portanto não precisa de g_sensorMutex.
+ */
+static uint32_t dhtJob(void *context) {
+    Hardware::pollDHT();
+    return Hardware::getDHTPollDelay();
+}
+
+/**
+ * Job de amostragem: lê os sensores, publica o snapshot, avalia os alertas
+ * e alimenta a fila de envio.
+ */
+static uint32_t sampleJob(void *context) {
+    SampleContext *sample = static_cast<SampleContext *>(context);
+    UplinkCadence *cadence = &sample->cadence;
+
+    bool locked = false;
+    if (g_sensorMutex != nullptr) {
+        uint32_t waitStart = micros();
+        locked = xSemaphoreTake(g_sensorMutex, pdMS_TO_TICKS(50)) == pdTRUE;
+        Metrics::sensorMutexWait.observe(micros() - waitStart);
+        if (!locked) {
+            Metrics::sensorMutexTimeouts.inc();
+        }
+    }
+
+    if (!locked) {
+        return 0;
+    }
+
+    // O período do job já é SENSOR_CHECK_INTERVAL: força a leitura
+    bool dataUpdated = g_sensorManager->update(true);
+
+    // Regras configuradas novas: troca o bytecode antes da próxima avaliação
+    RuleStore &rules = RuleStore::getInstance();
+    if (rules.getSequence() != sample->rulesSequence) {
+        static RuleSet ruleSet;  // Fora da pilha da tarefa
+        sample->rulesSequence = rules.read(ruleSet);
+        sample->alerts->setScripts(ruleSet, millis());
+    }
+
+    // Regras avaliadas uma vez por aquisição, com estado incremental
+    uint32_t sequence = g_sensorManager->getSampleSequence();
+    if (sequence != sample->lastSample) {
+        sample->lastSample = sequence;
+        uint32_t evaluateStart = micros();
+        sample->alerts->evaluate(g_sensorManager->getData(), millis());
+        Metrics::alertEvaluation.observe(micros() - evaluateStart);
+    }
+
+    // Se os dados foram atualizados, enfileiramos para a tarefa de envio.
+    // O POST HTTP acontece na UplinkTask, fora desta seção crítica
+    // Em modo lote, enfileira uma a cada API_BATCH_DECIMATION leituras e
+    // deixa a UplinkTask agrupar; caso contrário, uma por API_SEND_INTERVAL
+    if (dataUpdated) {
+        uint32_t currentTime = millis();
+        bool shouldEnqueue = API_BATCH_MODE
+            ? (++cadence->batchSampleCounter >= API_BATCH_DECIMATION)
+            : (currentTime - cadence->lastApiSendTime > API_SEND_INTERVAL);
+
+        if (g_uplinkManager != nullptr && shouldEnqueue) {
+            // Pega o snapshot mais recente publicado pelo sensor manager
+            SensorSnapshot snapshot;
+            g_sensorManager->getSnapshot(snapshot);
+
+            // Enfileira sem bloquear
+            g_uplinkManager->enqueue(snapshot.data);
+
+            // Atualiza o tempo do último envio
+            cadence->lastApiSendTime = currentTime;
+            cadence->batchSampleCounter = 0;
+        }
+    }
+
+    xSemaphoreGive(g_sensorMutex);
+    return 0;
+}
+
+/**
+ * Job do monitor do sistema (watchdog e estatísticas).
+ */
+static uint32_t monitorJob(void *context) {
+    SystemMonitor::getInstance().update();
+    return 0;
+}
+
+/**
+ * Job de broadcast da telemetria; sem clientes, dorme até uma conexão.
+ */
+static uint32_t broadcastJob(void *context) {
+    g_webServer->broadcastTelemetry();
+    return g_webServer->getClientCount() > 0 ? 0 : Scheduler::SUSPEND;
+}
+
+/**
+ * Job de alertas; com clientes atrasados tenta de novo em breve.
+ */
+static uint32_t alertJob(void *context) {
+    return g_webServer->updateAlerts() ? WS_ALERT_RETRY_INTERVAL : Scheduler::SUSPEND;
+}
+
+/**
+ * Job de limpeza dos clientes WebSocket inativos.
+ */
+static uint32_t cleanupJob(void *context) {
+    g_webServer->cleanClients();
+    return 0;
+}
+
+/**
+ * Job de verificação da conexão WiFi.
+ */
+static uint32_t wifiJob(void *context) {
+    WiFiManager::getInstance().update();
+    return 0;
+}
+
+/**
+ * Job de amostragem da carga por núcleo e por tarefa.
+ */
+static uint32_t cpuJob(void *context) {
+    CpuMonitor::getInstance().update();
+    return 0;
+}
+
+/**
+ * Job de impressão das estatísticas de memória.
+ */
+static uint32_t memoryStatsJob(void *context) {
+    MemoryManager::getInstance().printStats();
+    return 0;
+}
+
 /**
  * Tarefa responsável pela leitura dos sensores.
  *
  * Executa no core 0 com prioridade alta para garantir leituras consistentes.
+ * Dorme até o próximo prazo do DHT22, da amostragem ou do monitor.
  *
  * @param pvParameters Parâmetros da tarefa (não utilizados).
  */
 void sensorTaskFunc(void *pvParameters) {
-    const TickType_t xFrequency = pdMS_TO_TICKS(10); // 100Hz
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-
-    // Variável para controlar o envio para a API
-    uint32_t lastApiSendTime = 0; 
+    // Estáticos: fora da pilha da tarefa, construídos já nesta tarefa
+    static Scheduler scheduler("SensorTask", Metrics::sensorTask);
+    static AlertEngine alerts;
+    static SampleContext sample = { { 0, 0 }, &alerts, 0, 0 };
 
     LOG_DEBUG(MODULE_NAME, "Tarefa de sensores iniciada (Core %d)", xPortGetCoreID());
 
     // Espera para garantir que todas as inicializações foram concluídas
     vTaskDelay(pdMS_TO_TICKS(200));
 
-    while (true) {
-        // Atualiza sensores
-        if (g_sensorMutex != nullptr &&
-            xSemaphoreTake(g_sensorMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-            
-            // A função update do SensorManager agora retorna true se os dados mudaram
-            bool dataUpdated = g_sensorManager->update();
-
-            // Se os dados foram atualizados, tentamos enviar para a API
-            if (dataUpdated) {
-                uint32_t currentTime = millis();
-                if (g_apiClient != nullptr && (currentTime - lastApiSendTime > API_SEND_INTERVAL)) {
-                    // Pega os dados mais recentes do sensor manager
-                    const SensorData& currentData = g_sensorManager->getData();
-                    
-                    // Envia os dados
-                    g_apiClient->sendData(currentData);
-                    
-                    // Atualiza o tempo do último envio
-                    lastApiSendTime = currentTime;
-                }
-            }
-            
-            xSemaphoreGive(g_sensorMutex);
-        }
-
-        // Atualiza monitor do sistema
-        SystemMonitor::getInstance().update();
+    alerts.setListener(onAlert);
 
-        // Executa no intervalo definido (preciso)
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+    scheduler.addJob("dht22", 0, dhtJob, nullptr, 0, 1);
+    scheduler.addJob("sample", SENSOR_CHECK_INTERVAL, sampleJob, &sample);
+    scheduler.addJob("monitor", SYSTEM_MONITOR_INTERVAL, monitorJob);
 
-        #if defined(WOKWI_ENV) || defined(WOKWI)
-            // No Wokwi, adicionamos um pequeno delay adicional para
-            // evitar sobrecarga do simulador
-            vTaskDelay(pdMS_TO_TICKS(5));
-        #endif
-    }
+    scheduler.run();
 }
 
 /**
  * Tarefa responsável pela interface web.
  *
  * Executa no core 1 para não interferir com a leitura dos sensores.
+ * Dorme até o próximo prazo ou até um alerta ou nova conexão.
  *
  * @param pvParameters Parâmetros da tarefa (não utilizados).
  */
 void webTaskFunc(void *pvParameters) {
-    const TickType_t xFrequency = pdMS_TO_TICKS(10); // 100Hz
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    uint32_t counter = 0;
+    // Estático: fora da pilha da tarefa, construído já nesta tarefa
+    static Scheduler scheduler("WebTask", Metrics::webTask);
 
     LOG_DEBUG(MODULE_NAME, "Tarefa web iniciada (Core %d)", xPortGetCoreID());
 
     // Espera para garantir que todas as inicializações foram concluídas
     vTaskDelay(pdMS_TO_TICKS(500));
 
-    while (true) {
-        // Atualiza interface web
-        if (g_sensorMutex != nullptr &&
-            xSemaphoreTake(g_sensorMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-            g_webServer->update();
-            xSemaphoreGive(g_sensorMutex);
-        }
+    // Os dados vêm do snapshot publicado pela tarefa de sensores,
+    // portanto nenhum job adquire g_sensorMutex
+    g_webServer->attachScheduler(&scheduler, WEB_EVENT_ALERT, WEB_EVENT_CLIENT);
 
-        // Verifica conexão WiFi periodicamente
-        if (counter % 100 == 0) { // A cada 1 segundo
-            WiFiManager::getInstance().update();
-        }
+    scheduler.addJob("broadcast", WS_BROADCAST_INTERVAL, broadcastJob, nullptr, WEB_EVENT_CLIENT);
+    scheduler.addJob("alerts", 0, alertJob, nullptr, WEB_EVENT_ALERT, 1);
+    scheduler.addJob("cleanup", WS_CLEANUP_INTERVAL, cleanupJob, nullptr, 0, WS_CLEANUP_INTERVAL);
+    scheduler.addJob("wifi", WIFI_CHECK_INTERVAL, wifiJob);
 
-        // Imprime estatísticas de memória a cada 10 segundos
-        if (counter % 1000 == 0) { // A cada 10 segundos
-            if (DEBUG_MEMORY) {
-                MemoryManager::getInstance().printStats();
-            }
-        }
+    // Carga por núcleo e por tarefa, fora do núcleo de aquisição
+    scheduler.addJob("cpu", CPU_SAMPLE_INTERVAL, cpuJob);
 
-        counter++;
+    if (DEBUG_MEMORY) {
+        scheduler.addJob("memory", MEMORY_STATS_INTERVAL, memoryStatsJob);
+    }
 
-        // Executa no intervalo definido (preciso)
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+    scheduler.run();
+}
 
-        #if defined(WOKWI_ENV) || defined(WOKWI)
-            // No Wokwi, adicionamos um pequeno delay adicional para
-            // evitar sobrecarga do simulador
-            vTaskDelay(pdMS_TO_TICKS(5));
-        #endif
+/**
+ * Habilita o light sleep automático entre os despertares das tarefas.
+ *
+ * Com POWER_LIGHT_SLEEP, o escalonamento dinâmico de frequência e o
+ * tickless idle do FreeRTOS deixam o chip em light sleep enquanto todas
+ * as tarefas aguardam seus prazos. Requer CONFIG_PM_ENABLE e
+ * CONFIG_FREERTOS_USE_TICKLESS_IDLE no sdkconfig.
+ */
+static void configurePowerManagement() {
+    if (!POWER_LIGHT_SLEEP) {
+        return;
     }
+
+#if defined(CONFIG_PM_ENABLE) && defined(CONFIG_FREERTOS_USE_TICKLESS_IDLE)
+    esp_pm_config_esp32_t config = {};
+    config.max_freq_mhz = 240;
+    config.min_freq_mhz = POWER_MIN_CPU_FREQ;
+    config.light_sleep_enable = true;
+
+    esp_err_t err = esp_pm_configure(&config);
+    if (err == ESP_OK) {
+        LOG_INFO(MODULE_NAME, "Light sleep automático ativo (%d-%d MHz)", POWER_MIN_CPU_FREQ, 240);
+    } else {
+        LOG_WARN(MODULE_NAME, "Falha ao configurar o gerenciamento de energia: %d", err);
+    }
+#else
+    LOG_WARN(MODULE_NAME, "Light sleep requer CONFIG_PM_ENABLE e CONFIG_FREERTOS_USE_TICKLESS_IDLE");
+#endif
 }
 
 // Função para aguardar conexão WiFi com timeout
@@ -230,6 +418,12 @@ bool waitForWiFiConnection(uint32_t timeout_ms) {
 void setup() {
     // Inicializa a comunicação serial
     Serial.begin(SERIAL_BAUD_RATE);
+
+    // Modo de campo: um ciclo curto e deep sleep, sem tarefas nem servidor web
+    if (FIELD_MODE) {
+        FieldMode::run();
+    }
+
     delay(500); // Pequeno delay para estabilização
 
     // Inicialização do sistema de logging já realizada pelo include
@@ -258,12 +452,16 @@ void setup() {
     #else
         // Máxima velocidade para hardware real
         setCpuFrequencyMhz(240);
+
+        // Frequência dinâmica e light sleep, se habilitados
+        configurePowerManagement();
     #endif
 
     // Inicializa componentes - ORDEM É IMPORTANTE
     // 1. Primeiramente os serviços de sistema
     SystemMonitor::getInstance().init();
     MemoryManager::getInstance().init();
+    CpuMonitor::getInstance();
     OutputManager::initialize();
     OutputManager::attachConsoleManager(&ConsoleManager::getInstance());
 
@@ -386,6 +584,9 @@ void setup() {
     // 6. Agora que WiFi está pronto, inicializa WebServer
     delay(200); // Pequeno delay para estabilização
 
+    // Regras configuradas em campo, carregadas antes de aceitar comandos
+    RuleStore::getInstance().begin();
+
     g_webServer = new AsyncSoilWebServer(WEB_SERVER_PORT, *g_sensorManager);
     if (g_webServer) {
         g_webServer->begin();
@@ -408,6 +609,13 @@ void setup() {
         LOG_FATAL(MODULE_NAME, "ERRO: Falha ao criar ApiClient!");
         while(true) { delay(1000); }
     }
+
+    // Tarefa de envio dedicada, alimentada por fila limitada
+    g_uplinkManager = new UplinkManager(*g_apiClient);
+    if (!g_uplinkManager || !g_uplinkManager->begin()) {
+        LOG_FATAL(MODULE_NAME, "ERRO: Falha ao criar UplinkManager!");
+        while(true) { delay(1000); }
+    }
     // =======================================================
 
     